@@ -47,6 +47,15 @@ int main()
 		Storage result2("Results/subject01_InverseDynamics.sto"), standard2("std_subject01_InverseDynamics.sto");
 		CHECK_STORAGE_AGAINST_STANDARD(result2, standard2, Array<double>(2.0, 23), __FILE__, __LINE__, "testGait failed");
 		cout << "testGait passed" << endl;
+
+		// Solving the frames concurrently gives the same generalized forces
+		InverseDynamicsTool id3("subject01_Setup_InverseDynamics.xml");
+		id3.setNumThreads(4);
+		id3.setOutputGenForceFileName("subject01_InverseDynamics_threads");
+		id3.run();
+		Storage result3("Results/subject01_InverseDynamics_threads.sto");
+		CHECK_STORAGE_AGAINST_STANDARD(result3, result2, Array<double>(1e-8, 23), __FILE__, __LINE__, "testGaitThreads failed");
+		cout << "testGaitThreads passed" << endl;
 	}
     catch (const Exception& e) {
         e.print(cerr);
@@ -63,6 +63,7 @@ int main(int argc,char **argv)
 
 	// PARSE COMMAND LINE
 	string inName;
+	Array<string> batchNames;
 	string option = "";
 	if (argc < 2) {
 		PrintUsage(argv[0], cout);
@@ -87,6 +88,9 @@ int main(int argc,char **argv)
 						return(0);
 					}
 					inName = argv[i+1];
+					// Any further setup files are scaled as a batch.
+					for(int j=i+2;j<argc && argv[j][0]!='-';j++)
+						batchNames.append(argv[j]);
 					break;
 
 				// Print a default setup file
@@ -126,36 +130,24 @@ int main(int argc,char **argv)
 
 
 	try {
+		// Several setup files share their generic models and run together
+		if(batchNames.getSize()>0) {
+			Array<ScaleTool*> subjects;
+			subjects.append(new ScaleTool(inName));
+			for(int i=0;i<batchNames.getSize();i++)
+				subjects.append(new ScaleTool(batchNames[i]));
+			int numFailed = ScaleTool::runBatch(subjects);
+			for(int i=0;i<subjects.getSize();i++) delete subjects[i];
+			return (numFailed==0) ? 0 : 1;
+		}
+
 		// Construct model and read parameters file
 		ScaleTool* subject = new ScaleTool(inName);
 		Model* model = subject->createModel();
 
 		if(!model) throw Exception("scale: ERROR- No model specified.",__FILE__,__LINE__);
 
-        // Realize the topology and initialize state
-       
-        SimTK::State& s = model->initSystem();
-
-		if (!subject->isDefaultModelScaler() && subject->getModelScaler().getApply())
-		{
-			ModelScaler& scaler = subject->getModelScaler();
-			if(!scaler.processModel(s, model, subject->getPathToSubject(), subject->getSubjectMass())) return 1;
-		}
-		else
-		{
-			cout << "Scaling parameters disabled (apply is false) or not set. Model is not scaled." << endl;
-		}
-		
-		SimTK::State& news = model->initSystem();	// old state is messed up by scaling. can't use it
-		if (!subject->isDefaultMarkerPlacer())
-		{
-			MarkerPlacer& placer = subject->getMarkerPlacer();
-			if(!placer.processModel(news, model, subject->getPathToSubject())) return 1;
-		}
-		else
-		{
-			cout << "Marker placement parameters disabled (apply is false) or not set. No markers have been moved." << endl;
-		}
+		if(!subject->processModel(model)) return 1;
 
 		delete model;
 		delete subject;
@@ -179,6 +171,7 @@ void PrintUsage(const char *aProgName, ostream &aOStream)
 	aOStream<<"-Help, -H                           Print the command-line options for "<<progName<<".\n";
 	aOStream<<"-PrintSetup, -PS                    Generates a template Setup file to customize scaling\n";
 	aOStream<<"-Setup, -S        SetupFileName     Specify an xml setup file for scaling a generic model.\n";
+	aOStream<<"                                    Several setup files may be given to scale subjects in parallel.\n";
 	aOStream<<"-PropertyInfo, -PI                  Print help information for properties in setup files.\n";
 
 }
@@ -42,6 +42,7 @@ using namespace std;
 
 void scaleGait2354();
 void scaleGait2354_GUI(bool useMarkerPlacement);
+void scaleGait2354_batch();
 
 int main()
 {
@@ -49,6 +50,7 @@ int main()
  
 		scaleGait2354();
 		scaleGait2354_GUI(false);
+		scaleGait2354_batch();
 		//scaleGait2354_GUI(true);
 
     }
@@ -184,3 +186,26 @@ void scaleGait2354_GUI(bool useMarkerPlacement)
 
 	delete subject;
 }
+
+void scaleGait2354_batch()
+{
+	// Remove old results if any
+	FILE* file2Remove = IO::OpenFile("subject01_scaleSet_applied.xml", "w");
+	fclose(file2Remove);
+
+	// Two subjects sharing one generic model; only the first writes files
+	Array<ScaleTool*> subjects;
+	subjects.append(new ScaleTool("subject01_Setup_Scale.xml"));
+	subjects.append(new ScaleTool("subject01_Setup_Scale.xml"));
+	subjects[1]->setName("subject01_copy");
+	subjects[1]->setPrintResultFiles(false);
+
+	ASSERT(ScaleTool::runBatch(subjects, 2) == 0);
+
+	std::string setupFilePath = subjects[0]->getPathToSubject();
+	ScaleSet stdScaleSet = ScaleSet(setupFilePath+"std_subject01_scaleSet_applied.xml");
+	const ScaleSet& computedScaleSet = ScaleSet(setupFilePath+"subject01_scaleSet_applied.xml");
+	ASSERT(computedScaleSet == stdScaleSet);
+
+	for (int i = 0; i < subjects.getSize(); i++) delete subjects[i];
+}
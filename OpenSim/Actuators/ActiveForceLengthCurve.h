@@ -205,6 +205,7 @@ public:
     */
     void setMinValue(double minimumValue);
 
+    using Function::calcDerivative;
 	/** Implement the generic OpenSim::Function interface **/
     double calcValue(const SimTK::Vector& x) const override
     {
@@ -213,7 +214,7 @@ public:
 
     /** Evaluates the active-force-length curve at a normalized fiber length of
     'normFiberLength'. */
-    double calcValue(double normFiberLength) const;
+    double calcValue(double normFiberLength) const override;
 
 
     /** Calculates the derivative of the active-force-length multiplier with
@@ -226,7 +227,7 @@ public:
         The derivative of the active-force-length curve with respect to the
         normalized fiber length.
     */
-    double calcDerivative(double normFiberLength, int order) const;
+    double calcDerivative(double normFiberLength, int order) const override;
 
     /** Returns a SimTK::Vec2 containing the lower (0th element) and upper (1st
     element) bounds on the domain of the curve. Outside this domain, the curve
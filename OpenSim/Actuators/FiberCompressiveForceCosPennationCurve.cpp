@@ -85,14 +85,14 @@ void FiberCompressiveForceCosPennationCurve::constructProperties()
 }
 
 
-void FiberCompressiveForceCosPennationCurve::buildCurve( bool computeIntegral )
+void FiberCompressiveForceCosPennationCurve::buildCurve()
 {
 	SmoothSegmentedFunction* f = SmoothSegmentedFunctionFactory::
 		createFiberCompressiveForceCosPennationCurve(   
 				cos(get_engagement_angle_in_degrees()*Pi/180.0), 
 				m_stiffnessAtPerpendicularInUse,
 				m_curvinessInUse,
-				computeIntegral,
+				true,
 				getName());       
 
 	m_curve = *f; 
@@ -254,13 +254,7 @@ double FiberCompressiveForceCosPennationCurve::
     SimTK_ASSERT(isObjectUpToDateWithProperties()==true,
         "FiberCompressiveCosPennationCurve: Curve is not"
         " to date with its properties");
-	
-	if (!m_curve.isIntegralAvailable()) {
-		FiberCompressiveForceCosPennationCurve* mutableThis = 
-			const_cast<FiberCompressiveForceCosPennationCurve*>(this); 
-		mutableThis->buildCurve(true); 
-	}
-    
+
 	return m_curve.calcIntegral(cosPennationAngle);
 }
 
@@ -303,9 +303,10 @@ public:
     \endverbatim
 
     */
-    double calcValue(double cosPennationAngle) const;
+    double calcValue(double cosPennationAngle) const override;
 
 
+    using Function::calcDerivative;
 	/** Implement the generic OpenSim::Function interface **/
     double calcValue(const SimTK::Vector& x) const override
     {
@@ -332,7 +333,7 @@ public:
     \endverbatim
 
     */
-    double calcDerivative(double cosPennationAngle, int order) const;
+    double calcDerivative(double cosPennationAngle, int order) const override;
 
     /**     
     @param cosPennationAngle
@@ -438,7 +439,7 @@ private:
 	  \endverbatim
 
 	 */
-	void buildCurve( bool computeIntegral = false );
+	void buildCurve();
 
 
 
@@ -74,14 +74,14 @@ void FiberCompressiveForceLengthCurve::constructProperties()
 }
 
 
-void FiberCompressiveForceLengthCurve::buildCurve( bool computeIntegral )
+void FiberCompressiveForceLengthCurve::buildCurve()
 {        
 	SmoothSegmentedFunction* f = SmoothSegmentedFunctionFactory::
 		createFiberCompressiveForceLengthCurve( 
 				get_norm_length_at_zero_force(), 
 				m_stiffnessAtZeroLengthInUse,  
 				m_curvinessInUse,
-				computeIntegral,
+				true,
 				getName());            
 	
 	m_curve = *f;  
@@ -228,12 +228,6 @@ double FiberCompressiveForceLengthCurve::calcIntegral(double aNormLength) const
     SimTK_ASSERT(isObjectUpToDateWithProperties()==true,
         "FiberCompressiveForceLengthCurve: Curve is not"
         " to date with its properties");
-	
-	if (!m_curve.isIntegralAvailable()) {
-		FiberCompressiveForceLengthCurve* mutableThis = 
-			const_cast<FiberCompressiveForceLengthCurve*>(this); 
-		mutableThis->buildCurve(true); 
-	}
 
     return m_curve.calcIntegral(aNormLength);
 }
@@ -239,9 +239,10 @@ public:
     \endverbatim
 
     */
-    double calcValue(double aNormLength) const;
+    double calcValue(double aNormLength) const override;
 
  
+    using Function::calcDerivative;
 	/** Implement the generic OpenSim::Function interface **/
     double calcValue(const SimTK::Vector& x) const override
     {
@@ -272,7 +273,7 @@ public:
     \endverbatim
 
     */
-    double calcDerivative(double aNormLength, int order) const;
+    double calcDerivative(double aNormLength, int order) const override;
 
     /**     
     @param aNormLength
@@ -382,7 +383,7 @@ private:
         \endverbatim
 
     */
-    void buildCurve( bool computeIntegral = false );
+    void buildCurve();
     
 
     SmoothSegmentedFunction   m_curve;
@@ -78,7 +78,7 @@ void FiberForceLengthCurve::constructProperties()
     constructProperty_curviness();
 }
 
-void FiberForceLengthCurve::buildCurve(bool computeIntegral)
+void FiberForceLengthCurve::buildCurve()
 {
     SmoothSegmentedFunction* f = SmoothSegmentedFunctionFactory::
         createFiberForceLengthCurve(
@@ -87,7 +87,7 @@ void FiberForceLengthCurve::buildCurve(bool computeIntegral)
             m_stiffnessAtLowForceInUse,
             m_stiffnessAtOneNormForceInUse,
             m_curvinessInUse,
-            computeIntegral,
+            true,
             getName());
 
     m_curve = *f;
@@ -235,12 +235,6 @@ double FiberForceLengthCurve::calcIntegral(double normFiberLength) const
     SimTK_ASSERT(isObjectUpToDateWithProperties(),
         "FiberForceLengthCurve: Curve is not up-to-date with its properties");
 
-    if(!m_curve.isIntegralAvailable()) {
-        FiberForceLengthCurve* mutableThis =
-            const_cast<FiberForceLengthCurve*>(this);
-        mutableThis->buildCurve(true);
-    }
-
     return m_curve.calcIntegral(normFiberLength);
 }
 
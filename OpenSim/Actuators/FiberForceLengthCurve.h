@@ -275,6 +275,7 @@ public:
                                double stiffnessAtOneNormForce,
                                double curviness);
 
+    using Function::calcDerivative;
 	/** Implement the generic OpenSim::Function interface **/
     double calcValue(const SimTK::Vector& x) const override
     {
@@ -283,7 +284,7 @@ public:
 
     /** Evaluates the fiber-force-length curve at a normalized fiber length of
     'normFiberLength'. */
-    double calcValue(double normFiberLength) const;
+    double calcValue(double normFiberLength) const override;
 
     /** Calculates the derivative of the fiber-force-length multiplier with
     respect to the normalized fiber length.
@@ -295,7 +296,7 @@ public:
         The derivative of the fiber-force-length curve with respect to the
         normalized fiber length.
     */
-    double calcDerivative(double normFiberLength, int order) const;
+    double calcDerivative(double normFiberLength, int order) const override;
 
     /** Calculates the normalized area under the curve. Since it is expensive to
     construct, the curve is built only when necessary.
@@ -364,7 +365,7 @@ private:
     // This function will take all of the current property values. If they have
     // changed since the last time the curve was built, the curve is rebuilt.
     // Curve construction costs ~20,500 flops.
-    void buildCurve(bool computeIntegral=false);
+    void buildCurve();
 
     // Calculates the properties of the passive force-length curve documented in
     // Thelen (2003). Specifically:
@@ -301,6 +301,7 @@ public:
     */
     void setEccentricCurviness(double aEccentricCurviness);
 
+    using Function::calcDerivative;
 	/** Implement the generic OpenSim::Function interface **/
     double calcValue(const SimTK::Vector& x) const override
     {
@@ -309,7 +310,7 @@ public:
 
     /** Evaluates the force-velocity curve at a normalized fiber velocity of
     'normFiberVelocity'. */
-    double calcValue(double normFiberVelocity) const;
+    double calcValue(double normFiberVelocity) const override;
 
     /** Calculates the derivative of the force-velocity multiplier with respect
     to the normalized fiber velocity.
@@ -321,7 +322,7 @@ public:
         The derivative of the force-velocity curve with respect to the
         normalized fiber velocity.
     */
-    double calcDerivative(double normFiberVelocity, int order) const;
+    double calcDerivative(double normFiberVelocity, int order) const override;
 
     /** Returns a SimTK::Vec2 containing the lower (0th element) and upper (1st
     element) bounds on the domain of the curve. Outside this domain, the curve
@@ -269,6 +269,7 @@ public:
     */
     void setEccentricCurviness(double aEccentricCurviness);
 
+    using Function::calcDerivative;
 	/** Implement the generic OpenSim::Function interface **/
     double calcValue(const SimTK::Vector& x) const override
     {
@@ -277,7 +278,7 @@ public:
 
     /** Evaluates the inverse force-velocity curve at a force-velocity
     multiplier value of 'aForceVelocityMultiplier'. */
-    double calcValue(double aForceVelocityMultiplier) const;
+    double calcValue(double aForceVelocityMultiplier) const override;
 
     /** Calculates the derivative of the inverse force-velocity curve with
     respect to the force-velocity multiplier.
@@ -289,7 +290,7 @@ public:
         The derivative of the inverse force-velocity curve with respect to the
         force-velocity multiplier.
     */
-    double calcDerivative(double aForceVelocityMultiplier, int order) const;
+    double calcDerivative(double aForceVelocityMultiplier, int order) const override;
 
     /** Returns a SimTK::Vec2 containing the lower (0th element) and upper (1st
     element) bounds on the domain of the curve. Outside this domain, the curve
@@ -28,6 +28,7 @@
 #include <OpenSim/Common/SimmSpline.h>
 
 #include "RigidTendonMuscle.h"
+#include <typeinfo>
 
 //==============================================================================
 // STATICS
@@ -120,9 +121,72 @@ void RigidTendonMuscle::constructProperties()
 	normalized lengths, pennation angle, etc... */
 void RigidTendonMuscle::
 calcMuscleLengthInfo(const State& s, MuscleLengthInfo& mli) const
+{
+	calcLengthInfo(getLength(s), mli);
+}
+
+void RigidTendonMuscle::calcMusclePotentialEnergyInfo(const SimTK::State& s,
+		MusclePotentialEnergyInfo& mpei) const
+{
+	mpei.fiberPotentialEnergy = 0;
+	mpei.tendonPotentialEnergy = 0;
+	mpei.musclePotentialEnergy = 0;
+}
+
+/* calculate muscle's velocity related values such fiber and tendon velocities,
+	normalized velocities, pennation angular velocity, etc... */
+void RigidTendonMuscle::calcFiberVelocityInfo(const State& s, FiberVelocityInfo& fvi) const
+{
+	calcVelocityInfo(getGeometryPath().getLengtheningSpeed(s), fvi);
+}
+
+/* calculate muscle's active and passive force-length, force-velocity, 
+	tendon force, relationships and their related values */
+void RigidTendonMuscle::
+calcMuscleDynamicsInfo(const State& s, MuscleDynamicsInfo& mdi) const
+{
+	calcDynamicsInfo(getControl(s), getMuscleLengthInfo(s), 
+		getFiberVelocityInfo(s), mdi);
+}
+
+/* Evaluate the length, velocity and dynamics info of a group of 
+	RigidTendonMuscles. Since the tendon is rigid, all three follow directly
+	from the path kinematics and the control, so each muscle is evaluated in
+	one pass that hands its intermediate values on directly instead of
+	reading them back from its cache. Members of subclasses may override the
+	calc*Info methods, so they are evaluated through those instead. */
+void RigidTendonMuscle::computeMuscleGroupInfo(const State& s,
+	const SimTK::Array_<const Muscle*>& group) const
+{
+	SimTK::Array_<const Muscle*> others;
+	for(unsigned int i=0; i<group.size(); ++i){
+		if(typeid(*group[i]) != typeid(RigidTendonMuscle)){
+			others.push_back(group[i]);
+			continue;
+		}
+		const RigidTendonMuscle* m = 
+			static_cast<const RigidTendonMuscle*>(group[i]);
+
+		MuscleLengthInfo& mli = m->updMuscleLengthInfo(s);
+		m->calcLengthInfo(m->getLength(s), mli);
+		m->markMuscleLengthInfoValid(s);
+
+		FiberVelocityInfo& fvi = m->updFiberVelocityInfo(s);
+		m->calcVelocityInfo(m->getGeometryPath().getLengtheningSpeed(s), fvi);
+		m->markFiberVelocityInfoValid(s);
+
+		MuscleDynamicsInfo& mdi = m->updMuscleDynamicsInfo(s);
+		m->calcDynamicsInfo(m->getControl(s), mli, fvi, mdi);
+		m->markMuscleDynamicsInfoValid(s);
+	}
+	Muscle::computeMuscleGroupInfo(s, others);
+}
+
+void RigidTendonMuscle::calcLengthInfo(double length, 
+	MuscleLengthInfo& mli) const
 {
 	mli.tendonLength = getTendonSlackLength();
-	double zeroPennateLength = getLength(s) - mli.tendonLength;
+	double zeroPennateLength = length - mli.tendonLength;
 	zeroPennateLength = zeroPennateLength < 0 ? 0 : zeroPennateLength;
 
 	mli.fiberLength = sqrt(square(zeroPennateLength) + square(_muscleWidth))
@@ -133,45 +197,30 @@ calcMuscleLengthInfo(const State& s, MuscleLengthInfo& mli) const
 	
 	mli.normFiberLength = mli.fiberLength/getOptimalFiberLength();
 
-    const Vector arg(1, mli.normFiberLength);
 	mli.fiberActiveForceLengthMultiplier = 
-        get_active_force_length_curve().calcValue(arg);
-	mli.fiberPassiveForceLengthMultiplier = 
-        SimTK::clamp(0, get_passive_force_length_curve().calcValue(arg), 10);
+        get_active_force_length_curve().calcValue(mli.normFiberLength);
+	mli.fiberPassiveForceLengthMultiplier = SimTK::clamp(0, 
+        get_passive_force_length_curve().calcValue(mli.normFiberLength), 10);
 
 	mli.normTendonLength = 1.0;
 	mli.tendonStrain = 0.0;
 }
 
-void RigidTendonMuscle::calcMusclePotentialEnergyInfo(const SimTK::State& s,
-		MusclePotentialEnergyInfo& mpei) const
-{
-	mpei.fiberPotentialEnergy = 0;
-	mpei.tendonPotentialEnergy = 0;
-	mpei.musclePotentialEnergy = 0;
-}
-
-/* calculate muscle's velocity related values such fiber and tendon velocities,
-	normalized velocities, pennation angular velocity, etc... */
-void RigidTendonMuscle::calcFiberVelocityInfo(const State& s, FiberVelocityInfo& fvi) const
+void RigidTendonMuscle::calcVelocityInfo(double lengtheningSpeed,
+	FiberVelocityInfo& fvi) const
 {
-	const MuscleLengthInfo &mli = getMuscleLengthInfo(s);
-	fvi.fiberVelocity = getGeometryPath().getLengtheningSpeed(s);
+	fvi.fiberVelocity = lengtheningSpeed;
 	fvi.normFiberVelocity = fvi.fiberVelocity / 
                             (getOptimalFiberLength()*getMaxContractionVelocity());
 	fvi.fiberForceVelocityMultiplier = 
-        get_force_velocity_curve().calcValue(Vector(1, fvi.normFiberVelocity));
+        get_force_velocity_curve().calcValue(fvi.normFiberVelocity);
 }
 
-/* calculate muscle's active and passive force-length, force-velocity, 
-	tendon force, relationships and their related values */
-void RigidTendonMuscle::
-calcMuscleDynamicsInfo(const State& s, MuscleDynamicsInfo& mdi) const
+void RigidTendonMuscle::calcDynamicsInfo(double activation,
+	const MuscleLengthInfo& mli, const FiberVelocityInfo& fvi,
+	MuscleDynamicsInfo& mdi) const
 {
-	const MuscleLengthInfo &mli = getMuscleLengthInfo(s);
-	const FiberVelocityInfo &fvi = getFiberVelocityInfo(s);
-
-	mdi.activation = getControl(s);
+	mdi.activation = activation;
 	double normActiveForce = mdi.activation 
                              * mli.fiberActiveForceLengthMultiplier 
                              * fvi.fiberForceVelocityMultiplier;
@@ -192,7 +241,6 @@ calcMuscleDynamicsInfo(const State& s, MuscleDynamicsInfo& mdi) const
                         * fvi.fiberVelocity;
 }
 
-
 //--------------------------------------------------------------------------
 // COMPUTATIONS
 //--------------------------------------------------------------------------
@@ -104,6 +104,13 @@ protected:
 	void calcMusclePotentialEnergyInfo(const SimTK::State& s,
 		MusclePotentialEnergyInfo& mpei) const;
 
+	/** evaluate a group of RigidTendonMuscles together: the length, velocity
+	    and dynamics info of each muscle are computed in one pass from its
+	    path kinematics, without the virtual calc*Info() calls and the cache
+	    lookups of the intermediate values that each of them would make */
+	void computeMuscleGroupInfo(const SimTK::State& s,
+		const SimTK::Array_<const Muscle*>& group) const override;
+
 	/** compute initial fiber length (velocity) such that muscle fiber and tendon are 
 	    in static equilibrium and update the state */
 	void computeInitialFiberEquilibrium(SimTK::State& s) const {}
@@ -120,6 +127,14 @@ private:
 	void setNull();
 	void constructProperties();
 
+	// The calculations shared by the calc*Info() methods and
+	// computeMuscleGroupInfo()
+	void calcLengthInfo(double length, MuscleLengthInfo& mli) const;
+	void calcVelocityInfo(double lengtheningSpeed, 
+		FiberVelocityInfo& fvi) const;
+	void calcDynamicsInfo(double activation, const MuscleLengthInfo& mli,
+		const FiberVelocityInfo& fvi, MuscleDynamicsInfo& mdi) const;
+
 protected:
 
 //==============================================================================
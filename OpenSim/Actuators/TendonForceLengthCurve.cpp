@@ -90,14 +90,14 @@ void TendonForceLengthCurve::constructProperties()
     constructProperty_curviness();
 }
 
-void TendonForceLengthCurve::buildCurve(bool computeIntegral)
+void TendonForceLengthCurve::buildCurve()
 {
     SmoothSegmentedFunction* f = SmoothSegmentedFunctionFactory::
         createTendonForceLengthCurve(get_strain_at_one_norm_force(),
                                      m_stiffnessAtOneNormForceInUse,
                                      m_normForceAtToeEndInUse,
                                      m_curvinessInUse,
-                                     computeIntegral,
+                                     true,
                                      getName());
     m_curve = *f;
     delete f;
@@ -240,12 +240,6 @@ double TendonForceLengthCurve::calcIntegral(double aNormLength) const
     SimTK_ASSERT(isObjectUpToDateWithProperties(),
         "TendonForceLengthCurve: Tendon is not up-to-date with its properties");
 
-    if (!m_curve.isIntegralAvailable()) {
-        TendonForceLengthCurve* mutableThis =
-            const_cast<TendonForceLengthCurve*>(this);
-        mutableThis->buildCurve(true);
-    }
-
     return m_curve.calcIntegral(aNormLength);
 }
 
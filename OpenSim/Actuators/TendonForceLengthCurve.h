@@ -259,6 +259,7 @@ public:
                                double normForceAtToeEnd,
                                double curviness);
 
+    using Function::calcDerivative;
     /** Implement the generic OpenSim::Function interface **/
     double calcValue(const SimTK::Vector& x) const override
     {
@@ -267,7 +268,7 @@ public:
 
     /** Evaluates the tendon-force-length curve at a normalized tendon length of
     'aNormLength'. */
-    double calcValue(double aNormLength) const;
+    double calcValue(double aNormLength) const override;
 
     /** Calculates the derivative of the tendon-force-length multiplier with
     respect to the normalized tendon length.
@@ -279,7 +280,7 @@ public:
         The derivative of the tendon-force-length curve with respect to the
         normalized tendon length.
     */
-    double calcDerivative(double aNormLength, int order) const;
+    double calcDerivative(double aNormLength, int order) const override;
 
     /** Calculates the normalized area under the curve. Since it is expensive to
     construct, the curve is built only when necessary.
@@ -367,7 +368,7 @@ private:
 
     // This function will take all of the current property values. If they have
     // changed since the last time the curve was built, the curve is rebuilt.
-    void buildCurve(bool computeIntegral = false);
+    void buildCurve();
 
     SmoothSegmentedFunction m_curve;
 
@@ -105,6 +105,7 @@ void testMillard2012EquilibriumMuscle();
 void testMillard2012AccelerationMuscle();
 void testSchutte1993Muscle();
 void testDelp1990Muscle();
+void testMuscleGroupEvaluation();
 
 int main()
 {
@@ -165,6 +166,13 @@ int main()
         failures.push_back("testMillard2012AccelerationMuscle");
     }
 
+    try { testMuscleGroupEvaluation();
+		cout << "Muscle group evaluation Test passed" << endl; 
+    }catch (const Exception& e){ 
+        e.print(cerr);
+        failures.push_back("testMuscleGroupEvaluation");
+    }
+
     printf("\n\n");
     cout <<"************************************************************"<<endl;
     cout <<"************************************************************"<<endl;
@@ -916,3 +924,71 @@ void testDelp1990Muscle()
         false);
 
 }
+
+
+/*==============================================================================
+    Verify that evaluating muscles in groups of the same type (with the
+    RigidTendonMuscle group specialization and the default for others) yields
+    the same muscle forces as evaluating each muscle independently.
+================================================================================
+*/
+void testMuscleGroupEvaluation()
+{
+	using SimTK::Vec3;
+
+	Model model;
+	Body& ground = model.getGroundBody();
+
+	OpenSim::Body* ball = new OpenSim::Body("ball", 10, Vec3(0),
+                        10*SimTK::Inertia::sphere(0.05));
+	double xSinG = OptimalFiberLength0 + TendonSlackLength0;
+	SliderJoint* slider = new SliderJoint("slider", ground, Vec3(xSinG, 0, 0),
+                        Vec3(0), *ball, Vec3(0), Vec3(0));
+	model.addBody(ball);
+	model.addJoint(slider);
+
+	const char* rigidNames[] = {"rigid0", "rigid1", "rigid2"};
+	for(int i=0; i<3; ++i){
+		RigidTendonMuscle* rigid = new RigidTendonMuscle(rigidNames[i],
+			MaxIsometricForce0*(i+1), OptimalFiberLength0,
+			TendonSlackLength0, PennationAngle1*i/2);
+		rigid->addNewPathPoint("origin", ground, Vec3(0, 0.01*i, 0));
+		rigid->addNewPathPoint("insertion", *ball, Vec3(0));
+		model.addForce(rigid);
+	}
+	Thelen2003Muscle* thelen = new Thelen2003Muscle("thelen", 
+		MaxIsometricForce0, OptimalFiberLength0, TendonSlackLength0,
+		PennationAngle0);
+	thelen->addNewPathPoint("origin", ground, Vec3(0));
+	thelen->addNewPathPoint("insertion", *ball, Vec3(0));
+	model.addForce(thelen);
+
+	PrescribedController* controller = new PrescribedController();
+	controller->setActuators(model.updActuators());
+	for(int i=0; i<model.getActuators().getSize(); ++i){
+		controller->prescribeControlForActuator(
+			model.getActuators()[i].getName(), new Constant(0.3 + 0.1*i));
+	}
+	model.addController(controller);
+
+	SimTK::State& s = model.initSystem();
+	const Set<Muscle>& muscles = model.getMuscles();
+	model.getCoordinateSet()[0].setValue(s, 0.02);
+	model.getCoordinateSet()[0].setSpeedValue(s, -0.1);
+	model.equilibrateMuscles(s);
+
+	model.getMultibodySystem().realize(s, SimTK::Stage::Dynamics);
+	SimTK::Vector forces(muscles.getSize());
+	for(int i=0; i<muscles.getSize(); ++i)
+		forces[i] = muscles[i].getTendonForce(s);
+
+	model.setUseMuscleGroupEvaluation(true);
+	s.invalidateAllCacheAtOrAbove(SimTK::Stage::Velocity);
+	model.getMultibodySystem().realize(s, SimTK::Stage::Dynamics);
+	for(int i=0; i<muscles.getSize(); ++i){
+		ASSERT_EQUAL(forces[i], muscles[i].getTendonForce(s), 
+			SimTK::SignificantReal, __FILE__, __LINE__, 
+			"Muscle group evaluation changed the force of " + 
+			muscles[i].getName());
+	}
+}
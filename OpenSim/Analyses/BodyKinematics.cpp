@@ -37,6 +37,26 @@
 using namespace OpenSim;
 using namespace std;
 
+//_____________________________________________________________________________
+/**
+ * Find the position, velocity and acceleration in ground of the mass center
+ * of a body, as SimbodyEngine::getPosition(), getVelocity() and
+ * getAcceleration() would, from a single lookup of the body's kinematics.
+ */
+static void findMassCenterKinematics(const SimTK::State& s,
+	const SimTK::MobilizedBody& mobod, const SimTK::Vec3& com,
+	SimTK::Vec3& rPos, SimTK::Vec3& rVel, SimTK::Vec3& rAcc)
+{
+	const SimTK::Transform& X_GB = mobod.getBodyTransform(s);
+	const SimTK::SpatialVec& V_GB = mobod.getBodyVelocity(s);
+	const SimTK::SpatialVec& A_GB = mobod.getBodyAcceleration(s);
+	const SimTK::Vec3& w = V_GB[0];
+	const SimTK::Vec3 r = X_GB.R()*com;
+	rPos = X_GB.p() + r;
+	rVel = V_GB[1] + w % r;
+	rAcc = A_GB[1] + A_GB[0] % r + w % (w % r);
+}
+
 //=============================================================================
 // CONSTANTS
 //=============================================================================
@@ -265,6 +285,12 @@ allocateStorage()
 	_pStore = new Storage(1000,"Positions");
 	_pStore->setDescription(getDescription());
 	_pStore->setColumnLabels(getColumnLabels());
+
+	_storageList.setMemoryOwner(false);
+	_storageList.setSize(0);
+	_storageList.append(_aStore);
+	_storageList.append(_vStore);
+	_storageList.append(_pStore);
 }
 
 
@@ -278,6 +304,7 @@ allocateStorage()
 void BodyKinematics::
 deleteStorage()
 {
+	_storageList.setSize(0);
 	if(_aStore!=NULL) { delete _aStore;  _aStore=NULL; }
 	if(_vStore!=NULL) { delete _vStore;  _vStore=NULL; }
 	if(_pStore!=NULL) { delete _pStore;  _pStore=NULL; }
@@ -293,6 +320,8 @@ updateBodiesToRecord()
 	if(!_model) {
 		_bodyIndices.setSize(0);
 		_kin.setSize(0);
+		_vKin.setSize(0);
+		_aKin.setSize(0);
 		return;
 	}
 
@@ -316,6 +345,8 @@ updateBodiesToRecord()
 		_bodyIndices.append(index);
 	}
 	_kin.setSize(6*_bodyIndices.getSize()+(_recordCenterOfMass?3:0));
+	_vKin.setSize(_kin.getSize());
+	_aKin.setSize(_kin.getSize());
 
 	if(_kin.getSize()==0) cout << "WARNING: BodyKinematics analysis has no bodies to record kinematics for" << endl;
 }
@@ -446,155 +477,72 @@ record(const SimTK::State& s)
 	// Realize to Acceleration first since we'll ask for Accelerations 
 	_model->getMultibodySystem().realize(s, SimTK::Stage::Acceleration);
 	// VARIABLES
-	double dirCos[3][3];
-	SimTK::Vec3 vec,angVec;
+	SimTK::Vec3 pos,vel,acc,angVec;
 	double Mass = 0.0;
 
-	// GROUND BODY
-	Body &ground = _model->getSimbodyEngine().getGroundBody();
-
-	// POSITION
+	const SimTK::SimbodyMatterSubsystem& matter = _model->getMatterSubsystem();
 	BodySet& bs = _model->updBodySet();
 
-	for(int i=0;i<_bodyIndices.getSize();i++) {
-		Body& body = bs.get(_bodyIndices[i]);
-		const SimTK::Vec3& com = body.get_mass_center();
-		// GET POSITIONS AND EULER ANGLES
-		_model->getSimbodyEngine().getPosition(s, body,com,vec);
-		_model->getSimbodyEngine().getDirectionCosines(s, body,dirCos);
-		_model->getSimbodyEngine().convertDirectionCosinesToAngles(dirCos,
-			&angVec[0],&angVec[1],&angVec[2]);
-
-		// CONVERT TO DEGREES?
-		if(getInDegrees()) {
-			angVec[0] *= SimTK_RADIAN_TO_DEGREE;
-			angVec[1] *= SimTK_RADIAN_TO_DEGREE;
-			angVec[2] *= SimTK_RADIAN_TO_DEGREE;
-		}			
-
-		// FILL KINEMATICS ARRAY
-		int I=6*i;
-		memcpy(&_kin[I],&vec[0],3*sizeof(double));
-		memcpy(&_kin[I+3],&angVec[0],3*sizeof(double));
-	}
-
-	if(_recordCenterOfMass) {
-		double rP[3] = { 0.0, 0.0, 0.0 };
-		for(int i=0;i<bs.getSize();i++) {
-			Body& body = bs.get(i);
-			const SimTK::Vec3& com = body.get_mass_center();
-			_model->getSimbodyEngine().getPosition(s, body,com,vec);
-			// ADD TO WHOLE BODY MASS
-			Mass += body.get_mass();
-			rP[0] += body.get_mass() * vec[0];
-			rP[1] += body.get_mass() * vec[1];
-			rP[2] += body.get_mass() * vec[2];
-		}
-
-		//COMPUTE COM OF WHOLE BODY AND ADD TO ARRAY
-		rP[0] /= Mass;
-		rP[1] /= Mass;
-		rP[2] /= Mass;
-		int I = 6*_bodyIndices.getSize();
-		memcpy(&_kin[I],rP,3*sizeof(double));
-	}
-	
-	_pStore->append(s.getTime(),_kin.getSize(),&_kin[0]);
+	// The positions, velocities and accelerations are filled in together,
+	// in one pass over the bodies, with each body's kinematics taken once
+	// from the matter subsystem.
+	int nk = _kin.getSize();
 
-	// VELOCITY
 	for(int i=0;i<_bodyIndices.getSize();i++) {
 		Body& body = bs.get(_bodyIndices[i]);
-		const SimTK::Vec3& com = body.get_mass_center();
-		// GET VELOCITIES AND ANGULAR VELOCITIES
-		_model->getSimbodyEngine().getVelocity(s, body,com,vec);
-		if(_expressInLocalFrame) {
-			_model->getSimbodyEngine().transform(s, ground,vec,body,vec);
-			_model->getSimbodyEngine().getAngularVelocityBodyLocal(s, body,angVec);
-		} else {
-			_model->getSimbodyEngine().getAngularVelocity(s, body,angVec);
-		}
-
-		// CONVERT TO DEGREES?
-		if(getInDegrees()) {
-			angVec[0] *= SimTK_RADIAN_TO_DEGREE;
-			angVec[1] *= SimTK_RADIAN_TO_DEGREE;
-			angVec[2] *= SimTK_RADIAN_TO_DEGREE;
-		}			
+		const SimTK::MobilizedBody& mobod = matter.getMobilizedBody(body.getIndex());
+		const SimTK::Rotation& R_GB = mobod.getBodyRotation(s);
+		findMassCenterKinematics(s, mobod, body.get_mass_center(), pos, vel, acc);
+		int I=6*i;
 
-		// FILL KINEMATICS ARRAY
-		int I = 6*i;
-		memcpy(&_kin[I],&vec[0],3*sizeof(double));
+		// POSITIONS AND EULER ANGLES
+		angVec = R_GB.convertRotationToBodyFixedXYZ();
+		if(getInDegrees()) angVec *= SimTK_RADIAN_TO_DEGREE;
+		memcpy(&_kin[I],&pos[0],3*sizeof(double));
 		memcpy(&_kin[I+3],&angVec[0],3*sizeof(double));
-	}
 
-	if(_recordCenterOfMass) {
-		double rV[3] = { 0.0, 0.0, 0.0 };
-		for(int i=0;i<bs.getSize();i++) {
-			Body& body = bs.get(i);
-			const SimTK::Vec3& com = body.get_mass_center();
-			_model->getSimbodyEngine().getVelocity(s, body,com,vec);
-			rV[0] += body.get_mass() * vec[0];
-			rV[1] += body.get_mass() * vec[1];
-			rV[2] += body.get_mass() * vec[2];
-		}
-
-		//COMPUTE VELOCITY OF COM OF WHOLE BODY AND ADD TO ARRAY
-		rV[0] /= Mass;
-		rV[1] /= Mass;
-		rV[2] /= Mass;
-		int I = 6*_bodyIndices.getSize();
-		memcpy(&_kin[I],rV,3*sizeof(double));
-	}
-
-	_vStore->append(s.getTime(),_kin.getSize(),&_kin[0]);
-
-	// ACCELERATIONS
-	for(int i=0;i<_bodyIndices.getSize();i++) {
-		Body& body = bs.get(_bodyIndices[i]);
-		const SimTK::Vec3& com = body.get_mass_center();
-
-		// GET ACCELERATIONS AND ANGULAR ACCELERATIONS
-		_model->getSimbodyEngine().getAcceleration(s, body,com,vec);
-		if(_expressInLocalFrame) {
-			_model->getSimbodyEngine().transform(s, ground,vec,body,vec);
-			_model->getSimbodyEngine().getAngularAccelerationBodyLocal(s, body,angVec);
-		} else {
-			_model->getSimbodyEngine().getAngularAcceleration(s, body,angVec);
-		}
-
-		// CONVERT TO DEGREES?
-		if(getInDegrees()) {
-			angVec[0] *= SimTK_RADIAN_TO_DEGREE;
-			angVec[1] *= SimTK_RADIAN_TO_DEGREE;
-			angVec[2] *= SimTK_RADIAN_TO_DEGREE;
-		}			
-
-		// FILL KINEMATICS ARRAY
-		int I = 6*i;
-		memcpy(&_kin[I],&vec[0],3*sizeof(double));
-		memcpy(&_kin[I+3],&angVec[0],3*sizeof(double));
+		// VELOCITIES AND ANGULAR VELOCITIES
+		// Note that the angular velocity and acceleration are expressed in
+		// ground even when the local frame is requested, as they have been.
+		angVec = mobod.getBodyAngularVelocity(s);
+		if(_expressInLocalFrame) vel = ~R_GB*vel;
+		if(getInDegrees()) angVec *= SimTK_RADIAN_TO_DEGREE;
+		memcpy(&_vKin[I],&vel[0],3*sizeof(double));
+		memcpy(&_vKin[I+3],&angVec[0],3*sizeof(double));
+
+		// ACCELERATIONS AND ANGULAR ACCELERATIONS
+		angVec = mobod.getBodyAngularAcceleration(s);
+		if(_expressInLocalFrame) acc = ~R_GB*acc;
+		if(getInDegrees()) angVec *= SimTK_RADIAN_TO_DEGREE;
+		memcpy(&_aKin[I],&acc[0],3*sizeof(double));
+		memcpy(&_aKin[I+3],&angVec[0],3*sizeof(double));
 	}
 
+	// WHOLE BODY CENTER OF MASS
 	if(_recordCenterOfMass) {
-		double rA[3] = { 0.0, 0.0, 0.0 };
+		SimTK::Vec3 rP(0.0),rV(0.0),rA(0.0);
 		for(int i=0;i<bs.getSize();i++) {
 			Body& body = bs.get(i);
-			const SimTK::Vec3& com = body.get_mass_center();
-			_model->getSimbodyEngine().getAcceleration(s, body,com,vec);
-			rA[0] += body.get_mass() * vec[0];
-			rA[1] += body.get_mass() * vec[1];
-			rA[2] += body.get_mass() * vec[2];
+			double mass = body.get_mass();
+			findMassCenterKinematics(s, matter.getMobilizedBody(body.getIndex()),
+				body.get_mass_center(), pos, vel, acc);
+			Mass += mass;
+			rP += mass*pos;
+			rV += mass*vel;
+			rA += mass*acc;
 		}
-
-		//COMPUTE ACCELERATION OF COM OF WHOLE BODY AND ADD TO ARRAY
-		rA[0] /= Mass;
-		rA[1] /= Mass;
-		rA[2] /= Mass;
+		rP /= Mass;
+		rV /= Mass;
+		rA /= Mass;
 		int I = 6*_bodyIndices.getSize();
-		memcpy(&_kin[I],rA,3*sizeof(double));
+		memcpy(&_kin[I],&rP[0],3*sizeof(double));
+		memcpy(&_vKin[I],&rV[0],3*sizeof(double));
+		memcpy(&_aKin[I],&rA[0],3*sizeof(double));
 	}
 
-	_aStore->append(s.getTime(),_kin.getSize(),&_kin[0]);
+	_pStore->append(s.getTime(),nk,&_kin[0]);
+	_vStore->append(s.getTime(),nk,&_vKin[0]);
+	_aStore->append(s.getTime(),nk,&_aKin[0]);
 
 	//printf("BodyKinematics:\taT:\t%.16f\trA[1]:\t%.16f\n",s.getTime(),rA[1]);
 	return(0);
@@ -65,6 +65,9 @@ protected:
 	Array<int> _bodyIndices;
 	bool _recordCenterOfMass;
 	Array<double> _kin;
+	// Velocities and accelerations of the row being recorded.
+	Array<double> _vKin;
+	Array<double> _aKin;
 
 	Storage *_pStore;
 	Storage *_vStore;
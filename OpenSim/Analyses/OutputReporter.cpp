@@ -0,0 +1,365 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  OutputReporter.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2014 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+
+//=============================================================================
+// INCLUDES and STATICS
+//=============================================================================
+#include <OpenSim/Simulation/Model/Model.h>
+#include "OutputReporter.h"
+
+using namespace OpenSim;
+using namespace std;
+
+//=============================================================================
+// CONSTRUCTOR(S) AND DESTRUCTOR
+//=============================================================================
+//_____________________________________________________________________________
+/**
+ * Destructor.
+ */
+OutputReporter::~OutputReporter()
+{
+}
+//_____________________________________________________________________________
+/**
+ * Construct an OutputReporter for recording Outputs of a model's components
+ * during a simulation.
+ *
+ * @param aModel Model whose component Outputs are to be recorded.
+ */
+OutputReporter::OutputReporter(Model *aModel) :
+	Analysis(aModel)
+{
+	// NULL
+	setNull();
+
+	// DESCRIPTION
+	constructDescription();
+}
+//_____________________________________________________________________________
+/**
+ * Construct an object from file.
+ *
+ * The object is constructed from the root element of the XML document.
+ * The type of object is the tag name of the XML root element.
+ *
+ * @param aFileName File name of the document.
+ */
+OutputReporter::OutputReporter(const std::string &aFileName):
+	Analysis(aFileName, false)
+{
+	setNull();
+
+	// Serialize from XML
+	updateFromXMLDocument();
+
+	// DESCRIPTION
+	constructDescription();
+}
+
+//=============================================================================
+// CONSTRUCTION METHODS
+//=============================================================================
+//_____________________________________________________________________________
+/**
+ * Set all member variables to their null or default values.
+ */
+void OutputReporter::
+setNull()
+{
+	constructProperties();
+
+	setName("OutputReporter");
+	_realizeStage = SimTK::Stage::Model;
+	_numRows = 0;
+}
+//_____________________________________________________________________________
+/**
+ * Construct the properties and their default values.
+ */
+void OutputReporter::
+constructProperties()
+{
+	constructProperty_output_paths();
+	constructProperty_initial_capacity(1000);
+}
+//_____________________________________________________________________________
+/**
+ * Construct the description for the OutputReporter files.
+ */
+void OutputReporter::
+constructDescription()
+{
+	string descrip = "\nThis file contains the values of component Outputs ";
+	descrip += "recorded during a simulation.\n";
+	descrip += "\nUnits are those of the components providing the Outputs.\n\n";
+	setDescription(descrip);
+}
+
+//=============================================================================
+// TABLE
+//=============================================================================
+//_____________________________________________________________________________
+/**
+ * Look up the Outputs named in 'output_paths', determine their value types
+ * and sizes, and lay out the columns of the table. Outputs that cannot be
+ * found or whose type is not supported are skipped with a warning.
+ */
+void OutputReporter::
+resolveOutputs(SimTK::State& s)
+{
+	_outputs.setSize(0);
+	_kinds.setSize(0);
+	_firstColumns.setSize(0);
+	_columnLabels.setSize(0);
+	_columnLabels.append("time");
+	_realizeStage = SimTK::Stage::Model;
+
+	int ncol = 1;
+	for(int i=0; i<getProperty_output_paths().size(); ++i) {
+		const string& path = get_output_paths(i);
+		const AbstractOutput* output = NULL;
+		try {
+			output = &_model->getOutput(path);
+		} catch(const Exception&) {
+			cout<<"OutputReporter: WARN- no output '"<<path<<"' in model "
+				<<_model->getName()<<". It will not be recorded."<<endl;
+			continue;
+		}
+
+		SimTK::Stage stage = output->getDependsOnStage();
+		if(stage > SimTK::Stage::Report) stage = SimTK::Stage::Report;
+		int kind = -1, nvalues = 0;
+		if(dynamic_cast<const Output<double>*>(output)) {
+			kind = ScalarOutput;
+			nvalues = 1;
+			_columnLabels.append(path);
+		} else if(dynamic_cast<const Output<SimTK::Vec3>*>(output)) {
+			kind = Vec3Output;
+			nvalues = 3;
+			_columnLabels.append(path+"_x");
+			_columnLabels.append(path+"_y");
+			_columnLabels.append(path+"_z");
+		} else if(dynamic_cast<const Output<SimTK::Vector>*>(output)) {
+			// The size of a Vector output is fixed by its first value.
+			kind = VectorOutput;
+			_model->getMultibodySystem().realize(s, stage);
+			nvalues = Output<SimTK::Vector>::downcast(*output).getValue(s).size();
+			for(int j=0; j<nvalues; ++j) {
+				char label[16];
+				sprintf(label, "_%d", j);
+				_columnLabels.append(path+label);
+			}
+		} else {
+			cout<<"OutputReporter: WARN- output '"<<path<<"' has unsupported "
+				<<"type "<<output->getTypeName()<<". It will not be recorded."
+				<<endl;
+			continue;
+		}
+
+		_outputs.append(output);
+		_kinds.append(kind);
+		_firstColumns.append(ncol);
+		ncol += nvalues;
+		if(stage > _realizeStage) _realizeStage = stage;
+	}
+	_firstColumns.append(ncol);
+}
+//_____________________________________________________________________________
+/**
+ * Make sure the table has room for at least aNumRows rows, doubling its
+ * size when it has to grow. Recorded rows are kept.
+ */
+void OutputReporter::
+ensureCapacity(int aNumRows)
+{
+	int ncol = _columnLabels.getSize();
+	if(aNumRows<=_table.nrow() && ncol==_table.ncol()) return;
+
+	int nrow = _table.nrow()>0 ? _table.nrow() : get_initial_capacity();
+	if(nrow<1) nrow = 1;
+	while(nrow<aNumRows) nrow *= 2;
+	_table.resizeKeep(nrow, ncol);
+}
+//_____________________________________________________________________________
+/**
+ * Create a Storage holding the recorded rows.
+ */
+Storage* OutputReporter::
+createStorage() const
+{
+	Storage* store = new Storage(_numRows>0 ? _numRows : 1, getName());
+	store->setDescription(getDescription());
+	store->setInDegrees(false);
+	store->setColumnLabels(_columnLabels);
+
+	int ny = _table.ncol()-1;
+	Array<double> y(0.0, ny);
+	for(int r=0; r<_numRows; ++r) {
+		for(int c=0; c<ny; ++c) y[c] = _table(r,c+1);
+		store->append(_table(r,0), y, false);
+	}
+	return store;
+}
+
+//=============================================================================
+// ANALYSIS
+//=============================================================================
+//_____________________________________________________________________________
+/**
+ * Record the values of the Outputs in the next row of the table.
+ */
+int OutputReporter::
+record(const SimTK::State& s)
+{
+	if(_model==NULL) return -1;
+
+	// Outputs are cached in the state, so this costs at most one evaluation
+	// of each Output even if other components already consumed it.
+	_model->getMultibodySystem().realize(s, _realizeStage);
+
+	// As in Storage, a row at the same time as the last one replaces it.
+	int r = _numRows;
+	if(r>0 && _table(r-1,0)==s.getTime()) --r;
+	ensureCapacity(r+1);
+	_table(r,0) = s.getTime();
+
+	for(int i=0; i<_outputs.getSize(); ++i) {
+		const AbstractOutput& output = *_outputs[i];
+		int c = _firstColumns[i];
+		switch(_kinds[i]) {
+		case ScalarOutput:
+			_table(r,c) = Output<double>::downcast(output).getValue(s);
+			break;
+		case Vec3Output: {
+			const SimTK::Vec3& v = Output<SimTK::Vec3>::downcast(output).getValue(s);
+			for(int j=0; j<3; ++j) _table(r,c+j) = v[j];
+			break; }
+		case VectorOutput: {
+			const SimTK::Vector& v =
+				Output<SimTK::Vector>::downcast(output).getValue(s);
+			int n = _firstColumns[i+1]-c;
+			if(v.size()<n) n = v.size();
+			for(int j=0; j<n; ++j) _table(r,c+j) = v[j];
+			for(int j=n; j<_firstColumns[i+1]-c; ++j) _table(r,c+j) = SimTK::NaN;
+			break; }
+		}
+	}
+	_numRows = r+1;
+
+	return 0;
+}
+//_____________________________________________________________________________
+/**
+ * This method is called at the beginning of an analysis so that any
+ * necessary initializations may be performed.
+ *
+ * @param s System state
+ *
+ * @return -1 on error, 0 otherwise.
+ */
+int OutputReporter::
+begin(SimTK::State& s)
+{
+	if(!proceed()) return 0;
+	if(_model==NULL) return -1;
+
+	// COLUMNS AND TABLE
+	resolveOutputs(s);
+	_numRows = 0;
+	_table.resize(0, 0);
+	ensureCapacity(get_initial_capacity());
+
+	// RECORD
+	return record(s);
+}
+//_____________________________________________________________________________
+/**
+ * This method is called to perform the analysis.
+ *
+ * @param s System state
+ * @param stepNumber Integration step number.
+ *
+ * @return -1 on error, 0 otherwise.
+ */
+int OutputReporter::
+step(const SimTK::State& s, int stepNumber)
+{
+	if(!proceed(stepNumber)) return 0;
+
+	record(s);
+
+	return 0;
+}
+//_____________________________________________________________________________
+/**
+ * This method is called at the end of an analysis so that any
+ * necessary finalizations may be performed.
+ *
+ * @param s System state
+ *
+ * @return -1 on error, 0 otherwise.
+ */
+int OutputReporter::
+end(SimTK::State& s)
+{
+	if(!proceed()) return 0;
+
+	record(s);
+
+	return 0;
+}
+
+//=============================================================================
+// IO
+//=============================================================================
+//_____________________________________________________________________________
+/**
+ * Print results.
+ *
+ * The file name is constructed as
+ * aDir + "/" + aBaseName + "_" + getName() + aExtension
+ *
+ * @param aDir Directory in which the results reside.
+ * @param aBaseName Base file name.
+ * @param aDT Desired time interval between adjacent storage vectors.  Linear
+ * interpolation is used to print the data out at the desired interval.
+ * @param aExtension File extension.
+ *
+ * @return 0 on success, -1 on error.
+ */
+int OutputReporter::
+printResults(const string &aBaseName,const string &aDir,double aDT,
+				 const string &aExtension)
+{
+	if(!getOn()) {
+		printf("OutputReporter.printResults: Off- not printing.\n");
+		return 0;
+	}
+
+	Storage* store = createStorage();
+	Storage::printResult(store, aBaseName+"_"+getName(), aDir, aDT, aExtension);
+	delete store;
+
+	return 0;
+}
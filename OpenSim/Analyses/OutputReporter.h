@@ -0,0 +1,147 @@
+#ifndef OPENSIM_OUTPUT_REPORTER_H_
+#define OPENSIM_OUTPUT_REPORTER_H_
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  OutputReporter.h                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2014 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+//=============================================================================
+// INCLUDES
+//=============================================================================
+#include <OpenSim/Common/Storage.h>
+#include <OpenSim/Simulation/Model/Analysis.h>
+#include "osimAnalysesDLL.h"
+
+#ifdef SWIG
+	#ifdef OSIMANALYSES_API
+		#undef OSIMANALYSES_API
+		#define OSIMANALYSES_API
+	#endif
+#endif
+//=============================================================================
+//=============================================================================
+namespace OpenSim {
+
+class AbstractOutput;
+
+/**
+ * A class for recording a chosen list of component Outputs during a
+ * simulation. Each entry of 'output_paths' names an Output by the path of its
+ * component within the model and the Output's name, for example
+ * "r_bic/fiber_force" or "my_probe/probe_outputs". Outputs of type double,
+ * SimTK::Vec3 and SimTK::Vector are supported; a Vec3 contributes three
+ * columns and a Vector one column per element (its size is taken at begin()).
+ *
+ * Values are written into a preallocated table with one contiguous column per
+ * value, which grows by doubling when full, so recording a step costs one
+ * realize() and one cached Output evaluation per entry. A Storage is built
+ * from the table only when the results are printed or requested.
+ */
+class OSIMANALYSES_API OutputReporter : public Analysis {
+OpenSim_DECLARE_CONCRETE_OBJECT(OutputReporter, Analysis);
+public:
+//=============================================================================
+// PROPERTIES
+//=============================================================================
+	OpenSim_DECLARE_LIST_PROPERTY(output_paths, std::string,
+		"Outputs to record, each given as <component path>/<output name>.");
+	OpenSim_DECLARE_PROPERTY(initial_capacity, int,
+		"Number of rows preallocated for the recorded values.");
+
+//=============================================================================
+// METHODS
+//=============================================================================
+	OutputReporter(Model *aModel=0);
+	OutputReporter(const std::string &aFileName);
+	virtual ~OutputReporter();
+
+private:
+	void setNull();
+	void constructProperties();
+	void constructDescription();
+	void resolveOutputs(SimTK::State& s);
+	void ensureCapacity(int aNumRows);
+
+public:
+	//--------------------------------------------------------------------------
+	// GET AND SET
+	//--------------------------------------------------------------------------
+	/** Add an Output to be recorded, given as <component path>/<output name>. */
+	void addOutputPath(const std::string& aPath)
+	{	append_output_paths(aPath); }
+
+	/** Number of rows recorded since the last begin(). */
+	int getNumRows() const { return _numRows; }
+	/** Labels of the recorded columns, starting with "time". */
+	const Array<std::string>& getColumnLabels() const { return _columnLabels; }
+	/** Recorded values. Column 0 holds the time; only the first getNumRows()
+	    rows are valid. */
+	const SimTK::Matrix& getTable() const { return _table; }
+	/** Create a Storage holding the recorded rows. The caller owns it. */
+	Storage* createStorage() const;
+
+	//--------------------------------------------------------------------------
+	// ANALYSIS
+	//--------------------------------------------------------------------------
+	virtual int
+		begin(SimTK::State& s );
+	virtual int
+		step(const SimTK::State& s, int setNumber );
+	virtual int
+		end(SimTK::State& s );
+protected:
+	virtual int
+		record(const SimTK::State& s );
+	//--------------------------------------------------------------------------
+	// IO
+	//--------------------------------------------------------------------------
+public:
+	virtual int
+		printResults(const std::string &aBaseName,const std::string &aDir="",
+		double aDT=-1.0,const std::string &aExtension=".sto");
+
+//=============================================================================
+// DATA
+//=============================================================================
+private:
+	// Value type of a recorded Output.
+	enum OutputKind { ScalarOutput, Vec3Output, VectorOutput };
+
+	// Resolved Outputs, their kinds and first columns in the table. The last
+	// entry of _firstColumns is the total number of columns.
+	Array<const AbstractOutput*> _outputs;
+	Array<int> _kinds;
+	Array<int> _firstColumns;
+	// Highest stage any of the recorded Outputs depends on.
+	SimTK::Stage _realizeStage;
+
+	Array<std::string> _columnLabels;
+	SimTK::Matrix _table;
+	int _numRows;
+
+//=============================================================================
+};	// END of class OutputReporter
+
+}; //namespace
+//=============================================================================
+//=============================================================================
+
+
+#endif // #ifndef OPENSIM_OUTPUT_REPORTER_H_
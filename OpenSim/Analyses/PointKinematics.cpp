@@ -277,6 +277,12 @@ allocateStorage()
 	_pStore = new Storage(1000,"PointPosition");
 	_pStore->setDescription(getDescription());
 	_pStore->setColumnLabels(getColumnLabels());
+
+	_storageList.setMemoryOwner(false);
+	_storageList.setSize(0);
+	_storageList.append(_aStore);
+	_storageList.append(_vStore);
+	_storageList.append(_pStore);
 }
 
 
@@ -290,6 +296,7 @@ allocateStorage()
 void PointKinematics::
 deleteStorage()
 {
+	_storageList.setSize(0);
 	if(_aStore!=NULL) { delete _aStore;  _aStore=NULL; }
 	if(_vStore!=NULL) { delete _vStore;  _vStore=NULL; }
 	if(_pStore!=NULL) { delete _pStore;  _pStore=NULL; }
@@ -523,33 +530,42 @@ int PointKinematics::
 record(const SimTK::State& s)
 {
 	const SimbodyEngine& de = _model->getSimbodyEngine();
+	const SimTK::SimbodyMatterSubsystem& matter = _model->getMatterSubsystem();
 
 	// VARIABLES
 	SimTK::Vec3 vec;
 
 	const double& time = s.getTime();
 
+	// Look up the mobilized bodies once for all three quantities. A point
+	// relative to ground is left as is, as SimbodyEngine::transform() does.
+	const SimTK::MobilizedBody& mobod = matter.getMobilizedBody(_body->getIndex());
+	const SimTK::MobilizedBody& ground = matter.getGround();
+	const SimTK::MobilizedBody* relativeTo = NULL;
+	if(_relativeToBody && _relativeToBody!=&de.getGroundBody())
+		relativeTo = &matter.getMobilizedBody(_relativeToBody->getIndex());
+
 	// POSITION
-	de.getPosition(s, *_body,_point,vec);
-	if(_relativeToBody){
-		de.transformPosition(s, de.getGroundBody(), vec, *_relativeToBody, vec);
+	vec = mobod.findStationLocationInGround(s, _point);
+	if(relativeTo){
+		vec = ground.findStationLocationInAnotherBody(s, vec, *relativeTo);
 	}
 
 	_pStore->append(time, vec);
 
 	// VELOCITY
-	de.getVelocity(s, *_body,_point,vec);
-	if(_relativeToBody){
-		de.transform(s, de.getGroundBody(), vec, *_relativeToBody, vec);
+	vec = mobod.findStationVelocityInGround(s, _point);
+	if(relativeTo){
+		vec = ground.expressVectorInAnotherBodyFrame(s, vec, *relativeTo);
 	}
 
 	_vStore->append(time, vec);
 
 	// ACCELERATIONS
 	_model->getMultibodySystem().realize(s, SimTK::Stage::Acceleration);
-	de.getAcceleration(s, *_body,_point,vec);
-	if(_relativeToBody){
-		de.transform(s, de.getGroundBody(), vec, *_relativeToBody, vec);
+	vec = mobod.findStationAccelerationInGround(s, _point);
+	if(relativeTo){
+		vec = ground.expressVectorInAnotherBodyFrame(s, vec, *relativeTo);
 	}
 
 	_aStore->append(time, vec);
@@ -54,6 +54,7 @@ OSIMANALYSES_API void RegisterTypes_osimAnalyses()
 	Object::registerType( StatesReporter() );
 	Object::registerType( InducedAccelerations() );
 	Object::RegisterType( ProbeReporter() );
+	Object::registerType( OutputReporter() );
 
   } catch (const std::exception& e) {
     std::cerr 
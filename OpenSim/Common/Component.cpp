@@ -386,6 +386,10 @@ getModelingOption(const SimTK::State& s, const std::string& name) const
         return SimTK::Value<int>::downcast(
             getDefaultSubsystem().getDiscreteVariable(s, dvIndex)).get();
     } else {
+        const Component* owner = findOwnerOfPath(name);
+        if (owner)
+            return owner->getModelingOption(s, name.substr(name.rfind("/")+1));
+
         std::stringstream msg;
         msg << "Component::getModelingOption: ERR- name '" << name 
             << "' not found.\n " 
@@ -415,6 +419,12 @@ setModelingOption(SimTK::State& s, const std::string& name, int flag) const
         SimTK::Value<int>::downcast(
             getDefaultSubsystem().updDiscreteVariable(s, dvIndex)).upd() = flag;
     } else {
+        const Component* owner = findOwnerOfPath(name);
+        if (owner) {
+            owner->setModelingOption(s, name.substr(name.rfind("/")+1), flag);
+            return;
+        }
+
         std::stringstream msg;
         msg << "Component::setModelingOption: modeling option " << name 
             << " not found.\n ";
@@ -457,6 +467,62 @@ Component& Component::updComponent(const std::string& name) const
 }
 
 
+// Find the subcomponent that owns a variable given by a path of the form
+// "subcomponent/.../variable", as returned by getDiscreteVariableNames().
+// Returns NULL if the name is not a path or names no other component.
+const Component* Component::findOwnerOfPath(const std::string& name) const
+{
+	std::string::size_type back = name.rfind("/");
+	if (back == std::string::npos)
+		return NULL;
+
+	const Component* found = findComponent(name.substr(0, back));
+	return (found != this) ? found : NULL;
+}
+
+// Collect the names of a Component's variables from one of its tables,
+// followed by those of its subcomponents prefixed by the subcomponent name.
+template <class Info>
+static void appendNames(const std::map<std::string, Info>& table,
+	Array<std::string>& names)
+{
+	typename std::map<std::string, Info>::const_iterator it;
+	for (it = table.begin(); it != table.end(); ++it)
+		names.append(it->first);
+}
+
+static void appendSubcomponentNames(const std::string& subCompName,
+	const Array<std::string>& subnames, Array<std::string>& names)
+{
+	std::string::size_type front = subCompName.find_first_not_of(" \t\r\n");
+	std::string::size_type back = subCompName.find_last_not_of(" \t\r\n");
+	std::string prefix = "";
+	if(back > front) // have non-whitespace name
+		prefix = subCompName+"/";
+	for(int j=0; j<subnames.getSize(); ++j)
+		names.append(prefix+subnames[j]);
+}
+
+Array<std::string> Component::getDiscreteVariableNames() const
+{
+	Array<std::string> names;
+	appendNames(_namedDiscreteVariableInfo, names);
+	for(unsigned int i=0; i<_components.size(); i++)
+		appendSubcomponentNames(_components[i]->getName(),
+			_components[i]->getDiscreteVariableNames(), names);
+	return names;
+}
+
+Array<std::string> Component::getModelingOptionNames() const
+{
+	Array<std::string> names;
+	appendNames(_namedModelingOptionInfo, names);
+	for(unsigned int i=0; i<_components.size(); i++)
+		appendSubcomponentNames(_components[i]->getName(),
+			_components[i]->getModelingOptionNames(), names);
+	return names;
+}
+
 const Component* Component::findComponent(const std::string& name,
 	const StateVariable** rsv) const
 {
@@ -577,19 +643,9 @@ Array<std::string> Component::getStateVariableNames() const
 {
     Array<std::string> names = getStateVariablesNamesAddedByComponent();
     // Include the states of its subcomponents
-    for(unsigned int i=0; i<_components.size(); i++){
-		Array<std::string> subnames = _components[i]->getStateVariableNames();
-		int nsubs = subnames.getSize();
-		const std::string& subCompName =  _components[i]->getName();
-		std::string::size_type front = subCompName.find_first_not_of(" \t\r\n");
-		std::string::size_type back = subCompName.find_last_not_of(" \t\r\n");
-		std::string prefix = "";
-		if(back > front) // have non-whitespace name
-			prefix = subCompName+"/";
-		for(int j =0; j<nsubs; ++j){
-			names.append(prefix+subnames[j]);
-		}
-	}
+    for(unsigned int i=0; i<_components.size(); i++)
+		appendSubcomponentNames(_components[i]->getName(),
+			_components[i]->getStateVariableNames(), names);
 
     return names;
 }
@@ -727,6 +783,10 @@ getDiscreteVariable(const SimTK::State& s, const std::string& name) const
         return SimTK::Value<double>::downcast(
             getDefaultSubsystem().getDiscreteVariable(s, dvIndex)).get();
     } else {
+        const Component* owner = findOwnerOfPath(name);
+        if (owner)
+            return owner->getDiscreteVariable(s, name.substr(name.rfind("/")+1));
+
         std::stringstream msg;
         msg << "Component::getDiscreteVariable: ERR- name '" << name 
             << "' not found.\n " 
@@ -749,6 +809,12 @@ setDiscreteVariable(SimTK::State& s, const std::string& name, double value) cons
         SimTK::Value<double>::downcast(
             getDefaultSubsystem().updDiscreteVariable(s, dvIndex)).upd() = value;
     } else {
+        const Component* owner = findOwnerOfPath(name);
+        if (owner) {
+            owner->setDiscreteVariable(s, name.substr(name.rfind("/")+1), value);
+            return;
+        }
+
         std::stringstream msg;
         msg << "Component::setDiscreteVariable: ERR- name '" << name 
             << "' not found.\n " 
@@ -767,6 +833,14 @@ void Component::addOutput(const std::string& name,
 	                const SimTK::Stage& dependsOn)
 */
 
+// Record this component and its subcomponents with the given profiler.
+void Component::setComponentProfiler(ComponentProfiler* profiler)
+{
+	_profiler = profiler;
+	for(unsigned int i=0; i<_components.size(); i++)
+		_components[i]->setComponentProfiler(profiler);
+}
+
 // Include another Component as a subcomponent of this one. If already a
 // subcomponent, it is not added to the list again.
 void Component::addComponent(Component *aComponent)
@@ -945,6 +1019,14 @@ void Component::realizeTopology(SimTK::State& s) const
                (s, ci.dependsOnStage, ci.prototype->clone());
         }
     }
+
+    // Allocate a cache entry for each Output's value
+    std::map<std::string, std::unique_ptr<const AbstractOutput> >::iterator
+        oit;
+    for (oit = mutableThis->_outputsTable.begin(); 
+         oit != _outputsTable.end(); ++oit){
+        const_cast<AbstractOutput&>(*oit->second).allocateCacheEntry(subSys, s);
+    }
 }
 
 
@@ -960,7 +1042,11 @@ void Component::realizeAcceleration(const SimTK::State& s) const
         const SimTK::Subsystem& subSys = getDefaultSubsystem();
 
 		// evaluate and set component state derivative values (in cache) 
-        computeStateVariableDerivatives(s);
+		{
+			ComponentProfiler::Scope profile(getComponentProfiler(), *this,
+				"computeStateVariableDerivatives");
+			computeStateVariableDerivatives(s);
+		}
     
         std::map<std::string, StateVariableInfo>::const_iterator it;
 
@@ -46,6 +46,7 @@
 #include "OpenSim/Common/Object.h"
 #include "OpenSim/Common/ComponentConnector.h"
 #include "OpenSim/Common/ComponentOutput.h"
+#include "OpenSim/Common/ComponentProfiler.h"
 #include "Simbody.h"
 #include <functional>
 #include <memory>
@@ -223,6 +224,19 @@ public:
 		{ return *_system; } 
 
 	/**
+	 * Set the profiler that records the calls and time spent by this 
+	 * Component and its subcomponents in instrumented sections of the 
+	 * computation, or NULL to stop recording. The profiler is not owned by
+	 * the Component and is not copied with it.
+	 * @see ComponentProfiler
+	 */
+	void setComponentProfiler(ComponentProfiler* profiler);
+
+	/** Get the profiler of this Component, or NULL if it is not profiled. */
+	ComponentProfiler* getComponentProfiler() const
+		{ return _profiler.get(); }
+
+	/**
      * Get an iterator through the underlying components that this component 
 	 * is composed of.
      */
@@ -254,6 +268,20 @@ public:
      */
     Array<std::string> getStateVariableNames() const;
 
+    /**
+     * Get the names of the discrete variables of this Component and of its
+     * subcomponents. Names of subcomponent variables are prefixed by the
+     * subcomponent name, as in getStateVariableNames(), and can be passed to
+     * getDiscreteVariable() and setDiscreteVariable() on this Component.
+     */
+    Array<std::string> getDiscreteVariableNames() const;
+
+    /**
+     * Get the names of the modeling options of this Component and of its
+     * subcomponents, prefixed in the same way as getDiscreteVariableNames().
+     */
+    Array<std::string> getModelingOptionNames() const;
+
 
    /** @name Component State Access methods
      * Get and set modeling option, state, discrete and/or cache variables in the State
@@ -1061,7 +1089,7 @@ template <class T> friend class ComponentMeasure;
        If these are not true for your case, then use the more general method
        %Component::constructOutput(const std::string&,
                                   const std::function<T(const SimTK:State&)>,
-                                  const SimTK::Stage&).
+                                  const SimTK::Stage&, bool).
       
        Here's an example. Say your Component has a method calcForce:
         @code
@@ -1073,14 +1101,15 @@ template <class T> friend class ComponentMeasure;
     template <typename T, typename Class>
     void constructOutput(const std::string& name,
             T(Class::*const componentMemberFunction)(const SimTK::State&) const,
-            const SimTK::Stage& dependsOn = SimTK::Stage::Acceleration) {
+            const SimTK::Stage& dependsOn = SimTK::Stage::Acceleration,
+            bool isCacheable = true) {
         // The `const` in `Class::*const componentMemberFunction` means this
         // function can't assign componentMemberFunction to some other function
         // pointer. This is unlikely, since that function would have to match
         // the same template parameters (T and Class).
         constructOutput<T>(name, std::bind(componentMemberFunction,
                     static_cast<Class*>(this),
-                    std::placeholders::_1), dependsOn);
+                    std::placeholders::_1), dependsOn, isCacheable);
     }
 #endif
 
@@ -1100,13 +1129,18 @@ template <class T> friend class ComponentMeasure;
                std::placeholders::_1, "ankle"),
                SimTK::Stage::Position);
        @endcode
+      The value of the Output is cached in the State until dependsOn is
+      invalidated. Pass isCacheable false for an Output whose value can also
+      change without that, e.g. one that depends on state variables but can
+      be evaluated at Position; it is then evaluated on every call.
 	*/
 	template <typename T>
 	void constructOutput(const std::string& name, 
 		const std::function<T(const SimTK::State&)> outputFunction, 
-		const SimTK::Stage& dependsOn = SimTK::Stage::Acceleration) {
+		const SimTK::Stage& dependsOn = SimTK::Stage::Acceleration,
+		bool isCacheable = true) {
         _outputsTable[name] = std::unique_ptr<const AbstractOutput>(new
-                Output<T>(name, outputFunction, dependsOn));
+                Output<T>(name, outputFunction, dependsOn, isCacheable));
 	}
     
 	/**
@@ -1319,6 +1353,9 @@ private:
     // managed by this Component.
     int getNumStateVariablesAddedByComponent() const 
     {   return (int)_namedStateVariableInfo.size(); }
+    // Find the subcomponent owning the variable named by a path of the form
+    // "subcomponent/variable", or NULL if there is none.
+    const Component* findOwnerOfPath(const std::string& name) const;
     Array<std::string> getStateVariablesNamesAddedByComponent() const;
 
     const SimTK::DefaultSystemSubsystem& getDefaultSubsystem() const
@@ -1430,6 +1467,9 @@ private:
 	// Reference pointer to the system that this component belongs to.
 	SimTK::ReferencePtr<SimTK::MultibodySystem> _system;
 
+	// Profiler recording this component's instrumented sections, if any.
+	SimTK::ReferencePtr<ComponentProfiler> _profiler;
+
 	// propertiesTable maintained by Object
 
 	// Table of Component's structural Connectors indexed by name.
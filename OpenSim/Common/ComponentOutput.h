@@ -60,19 +60,38 @@ namespace OpenSim {
  * the overhead is a single redirect to the corresponding member function
  * for the value.
  *
+ * Once the owning Component has been added to a System, an Output that
+ * depends on a stage from Time through Report also holds a lazy cache entry
+ * in the State. The value is computed on the first call to getValue() and is
+ * reused by subsequent callers until a change to the State invalidates the
+ * Output's dependsOnStage, so several consumers of the same Output per step
+ * only pay for one evaluation. The dependsOnStage of such an Output must
+ * therefore bound everything its value depends on: a value that changes with
+ * a state variable z, for example, must depend on Dynamics, since that is the
+ * stage Simbody invalidates when z changes. An Output whose value can change
+ * without its stage being invalidated is constructed with isCacheable false
+ * instead and is evaluated on every call. Outputs of the Model and Instance
+ * stages (e.g. those of state variables) are not cached.
+ *
  * @author  Ajay Seth
  */
 class OSIMCOMMON_API AbstractOutput {
 public:
-	AbstractOutput() : numSigFigs(8), dependsOnStage(SimTK::Stage::Infinity) {}
-	AbstractOutput(const std::string& name, SimTK::Stage dependsOnStage) : 
-		name(name), dependsOnStage(dependsOnStage), numSigFigs(8) {}
+	AbstractOutput() : numSigFigs(8), dependsOnStage(SimTK::Stage::Infinity),
+		cacheable(true) {}
+	AbstractOutput(const std::string& name, SimTK::Stage dependsOnStage,
+		bool isCacheable = true) : 
+		name(name), dependsOnStage(dependsOnStage), numSigFigs(8),
+		cacheable(isCacheable) {}
 	virtual ~AbstractOutput() { }
 
 	/** Output's name */
 	const std::string& getName() const { return name; }
 	/** Output's dependence on System being realized to at least this System::Stage */
 	const SimTK::Stage& getDependsOnStage() const { return dependsOnStage; }
+	/** Whether the Output's value may be cached in the State until its
+	    dependsOnStage is invalidated */
+	bool isCacheable() const { return cacheable; }
 
 	/** Output Interface */
 	virtual std::string     getTypeName() const = 0;
@@ -85,6 +104,13 @@ public:
 
 	virtual AbstractOutput* clone() const = 0;
 
+	/** Allocate the cache entry that holds this Output's value in the State.
+	    Called by the owning Component from realizeTopology(). Outputs that
+	    are not cacheable, or that depend on a stage before Time or beyond
+	    Report, are not cached. */
+	virtual void allocateCacheEntry(const SimTK::Subsystem& subsystem,
+									SimTK::State& state) = 0;
+
 	/** Specification for number of significant figures in string value. */
 	unsigned int getNumberOfSignificantDigits() const { return numSigFigs; }
 	void		 setNumberOfSignificantDigits(unsigned int numSigFigs) 
@@ -94,6 +120,7 @@ private:
 	unsigned int numSigFigs;
 	SimTK::Stage dependsOnStage;
 	std::string name;
+	bool cacheable;
 //=============================================================================
 };	// END class AbstractOutput
 
@@ -107,11 +134,15 @@ public:
 	valid at a given realization Stage.
     @param name             The name of the output.
 	@param outputFunction	The output function to be invoked (returns Output T)
-	@param dependsOnStage	Stage at which Output can be evaluated. */
+	@param dependsOnStage	Stage at which Output can be evaluated.
+	@param isCacheable		Whether the value may be cached in the State until
+							dependsOnStage is invalidated. */
 	explicit Output(const std::string& name,
 		const std::function<T(const SimTK::State&)> outputFunction,
-		const SimTK::Stage&		dependsOnStage) : 
-			AbstractOutput(name, dependsOnStage), _outputFcn(outputFunction)
+		const SimTK::Stage&		dependsOnStage,
+		bool					isCacheable = true) : 
+			AbstractOutput(name, dependsOnStage, isCacheable),
+			_outputFcn(outputFunction)
 	{}
 	
 	virtual ~Output() {}
@@ -131,13 +162,22 @@ public:
 	    to a stage at our beyond the dependsOnStage, otherwise expect an
 		Exception. */
 	const T& getValue(const SimTK::State& state) const {
-		_result = SimTK::NaN;
         if (state.getSystemStage() < getDependsOnStage())
         {
             throw SimTK::Exception::StageTooLow(__FILE__, __LINE__,
                     state.getSystemStage(), getDependsOnStage(),
                     "Output::getValue(state)");
         }
+		if (_cacheIndex.isValid()) {
+			if (_subsystem->isCacheValueRealized(state, _cacheIndex))
+				return SimTK::Value<T>::downcast(
+					_subsystem->getCacheEntry(state, _cacheIndex)).get();
+			T& value = SimTK::Value<T>::updDowncast(
+				_subsystem->updCacheEntry(state, _cacheIndex)).upd();
+			value = _outputFcn(state);
+			_subsystem->markCacheValueRealized(state, _cacheIndex);
+			return value;
+		}
 		_result = _outputFcn(state); 
 		return _result;
 	}
@@ -157,10 +197,26 @@ public:
 	AbstractOutput* clone() const override { return new Output(*this); }
 	SimTK_DOWNCAST(Output, AbstractOutput);
 
+	void allocateCacheEntry(const SimTK::Subsystem& subsystem,
+							SimTK::State& state) override {
+		_cacheIndex.invalidate();
+		_subsystem.clear();
+		if (!isCacheable() ||
+			getDependsOnStage() < SimTK::Stage::Time ||
+			getDependsOnStage() > SimTK::Stage::Report) return;
+		_subsystem = &subsystem;
+		_cacheIndex = subsystem.allocateLazyCacheEntry(state,
+			getDependsOnStage(), new SimTK::Value<T>());
+	}
+
 private:
 	mutable T _result;
 	std::function<T(const SimTK::State&)> _outputFcn;
 
+	// Cache entry holding the value in the State; invalid until allocated.
+	SimTK::ReferencePtr<const SimTK::Subsystem> _subsystem;
+	SimTK::CacheEntryIndex _cacheIndex;
+
 //=============================================================================
 };	// END class Output
 
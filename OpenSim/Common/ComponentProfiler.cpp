@@ -0,0 +1,231 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  ComponentProfiler.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2014 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ComponentProfiler.h"
+#include "Component.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+using namespace OpenSim;
+using namespace std;
+
+namespace {
+    // Order entries by decreasing total time.
+    bool longerTotal(const ComponentProfiler::Entry& a,
+                     const ComponentProfiler::Entry& b)
+    {   return a.total > b.total; }
+
+    // Escape a string for a JSON string literal.
+    string escapeJSON(const string& aStr)
+    {
+        string out;
+        for(size_t i=0; i<aStr.size(); ++i) {
+            char c = aStr[i];
+            if(c=='"' || c=='\\') { out += '\\'; out += c; }
+            else if((unsigned char)c<0x20) out += ' ';
+            else out += c;
+        }
+        return out;
+    }
+}
+
+//=============================================================================
+// CONSTRUCTOR(S)
+//=============================================================================
+ComponentProfiler::ComponentProfiler() :
+    _maxTraceEvents(100000),
+    _origin(now())
+{
+}
+
+ComponentProfiler::ComponentProfiler(const ComponentProfiler& source)
+{
+    *this = source;
+}
+
+ComponentProfiler& ComponentProfiler::operator=(const ComponentProfiler& source)
+{
+    if(this == &source) return *this;
+
+    std::lock_guard<std::mutex> lock(source._mutex);
+    _entries = source._entries;
+    _entryIndex = source._entryIndex;
+    _events = source._events;
+    _maxTraceEvents = source._maxTraceEvents;
+    _threads = source._threads;
+    _origin = source._origin;
+    return *this;
+}
+
+//=============================================================================
+// RECORDING
+//=============================================================================
+double ComponentProfiler::now()
+{
+    return chrono::duration<double>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void ComponentProfiler::record(const Component& component, const char* section,
+                               double start, double end)
+{
+    double duration = end - start;
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    pair<const Component*, string> key(&component, section);
+    map<pair<const Component*, string>, int>::iterator it =
+        _entryIndex.find(key);
+    int e;
+    if(it == _entryIndex.end()) {
+        Entry entry;
+        entry.component = component.getName();
+        entry.type = component.getConcreteClassName();
+        entry.section = section;
+        entry.count = 0;
+        entry.total = 0;
+        entry.max = 0;
+        e = (int)_entries.size();
+        _entries.push_back(entry);
+        _entryIndex[key] = e;
+    } else {
+        e = it->second;
+    }
+
+    Entry& entry = _entries[e];
+    ++entry.count;
+    entry.total += duration;
+    if(duration > entry.max) entry.max = duration;
+
+    if((int)_events.size() < _maxTraceEvents) {
+        thread::id id = this_thread::get_id();
+        map<thread::id, int>::iterator t = _threads.find(id);
+        int tid;
+        if(t == _threads.end()) {
+            tid = (int)_threads.size();
+            _threads[id] = tid;
+        } else {
+            tid = t->second;
+        }
+        Event event;
+        event.entry = e;
+        event.thread = tid;
+        event.start = start - _origin;
+        event.duration = duration;
+        _events.push_back(event);
+    }
+}
+
+void ComponentProfiler::clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.clear();
+    _entryIndex.clear();
+    _events.clear();
+    _threads.clear();
+    _origin = now();
+}
+
+void ComponentProfiler::setMaxTraceEvents(int maxEvents)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _maxTraceEvents = maxEvents < 0 ? 0 : maxEvents;
+}
+
+//=============================================================================
+// RESULTS
+//=============================================================================
+int ComponentProfiler::getNumEntries() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return (int)_entries.size();
+}
+
+std::vector<ComponentProfiler::Entry> ComponentProfiler::getEntries() const
+{
+    vector<Entry> entries;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        entries = _entries;
+    }
+    stable_sort(entries.begin(), entries.end(), longerTotal);
+    return entries;
+}
+
+void ComponentProfiler::printTable(std::ostream& out) const
+{
+    vector<Entry> entries = getEntries();
+
+    // Format each line in its own stream so that the caller's stream
+    // settings are left alone. Names longer than their column widen it.
+    ostringstream line;
+    line << left << setw(32) << "component" << " " << setw(32) << "type"
+         << " " << setw(32) << "section" << right << " " << setw(10)
+         << "calls" << " " << setw(12) << "total(s)" << " " << setw(12)
+         << "mean(us)" << " " << setw(12) << "max(us)";
+    out << line.str() << endl;
+    for(size_t i=0; i<entries.size(); ++i) {
+        const Entry& e = entries[i];
+        line.str("");
+        line << left << setw(32) << e.component << " " << setw(32) << e.type
+             << " " << setw(32) << e.section << right << " " << setw(10)
+             << e.count << fixed << setprecision(6) << " " << setw(12)
+             << e.total << setprecision(3) << " " << setw(12)
+             << (e.count>0 ? 1.0e6*e.total/e.count : 0.0) << " "
+             << setw(12) << 1.0e6*e.max;
+        out << line.str() << endl;
+    }
+}
+
+bool ComponentProfiler::printChromeTrace(const std::string& fileName) const
+{
+    ofstream out(fileName.c_str());
+    if(!out.good()) {
+        cout << "ComponentProfiler.printChromeTrace: ERROR- unable to open "
+             << fileName << endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // Complete ("X") events with times in microseconds.
+    ostringstream times;
+    times << fixed << setprecision(3);
+    out << "{\"traceEvents\": [" << endl;
+    for(size_t i=0; i<_events.size(); ++i) {
+        const Event& ev = _events[i];
+        const Entry& e = _entries[ev.entry];
+        out << "{\"name\": \"" << escapeJSON(e.component) << "\", \"cat\": \""
+            << escapeJSON(e.section) << "\", \"ph\": \"X\", ";
+        times.str("");
+        times << "\"ts\": " << 1.0e6*ev.start << ", \"dur\": "
+              << 1.0e6*ev.duration << ", \"pid\": 1, \"tid\": " << ev.thread;
+        out << times.str() << ", \"args\": {\"type\": \"" << escapeJSON(e.type)
+            << "\"}}" << (i+1<_events.size() ? "," : "") << endl;
+    }
+    out << "]," << endl;
+    out << "\"displayTimeUnit\": \"ms\"}" << endl;
+
+    return out.good();
+}
@@ -0,0 +1,150 @@
+#ifndef OPENSIM_COMPONENT_PROFILER_H_
+#define OPENSIM_COMPONENT_PROFILER_H_
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  ComponentProfiler.h                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2014 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimCommonDLL.h"
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace OpenSim {
+
+class Component;
+
+//=============================================================================
+//=============================================================================
+/**
+ * Records the number of calls and the wall time spent by individual
+ * Components in instrumented sections of the computation, such as
+ * computeStateVariableDerivatives() or a Force's computeForce().
+ *
+ * A Component reports to the profiler given to it with
+ * Component::setComponentProfiler(); a Model manages its own profiler through
+ * Model::setUseProfiling(). Sections are instrumented with a Scope, which does
+ * nothing but test a pointer when the Component has no profiler:
+ *
+ * @code
+ * ComponentProfiler::Scope profile(getComponentProfiler(), *this, "computePath");
+ * @endcode
+ *
+ * Besides the totals per Component and section, the profiler keeps up to
+ * getMaxTraceEvents() individual calls, which can be written as a Chrome
+ * trace (chrome://tracing) to see how the time is spent over a simulation.
+ * Recording is thread safe.
+ */
+class OSIMCOMMON_API ComponentProfiler {
+public:
+    /** Totals of one Component in one section. */
+    struct Entry {
+        std::string component;  // name of the Component
+        std::string type;       // concrete class name of the Component
+        std::string section;    // name of the instrumented section
+        long long   count;      // number of calls
+        double      total;      // total wall time in seconds
+        double      max;        // longest call in seconds
+    };
+
+    /** Times the enclosing block and records it with the profiler, if any. */
+    class Scope {
+    public:
+        Scope(ComponentProfiler* profiler, const Component& component,
+              const char* section) :
+            _profiler(profiler), _component(component), _section(section),
+            _start(0)
+        {   if(_profiler) _start = now(); }
+        ~Scope()
+        {   if(_profiler) _profiler->record(_component, _section, _start, now()); }
+    private:
+        Scope(const Scope&);
+        Scope& operator=(const Scope&);
+
+        ComponentProfiler* _profiler;
+        const Component& _component;
+        const char* _section;
+        double _start;
+    };
+
+    ComponentProfiler();
+    ComponentProfiler(const ComponentProfiler& source);
+    ComponentProfiler& operator=(const ComponentProfiler& source);
+
+    /** Wall clock time in seconds used for the measurements. */
+    static double now();
+
+    /** Record a call of a Component in a section that began and ended at the
+        given times, as returned by now(). */
+    void record(const Component& component, const char* section,
+                double start, double end);
+
+    /** Discard all recorded calls. Trace times are relative to the last
+        clear(). */
+    void clear();
+
+    /** Maximum number of individual calls kept for the trace; further calls
+        are only added to the totals. The default is 100000. */
+    void setMaxTraceEvents(int maxEvents);
+    int getMaxTraceEvents() const { return _maxTraceEvents; }
+
+    /** Number of (Component, section) entries recorded so far. */
+    int getNumEntries() const;
+    /** Totals of the entries, in decreasing order of total time. */
+    std::vector<Entry> getEntries() const;
+
+    /** Print the totals as a table, in decreasing order of total time. */
+    void printTable(std::ostream& out) const;
+    /** Write the recorded calls in the Chrome trace event format.
+        @return false if the file could not be written. */
+    bool printChromeTrace(const std::string& fileName) const;
+
+//=============================================================================
+// DATA
+//=============================================================================
+private:
+    // One recorded call, for the trace.
+    struct Event {
+        int entry;
+        int thread;
+        double start;
+        double duration;
+    };
+
+    std::vector<Entry> _entries;
+    std::map<std::pair<const Component*, std::string>, int> _entryIndex;
+    std::vector<Event> _events;
+    int _maxTraceEvents;
+    std::map<std::thread::id, int> _threads;
+    double _origin;
+
+    mutable std::mutex _mutex;
+
+//=============================================================================
+};  // END of class ComponentProfiler
+//=============================================================================
+//=============================================================================
+
+} // end of namespace OpenSim
+
+#endif // OPENSIM_COMPONENT_PROFILER_H_
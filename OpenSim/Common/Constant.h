@@ -90,6 +90,15 @@ public:
 	{
 		return _value;
 	}
+    virtual double calcValue(double xUnused) const
+	{
+		return _value;
+	}
+    using Function::calcDerivative;
+    virtual double calcDerivative(double xUnused, int order) const
+	{
+		return order == 0 ? _value : 0.0;
+	}
 	const double getValue() const { return _value; }
     SimTK::Function* createSimTKFunction() const;
 //=============================================================================
@@ -119,6 +119,24 @@ public:
      * @param x                the Vector of input arguments.  Its size must equal the value returned by getArgumentSize().
      */
     virtual double calcDerivative(const std::vector<int>& derivComponents, const SimTK::Vector& x) const;
+    /**
+     * Calculate the value of a function of one variable at a particular point,
+     * without packing the argument into a Vector. Functions of one variable
+     * implement this directly; by default it calls calcValue(const SimTK::Vector&).
+     *
+     * @param x   the value of the single input argument.
+     */
+    virtual double calcValue(double x) const;
+    /**
+     * Calculate a derivative of a function of one variable at a particular 
+     * point, without packing the argument into a Vector. Functions of one
+     * variable implement this directly; by default it calls
+     * calcDerivative(const std::vector<int>&, const SimTK::Vector&).
+     *
+     * @param x      the value of the single input argument.
+     * @param order  the order of the derivative; 0 gives the value.
+     */
+    virtual double calcDerivative(double x, int order) const;
     /**
      * Get the number of components expected in the input vector.
      */
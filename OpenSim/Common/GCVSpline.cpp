@@ -35,6 +35,8 @@
 #include "PropertyDblArray.h"
 #include "gcvspl.h"
 #include "XYFunctionInterface.h"
+#include <map>
+#include <mutex>
 
 
 
@@ -48,6 +50,111 @@ using SimTK::Vec;
 //=============================================================================
 // STATICS
 //=============================================================================
+namespace {
+	// A fit is identified by the degree and error variance of the spline and
+	// a hash of its data; the data itself is kept to rule out collisions.
+	struct FitKey {
+		int degree;
+		double errorVariance;
+		int size;
+		unsigned long long hash;
+		bool operator<(const FitKey& other) const {
+			if(degree!=other.degree) return degree<other.degree;
+			if(errorVariance!=other.errorVariance)
+				return errorVariance<other.errorVariance;
+			if(size!=other.size) return size<other.size;
+			return hash<other.hash;
+		}
+	};
+	struct CachedFit {
+		Vector x;
+		Vector y;
+		Vector coefficients;
+	};
+
+	// Fitted coefficients shared by all splines in the process. Fitting is
+	// by far the most expensive part of using a GCVSpline, and the same data
+	// are fit over and over: every copy of a spline refits, and tools run
+	// one after another fit the same kinematics. When the cache holds more
+	// than maxCachedValues numbers it is emptied.
+	const int maxCachedValues = 1<<22;
+	std::mutex fitCacheMutex;
+	std::map<FitKey,CachedFit> fitCache;
+	int numCachedValues = 0;
+	bool useFitCache = true;
+
+	// FNV-1a hash of the bytes of the data.
+	unsigned long long hashData(const Vector& x, const Vector& y)
+	{
+		unsigned long long hash = 14695981039346656037ULL;
+		const Vector* data[2] = { &x, &y };
+		for(int d=0;d<2;d++) {
+			for(int i=0;i<data[d]->size();i++) {
+				double value = (*data[d])[i];
+				const unsigned char* bytes = (const unsigned char*)&value;
+				for(size_t b=0;b<sizeof(double);b++) {
+					hash ^= bytes[b];
+					hash *= 1099511628211ULL;
+				}
+			}
+		}
+		return hash;
+	}
+	bool isEqual(const Vector& a, const Vector& b)
+	{
+		if(a.size()!=b.size()) return false;
+		for(int i=0;i<a.size();i++)
+			if(a[i]!=b[i]) return false;
+		return true;
+	}
+}
+
+//_____________________________________________________________________________
+/**
+ * Set whether fits are cached and reused for splines with the same degree,
+ * error variance and data.  The cache is on by default.
+ */
+void GCVSpline::
+setUseFitCache(bool aTrueFalse)
+{
+	std::lock_guard<std::mutex> lock(fitCacheMutex);
+	useFitCache = aTrueFalse;
+	if(!useFitCache) {
+		fitCache.clear();
+		numCachedValues = 0;
+	}
+}
+//_____________________________________________________________________________
+/**
+ * Get whether fits are cached.
+ */
+bool GCVSpline::
+getUseFitCache()
+{
+	std::lock_guard<std::mutex> lock(fitCacheMutex);
+	return useFitCache;
+}
+//_____________________________________________________________________________
+/**
+ * Get the number of fits held in the cache.
+ */
+int GCVSpline::
+getNumCachedFits()
+{
+	std::lock_guard<std::mutex> lock(fitCacheMutex);
+	return (int)fitCache.size();
+}
+//_____________________________________________________________________________
+/**
+ * Discard all cached fits.
+ */
+void GCVSpline::
+clearFitCache()
+{
+	std::lock_guard<std::mutex> lock(fitCacheMutex);
+	fitCache.clear();
+	numCachedValues = 0;
+}
 
 
 //=============================================================================
@@ -667,6 +774,37 @@ addPoint(double aX, double aY)
 	return i;
 }
 
+//=============================================================================
+// EVALUATION
+//=============================================================================
+// The fitted SimTK::Spline evaluates scalar arguments directly.
+double GCVSpline::calcValue(double x) const
+{
+    if (_function == NULL)
+        _function = createSimTKFunction();
+    return static_cast<const SimTK::Spline*>(_function)->calcValue(x);
+}
+
+double GCVSpline::calcDerivative(double x, int order) const
+{
+    if (_function == NULL)
+        _function = createSimTKFunction();
+    if (order == 0)
+        return static_cast<const SimTK::Spline*>(_function)->calcValue(x);
+    return static_cast<const SimTK::Spline*>(_function)->calcDerivative(order, x);
+}
+
+//_____________________________________________________________________________
+/**
+ * Fit the spline to its data now rather than on its first evaluation.
+ * The fitting of different splines may be done on separate threads.
+ */
+void GCVSpline::
+fit() const
+{
+	if(_function==NULL) _function = createSimTKFunction();
+}
+
 SimTK::Function* GCVSpline::createSimTKFunction() const {
     int degree = _halfOrder*2-1;
     Vector x(_x.getSize());
@@ -675,6 +813,24 @@ SimTK::Function* GCVSpline::createSimTKFunction() const {
         x[i] = _x[i];
     for (int i = 0; i < y.size(); ++i)
         y[i] = _y[i];
+
+    // Reuse the coefficients of an earlier fit of the same data.
+    FitKey key = { degree, _errorVariance, x.size(), 0 };
+    bool cache = getUseFitCache();
+    if (cache) {
+        key.hash = hashData(x, y);
+        std::lock_guard<std::mutex> lock(fitCacheMutex);
+        std::map<FitKey,CachedFit>::const_iterator it = fitCache.find(key);
+        if (it != fitCache.end() && isEqual(it->second.x, x) &&
+            isEqual(it->second.y, y)) {
+            const Vector& coefficients = it->second.coefficients;
+            int sz = _coefficients.getSize();
+            for (int i = 0; i < sz && i < coefficients.size(); ++i)
+                _coefficients[i] = coefficients[i];
+            return new SimTK::Spline(degree, x, coefficients);
+        }
+    }
+
     SimTK::Spline* spline;
     if (_errorVariance < 0.0)
         spline = new SimTK::Spline(SimTK::SplineFitter<double>::fitFromGCV(degree, x, y).getSpline());
@@ -684,6 +840,23 @@ SimTK::Function* GCVSpline::createSimTKFunction() const {
 	 int sz = _coefficients.getSize();
     for (int i = 0; i < sz; ++i)
         _coefficients[i] = spline->getControlPointValues()[i];
+
+    if (cache) {
+        CachedFit entry;
+        entry.x = x;
+        entry.y = y;
+        entry.coefficients = spline->getControlPointValues();
+        std::lock_guard<std::mutex> lock(fitCacheMutex);
+        if (numCachedValues + 3*x.size() > maxCachedValues) {
+            fitCache.clear();
+            numCachedValues = 0;
+        }
+        std::map<FitKey,CachedFit>::iterator it = fitCache.find(key);
+        if (it != fitCache.end())
+            numCachedValues -= 3*it->second.x.size();
+        fitCache[key] = entry;
+        numCachedValues += 3*x.size();
+    }
 	return spline;
 }
 
@@ -167,10 +167,23 @@ public:
 	virtual bool deletePoints(const Array<int>& indices);
 	virtual int addPoint(double aX, double aY);
 	SimTK::Function* createSimTKFunction() const;
+	void fit() const;
+
+	//--------------------------------------------------------------------------
+	// FIT CACHE
+	//--------------------------------------------------------------------------
+	static void setUseFitCache(bool aTrueFalse);
+	static bool getUseFitCache();
+	static int getNumCachedFits();
+	static void clearFitCache();
 
 	//--------------------------------------------------------------------------
 	// EVALUATION
 	//--------------------------------------------------------------------------
+	using Function::calcValue;
+	using Function::calcDerivative;
+	virtual double calcValue(double x) const;
+	virtual double calcDerivative(double x, int order) const;
 
 //=============================================================================
 };	// END class GCVSpline
@@ -28,6 +28,8 @@
 
 // INCLUDES
 #include "GCVSplineSet.h"
+#include <exception>
+#include <vector>
 
 
 //=============================================================================
@@ -37,6 +39,37 @@
 
 
 using namespace OpenSim;
+
+//_____________________________________________________________________________
+/*
+ * Task that fits one spline of a set per index.  An error fitting a spline
+ * is kept, so that it can be rethrown on the calling thread.
+ */
+class FitSplinesTask : public SimTK::ParallelExecutor::Task {
+public:
+	FitSplinesTask(const GCVSplineSet& splines) :
+		_splines(splines), _errors(splines.getSize()) {}
+
+	void execute(int index) {
+		const GCVSpline *spline = _splines.getGCVSpline(index);
+		if(spline==NULL || spline->getSize()<spline->getOrder()) return;
+		try {
+			spline->fit();
+		} catch(...) {
+			_errors[index] = std::current_exception();
+		}
+	}
+
+	// Rethrow the error of the first spline that could not be fit.
+	void rethrowError() const {
+		for(size_t i=0;i<_errors.size();i++)
+			if(_errors[i]) std::rethrow_exception(_errors[i]);
+	}
+private:
+	const GCVSplineSet& _splines;
+	std::vector<std::exception_ptr> _errors;
+};
+
 /**
  * Destructor.
  */
@@ -118,7 +151,9 @@ setNull()
 //_____________________________________________________________________________
 /**
  * Construct a set of generalized cross-validated splines based on the states
- * stored in an Storage object.
+ * stored in an Storage object.  The splines are fit right away, in parallel,
+ * and fits of data that were fit before are taken from the cache of
+ * GCVSpline.
  *
  * @param aDegree Degree of the constructed splines (1, 3, 5, or 7).
  * @param aStore Storage object.
@@ -168,8 +203,6 @@ construct(int aDegree,const Storage *aStore,double aErrorVariance)
 		// CONSTRUCT SPLINE
 		//printf("%s\t",name);
 		spline = new GCVSpline(aDegree,nData,times,data,name,aErrorVariance);
-		SimTK::Function* fp = spline->createSimTKFunction();
-		delete fp;  
 
 		// ADD SPLINE
 		adoptAndAppend(spline);
@@ -179,6 +212,20 @@ construct(int aDegree,const Storage *aStore,double aErrorVariance)
 	// CLEANUP
 	if(times!=NULL) delete[] times;
 	if(data!=NULL) delete[] data;
+
+	// FIT THE SPLINES
+	// The columns are independent, so they are fit on separate threads.
+	int nSplines = getSize();
+	int nThreads = SimTK::ParallelExecutor::getNumProcessors();
+	if(nThreads>nSplines) nThreads = nSplines;
+	FitSplinesTask task(*this);
+	if(nThreads>1) {
+		SimTK::ParallelExecutor executor(nThreads);
+		executor.execute(task,nSplines);
+	} else {
+		for(int i=0;i<nSplines;i++) task.execute(i);
+	}
+	task.rethrowError();
 }
 
 
@@ -30,7 +30,10 @@
 #include "osimCommonDLL.h"
 #include <time.h>
 #include <math.h>
+#include <cmath>
+#include <stdio.h>
 #include <string>
+#include <cstring>
 #include <climits>
 
 #include "IO.h"
@@ -39,6 +42,9 @@
 	#include <sys/types.h>
 #elif defined(_MSC_VER)
 	#include <direct.h>
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
 #else
 	#include <unistd.h>
 #endif
@@ -270,6 +276,97 @@ GetDoubleOutputFormat()
 	return(_DoubleFormat);
 }
 
+//_____________________________________________________________________________
+/**
+ * Get a copy of the current number output format.
+ *
+ * @see FormatDouble()
+ */
+IO::OutputFormat IO::
+GetOutputFormat()
+{
+	OutputFormat format;
+	format.scientific = _Scientific;
+	format.gFormat = _GFormatForDoubleOutput;
+	format.pad = _Pad;
+	format.precision = _Precision;
+	strcpy(format.doubleFormat,_DoubleFormat);
+	return(format);
+}
+//_____________________________________________________________________________
+/**
+ * Write a double to a character buffer exactly as sprintf() would with the
+ * current output format (see GetDoubleOutputFormat()).
+ *
+ * @param aValue Value to format.
+ * @param rBuffer Buffer to which to write the formatted value.
+ * @param aSize Size of rBuffer, including room for the terminating null.
+ * @return Number of characters written, not counting the terminating null.
+ */
+int IO::
+FormatDouble(double aValue,char *rBuffer,int aSize)
+{
+	return(FormatDouble(aValue,rBuffer,aSize,GetOutputFormat()));
+}
+//_____________________________________________________________________________
+/**
+ * Write a double to a character buffer exactly as sprintf() would with the
+ * output format aFormat.
+ *
+ * The fixed-point format, which is the default, is formatted directly
+ * from the rounded, scaled integer value, which is several times faster than
+ * sprintf().  Values whose rounding is within a hair of a tie, that are too
+ * large to scale exactly, or that are not finite, as well as the other
+ * formats, are passed on to snprintf().  This method is safe to call from
+ * several threads at once.
+ *
+ * @param aValue Value to format.
+ * @param rBuffer Buffer to which to write the formatted value.
+ * @param aSize Size of rBuffer, including room for the terminating null.
+ * @param aFormat Output format, as returned by GetOutputFormat().
+ * @return Number of characters written, not counting the terminating null.
+ */
+int IO::
+FormatDouble(double aValue,char *rBuffer,int aSize,const OutputFormat &aFormat)
+{
+	static const double Scales[] = { 1e0,1e1,1e2,1e3,1e4,1e5,1e6,1e7,1e8,
+		1e9,1e10,1e11,1e12,1e13,1e14,1e15 };
+	const int precision = aFormat.precision;
+	const char *doubleFormat = aFormat.doubleFormat;
+	if(aFormat.gFormat || aFormat.scientific ||
+		precision<0 || precision>15 || aSize<32)
+		return(snprintf(rBuffer,aSize,doubleFormat,aValue));
+
+	// SCALE AND ROUND
+	// x+err is exactly aValue*scale, so it is rounded here as sprintf()
+	// rounds the exact decimal expansion of aValue.
+	double scale = Scales[precision];
+	double x = aValue*scale;
+	if(!(fabs(x)<4.0e15)) return(snprintf(rBuffer,aSize,doubleFormat,aValue));
+	double err = std::fma(aValue,scale,-x);
+	double r = floor(x);
+	double frac = (x-r) + err;
+	if(fabs(frac-0.5)<1.0e-6) return(snprintf(rBuffer,aSize,doubleFormat,aValue));
+	if(frac>0.5) r += 1.0;
+	unsigned long long n = (unsigned long long)fabs(r);
+
+	// DIGITS, BACKWARDS
+	char digits[40];
+	int nd = 0;
+	for(int i=0;i<precision;i++,n/=10) digits[nd++] = (char)('0'+n%10);
+	if(precision>0) digits[nd++] = '.';
+	do { digits[nd++] = (char)('0'+n%10); n/=10; } while(n>0);
+	if(std::signbit(aValue)) digits[nd++] = '-';
+
+	// PAD AND COPY
+	int width = (aFormat.pad<0) ? 0 : aFormat.pad+precision;
+	if(width>=aSize) return(snprintf(rBuffer,aSize,doubleFormat,aValue));
+	int len = 0;
+	while(len<width-nd) rBuffer[len++] = ' ';
+	while(nd>0) rBuffer[len++] = digits[--nd];
+	rBuffer[len] = '\0';
+	return(len);
+}
 //_____________________________________________________________________________
 /**
  * Construct a valid output format for numbers of type double.
@@ -512,6 +609,24 @@ getCwd()
 	return string(buffer);
 }
 
+//_____________________________________________________________________________
+/**
+ * Rename a file, replacing the file aToName if it exists.  The replacement
+ * is atomic where the platform supports it, so aToName never goes missing;
+ * files written under a temporary name are moved into place with this.
+  * @return int 0 on success, error condition otherwise
+*/
+int IO::
+renameFile(const string &aFromName,const string &aToName)
+{
+#ifdef _MSC_VER
+	return MoveFileExA(aFromName.c_str(),aToName.c_str(),
+		MOVEFILE_REPLACE_EXISTING|MOVEFILE_WRITE_THROUGH) ? 0 : -1;
+#else
+	return rename(aFromName.c_str(),aToName.c_str());
+#endif
+}
+
 //_____________________________________________________________________________
 /**
  * Get parent directory of the passed in fileName.
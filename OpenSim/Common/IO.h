@@ -84,6 +84,21 @@ public:
 	static int GetPrecision();
 	static const char*
 		GetDoubleOutputFormat();
+	static int FormatDouble(double aValue,char *rBuffer,int aSize);
+#ifndef SWIG
+	/** A copy of the number output format, so that numbers can be formatted
+	later, e.g. on another thread, as the format was set when it was taken. */
+	struct OutputFormat {
+		bool scientific;
+		bool gFormat;
+		int pad;
+		int precision;
+		char doubleFormat[256];
+	};
+	static OutputFormat GetOutputFormat();
+	static int FormatDouble(double aValue,char *rBuffer,int aSize,
+		const OutputFormat &aFormat);
+#endif
 private:
 	static void ConstructDoubleOutputFormat();
 
@@ -105,6 +120,7 @@ public:
 	static int makeDir(const std::string &aDirName);
 	static int chDir(const std::string &aDirName);
 	static std::string getCwd();
+	static int renameFile(const std::string &aFromName,const std::string &aToName);
 	static std::string getParentDirectory(const std::string& fileName);
 	static std::string GetFileNameFromURI(const std::string& aURI);
 	static std::string formatText(const std::string& aComment,const std::string& leadingWhitespace,int width,const std::string& endlineTokenToInsert="\n");
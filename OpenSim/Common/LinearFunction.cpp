@@ -174,3 +174,20 @@ SimTK::Function* LinearFunction::createSimTKFunction() const
 	SimTK::Vector coeffs(_coefficients.getSize(), &_coefficients[0]);
     return new SimTK::Function::Linear(coeffs);
 }
+
+double LinearFunction::calcValue(double x) const
+{
+	// A function of more than one variable has more than two coefficients.
+	if (_coefficients.getSize() != 2)
+		return Function::calcValue(x);
+	return _coefficients[0]*x + _coefficients[1];
+}
+
+double LinearFunction::calcDerivative(double x, int order) const
+{
+	if (_coefficients.getSize() != 2)
+		return Function::calcDerivative(x, order);
+	if (order == 0)
+		return _coefficients[0]*x + _coefficients[1];
+	return order == 1 ? _coefficients[0] : 0.0;
+}
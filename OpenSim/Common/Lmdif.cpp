@@ -46,7 +46,6 @@ double dmin1(double a, double b);
 double dmax1(double a, double b);
 
 //#define BUG 0
-int JACOBIAN;
 
 void fdjac2(
   void (*fcn)(int, int, double[], double[], int *, void *),
@@ -1725,7 +1724,6 @@ void fdjac2(void (*fcn)(int, int, double[], double[], int *, void *),
    //    temp = dmax1(epsfcn,MACHEP);
    //    eps = sqrt(temp);
 
-   JACOBIAN = 1;
    eps = 1e-5;
 
 #ifdef BUG
@@ -1760,7 +1758,6 @@ void fdjac2(void (*fcn)(int, int, double[], double[], int *, void *),
    for (i = 0; i < m*n; i++)
       printf("%6e  ", fjac[i]);
 #endif
-   JACOBIAN = 0;
 }
 
 
@@ -38,13 +38,27 @@
 using namespace OpenSim;
 using SimTK::Vec3;
 
-int Mtx::_PSpaceSize = 0;
-int Mtx::_WSpaceSize = 0;
-double** Mtx::_P1Space = NULL;
-double** Mtx::_P2Space = NULL;
-double*  Mtx::_WSpace = NULL;
 static const double eps = std::numeric_limits<double>::epsilon();
 
+//_____________________________________________________________________________
+/**
+ * Scratch space owned by a single call, so that concurrent calls never share
+ * memory.  Up to N elements (enough for the 3x3 and 4x4 matrices used by the
+ * wrapping code) live on the stack; larger requests go to the heap.
+ */
+template <class T, int N>
+class LocalWorkSpace {
+public:
+	explicit LocalWorkSpace(int aN) : _heap(aN>N ? new T[aN] : NULL) {}
+	~LocalWorkSpace() { delete[] _heap; }
+	T* get() { return (_heap!=NULL) ? _heap : _stack; }
+private:
+	LocalWorkSpace(const LocalWorkSpace&);
+	LocalWorkSpace& operator=(const LocalWorkSpace&);
+	T _stack[N];
+	T *_heap;
+};
+
 
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
@@ -362,11 +376,9 @@ Multiply(int aNR1,int aNCR,int aNC2,const double *aM1,const double *aM2,
 	if(aNCR<=0) return(-1);
 	if(aNC2<=0) return(-1);
 
-	// ENSURE WORKSPACE CAPACITY
-	EnsureWorkSpaceCapacity(aNR1*aNC2);
-
-	// SET POINTER INTO WORKSPACE
-	double *m = _WSpace;
+	// WORKSPACE
+	LocalWorkSpace<double,16> work(aNR1*aNC2);
+	double *m = work.get();
 
 	// MULTIPLY
 	const double *ij1=NULL,*ij2=NULL;
@@ -414,13 +426,13 @@ Invert(int aN,const double *aM,double *rMInv)
 	double *M,**Mp,**Mr,**Ip,**Ir,*Mrj,*Irj,*Mij,*Iij,d;
 	int r,i,j,n;
 
-	// ENSURE WORKSPACE CAPACITY
-	EnsureWorkSpaceCapacity(aN*aN);
-	EnsurePointerSpaceCapacity(aN);
+	// WORKSPACE
+	LocalWorkSpace<double,16> work(aN*aN);
+	LocalWorkSpace<double*,4> rows1(aN),rows2(aN);
 
 	// INITIALIZE M (A COPY OF aM)
 	n = aN*aN*sizeof(double);
-	M = _WSpace;
+	M = work.get();
 	memcpy(M,aM,n);
 
 	// INITIALIZE rMInv TO THE IDENTITY MATRIX
@@ -428,10 +440,10 @@ Invert(int aN,const double *aM,double *rMInv)
 	for(r=0,Irj=rMInv,n=aN+1;r<aN;r++,Irj+=n)  *Irj=1.0;
 
 	// INITIALIZE ROW POINTERS
-	Mp = _P1Space;		// POINTER TO BEGINNING OF POINTER1 SPACE
-	Mr = _P1Space;		// ROW POINTERS INTO M
-	Ip	= _P2Space;		// POINTER TO BEGINNING OF POINTER2 SPACE
-	Ir = _P2Space;		// ROW POINTERS INTO aMInv
+	Mp = rows1.get();	// POINTER TO BEGINNING OF POINTER1 SPACE
+	Mr = Mp;			// ROW POINTERS INTO M
+	Ip	= rows2.get();	// POINTER TO BEGINNING OF POINTER2 SPACE
+	Ir = Ip;			// ROW POINTERS INTO aMInv
 	for(r=0;r<aN;r++,Mr++,Ir++) {
 		i = r*aN;
 		*Mr = M + i;
@@ -501,15 +513,15 @@ Transpose(int aNR,const int aNC,const double *aM,double *rMT)
 	if(aM==NULL) return(-1);
 	if(rMT==NULL) return(-1);
 
-	// ENSURE WORKSPACE CAPACITY
+	// WORKSPACE
 	int n = aNR*aNC;
-	EnsureWorkSpaceCapacity(n);
+	LocalWorkSpace<double,16> work(n);
 
 	// SET UP COUNTERS AND POINTERS
 	int r,c;
 	const double *Mrc;
 	double *Mcr;
-	double *MT = _WSpace;
+	double *MT = work.get();
 
 	// TRANSPOSE
 	for(r=0,Mrc=aM;r<aNR;r++) {
@@ -718,72 +730,3 @@ SetDim3(int n3,int n2,int n1,int i2,int i1,double *m,double *a)
 }
 
 
-//=============================================================================
-// WORKSPACE MANAGEMENT
-//=============================================================================
-//_____________________________________________________________________________
-/**
- * Ensure that the work space is at least of size aN.
- *
- * If the capacity could not be increased to aN, -1 is returned.  Otherwise,
- * 0 is returned.
- */
-int Mtx::
-EnsureWorkSpaceCapacity(int aN)
-{
-	if(aN>_WSpaceSize) {
-
-		_WSpaceSize = aN;
-
-		// DELETE EXISTING ALLOCATION
-		if(_WSpace!=NULL) delete[] _WSpace;
-
-		// W
-		_WSpace = new double[_WSpaceSize];
-		if(_WSpace==NULL) { _WSpaceSize=0;  return(-1); }
-	}
-
-	return(0);
-}
-//_____________________________________________________________________________
-/**
- * Ensure that the pointer spaces is at least of size aN.
- *
- * If the capacity could not be increased to aN, -1 is returned.  Otherwise,
- * 0 is returned.
- */
-int Mtx::
-EnsurePointerSpaceCapacity(int aN)
-{
-	if(aN>_PSpaceSize) {
-
-		_PSpaceSize = aN;
-
-		// DELETE EXISTING ALLOCATIONS
-		if(_P1Space!=NULL) delete[] _P1Space;
-		if(_P2Space!=NULL) delete[] _P2Space;
-
-		// P1
-		_P1Space = new double*[_PSpaceSize];
-		if(_P1Space==NULL) { _PSpaceSize=0;  return(-1); }
-
-		// P2
-		_P2Space = new double*[aN];
-		if(_P2Space==NULL) { delete[] _P1Space;  _PSpaceSize=0;  return(-1); }
-	}
-
-	return(0);
-}
-//_____________________________________________________________________________
-/**
- * Free the work and pointer spaces.
- */
-void Mtx::
-FreeWorkAndPointerSpaces()
-{
-	if(_WSpace!=NULL) { delete[] _WSpace;  _WSpace=NULL; }
-	if(_P1Space!=NULL) { delete[] _P1Space;  _P1Space=NULL; }
-	if(_P2Space!=NULL) { delete[] _P2Space;  _P2Space=NULL; }
-	_WSpaceSize = 0;
-	_PSpaceSize = 0;
-}
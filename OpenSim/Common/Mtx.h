@@ -43,20 +43,11 @@ namespace OpenSim {
 //=============================================================================
 /**
  * A class for performing vector and matrix operations.  Most all the
- * methods in this class are static.
+ * methods in this class are static.  The methods keep no shared state, so
+ * they may be called from several threads at once.
  */
 class OSIMCOMMON_API Mtx
 {
-//=============================================================================
-// DATA
-//=============================================================================
-private:
-	static int _PSpaceSize;
-	static int _WSpaceSize;
-	static double **_P1Space;
-	static double **_P2Space;
-	static double *_WSpace;
-
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -193,13 +184,6 @@ public:
 	static void GetDim3(int n3,int n2,int n1,int i2,int i1,double *m,double *a);
 	static void SetDim3(int n3,int n2,int n1,int i2,int i1,double *m,double *a);
 
-	//--------------------------------------------------------------------------
-	// WORKSPACE MANAGEMENT
-	//--------------------------------------------------------------------------
-	static int EnsureWorkSpaceCapacity(int aN);
-	static int EnsurePointerSpaceCapacity(int aN);
-	static void FreeWorkAndPointerSpaces();
-
 //=============================================================================
 };	// END class Mtx
 
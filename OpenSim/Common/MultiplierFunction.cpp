@@ -182,6 +182,26 @@ double MultiplierFunction::calcValue(const SimTK::Vector& x) const
 	}
 }
 
+double MultiplierFunction::calcValue(double x) const
+{
+	if (_osFunction)
+		return _osFunction->calcValue(x) * _scale;
+	else {
+		throw Exception("MultiplierFunction::calcValue(): _osFunction is NULL.");
+		return 0.0;
+	}
+}
+
+double MultiplierFunction::calcDerivative(double x, int order) const
+{
+	if (_osFunction)
+		return _osFunction->calcDerivative(x, order) * _scale;
+	else {
+		throw Exception("MultiplierFunction::calcDerivative(): _osFunction is NULL.");
+		return 0.0;
+	}
+}
+
 int MultiplierFunction::getArgumentSize() const
 {
 	if (_osFunction)
@@ -103,6 +103,8 @@ public:
 	//--------------------------------------------------------------------------
 	double calcValue(const SimTK::Vector& x) const;
 	double calcDerivative(const std::vector<int>& derivComponents, const SimTK::Vector& x) const;
+	double calcValue(double x) const;
+	double calcDerivative(double x, int order) const;
 	int getArgumentSize() const;
 	int getMaxDerivativeOrder() const;
 	SimTK::Function* createSimTKFunction() const;
@@ -41,6 +41,7 @@
 
 #include "Simbody.h"
 
+#include <atomic>
 #include <fstream>
 #include <vector>
 #include <map>
@@ -62,6 +63,45 @@ std::map<string,string>     Object::_renamedTypesMap;
 bool                        Object::_serializeAllDefaults=false;
 const string                Object::DEFAULT_NAME(ObjectDEFAULT_NAME);
 int                         Object::_debugLevel = 0;
+bool                        Object::_useParallelDeserialization=false;
+
+// Fewest objects in an object array worth reading concurrently.
+static const int MinObjectsForParallelRead = 8;
+// Only one object array is read concurrently at a time. Arrays nested in it,
+// and those of objects read on other threads meanwhile, are read serially.
+static std::atomic<bool> parallelReadInProgress(false);
+
+// Releases the concurrent read of an object array, also on an exception.
+struct ParallelReadGuard {
+	bool held;
+	~ParallelReadGuard() { if(held) parallelReadInProgress = false; }
+};
+
+//_____________________________________________________________________________
+/*
+ * Task that reads one object of an object array from its element per index.
+ */
+class ReadObjectsTask : public SimTK::ParallelExecutor::Task {
+public:
+	ReadObjectsTask(const vector<Object*>& objects,
+		vector<SimTK::Xml::Element>& elements, int versionNumber,
+		vector<string>& errors) :
+		_objects(objects), _elements(elements), _versionNumber(versionNumber),
+		_errors(errors) {}
+
+	void execute(int index) {
+		try {
+			_objects[index]->updateFromXMLNode(_elements[index], _versionNumber);
+		} catch(const std::exception& x) {
+			_errors[index] = x.what();
+		}
+	}
+private:
+	const vector<Object*>& _objects;
+	vector<SimTK::Xml::Element>& _elements;
+	int _versionNumber;
+	vector<string>& _errors;
+};
 
 //=============================================================================
 // CONSTRUCTOR(S)
@@ -969,9 +1009,25 @@ try {
 
 			// LOOP THROUGH PROPERTY ELEMENT'S CHILD ELEMENTS
             // Each element is expected to be an Object of some type given
-            // by the element's tag.
+            // by the element's tag. The objects are created in order and,
+            // when there are many and parallel deserialization is on, are 
+            // then read from their elements concurrently.
 			Object *object =NULL;
 			int objectsFound = 0;
+			vector<Object*> objects;
+			vector<SimTK::Xml::Element> elements;
+			bool readLater = false;
+			ParallelReadGuard guard = { false };
+			if(type==Property_Deprecated::ObjArray && _useParallelDeserialization) {
+				int n = 0;
+				SimTK::Xml::element_iterator it = propElementIter->element_begin();
+				for(; it != propElementIter->element_end() && 
+					  n < MinObjectsForParallelRead; ++it) ++n;
+				bool notInProgress = false;
+				readLater = (n >= MinObjectsForParallelRead) &&
+					parallelReadInProgress.compare_exchange_strong(notInProgress, true);
+				guard.held = readLater;
+			}
 			SimTK::Xml::element_iterator iter = propElementIter->element_begin();
 			while(iter != propElementIter->element_end()){
 				// Create an Object of the element tag's type.
@@ -994,9 +1050,24 @@ try {
 				} else {
 					property->appendValue(object);
 				}
-				object->updateFromXMLNode(*iter, versionNumber);
+				if(readLater) {
+					objects.push_back(object);
+					elements.push_back(*iter);
+				}
+				else
+					object->updateFromXMLNode(*iter, versionNumber);
 				iter++;
 			}
+
+			if(readLater) {
+				int n = (int)objects.size();
+				vector<string> errors(n);
+				ReadObjectsTask task(objects, elements, versionNumber, errors);
+				SimTK::ParallelExecutor executor;
+				executor.execute(task, n);
+				for(int i=0; i<n; i++)
+					if(!errors[i].empty()) throw Exception(errors[i]);
+			}
 				
 			break; }
 
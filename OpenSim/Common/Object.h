@@ -603,6 +603,22 @@ public:
 		return _serializeAllDefaults;
 	}
 
+	/** Static function to control whether the objects of large object arrays,
+    such as the members of a Set, are read from XML concurrently. Each object
+    is still created, and placed in its array, in document order; only reading
+    the objects' own contents from their elements is done in parallel. This
+    requires that reading any of the objects involved does not depend on
+    or modify state shared with the others. Off by default. **/
+	static void setUseParallelDeserialization(bool useParallel)
+	{
+		_useParallelDeserialization = useParallel;
+	}
+    /** Report the value of the "parallel deserialization" flag. **/
+	static bool getUseParallelDeserialization()
+	{
+		return _useParallelDeserialization;
+	}
+
     /** For testing or debugging purposes, manually clear the "object is up to 
     date with respect to properties" flag. This is normally done automatically
     when a property is modified. Setting the flag is always done manually,
@@ -837,6 +853,9 @@ private:
     //     troubleshooting.
 	static int      _debugLevel;
 
+	// Global flag to read the objects of large object arrays concurrently.
+	static bool _useParallelDeserialization;
+
 	// The name of this object.
 	std::string     _name;
 	// A short description of the object.
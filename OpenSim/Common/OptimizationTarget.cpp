@@ -54,10 +54,60 @@ const double OptimizationTarget::SMALLDX = 1.0e-14;
  * @param aNX The number of controls.
  */
 OptimizationTarget::
-OptimizationTarget(int aNX)
+OptimizationTarget(int aNX) :
+	_numDerivativeThreads(1)
 {
 	if(aNX>0) setNumParameters(aNX); // OptimizerSystem
 }
+//_____________________________________________________________________________
+/**
+ * Copy constructor.  The derivative workers and thread pool are not copied.
+ *
+ * @param aTarget Target to be copied.
+ */
+OptimizationTarget::
+OptimizationTarget(const OptimizationTarget &aTarget) :
+	SimTK::OptimizerSystem(aTarget),
+	_dx(aTarget._dx),
+	_numDerivativeThreads(aTarget._numDerivativeThreads)
+{
+}
+//_____________________________________________________________________________
+/**
+ * Destructor.
+ */
+OptimizationTarget::
+~OptimizationTarget()
+{
+	deleteDerivativeWorkers();
+}
+//_____________________________________________________________________________
+/**
+ * Assignment operator.  The derivative workers of this target were copies of
+ * the previous target, so they are deleted and created again on demand.
+ *
+ * @return Reference to this target.
+ */
+OptimizationTarget& OptimizationTarget::
+operator=(const OptimizationTarget &aTarget)
+{
+	if(&aTarget==this) return(*this);
+	SimTK::OptimizerSystem::operator=(aTarget);
+	_dx = aTarget._dx;
+	_numDerivativeThreads = aTarget._numDerivativeThreads;
+	deleteDerivativeWorkers();
+	return(*this);
+}
+//_____________________________________________________________________________
+/**
+ * Delete the derivative workers.
+ */
+void OptimizationTarget::
+deleteDerivativeWorkers()
+{
+	for(int i=0;i<_derivativeWorkers.getSize();i++) delete _derivativeWorkers[i];
+	_derivativeWorkers.setSize(0);
+}
 //==============================================================================
 // SET AND GET
 //==============================================================================
@@ -147,6 +197,69 @@ validatePerturbationSize(double &aSize)
 		aSize = SMALLDX;
 	}
 }
+//------------------------------------------------------------------------------
+// DERIVATIVE THREADS
+//------------------------------------------------------------------------------
+//______________________________________________________________________________
+/**
+ * Set the number of threads used to compute numerical derivatives.
+ *
+ * @param aNumThreads Number of threads; values less than 1 are treated as 1.
+ * @see createDerivativeWorker()
+ */
+void OptimizationTarget::
+setNumDerivativeThreads(int aNumThreads)
+{
+	_numDerivativeThreads = aNumThreads<1 ? 1 : aNumThreads;
+}
+//______________________________________________________________________________
+/**
+ * Get the targets that evaluate perturbed parameters, one per thread.  The
+ * first is this target; the others are workers created on demand and updated
+ * from this target.  Fewer than getNumDerivativeThreads() targets are
+ * returned if the target does not provide workers.
+ *
+ * @param rWorkers Targets to be used by the derivative threads.
+ * @return Number of targets in rWorkers.
+ */
+int OptimizationTarget::
+getDerivativeWorkers(Array<const OptimizationTarget*>& rWorkers) const
+{
+	rWorkers.setSize(0);
+	rWorkers.append(this);
+
+	int n = _numDerivativeThreads;
+	if(n>getNumParameters()) n = getNumParameters();
+	while(_derivativeWorkers.getSize()<n-1) {
+		OptimizationTarget *worker = createDerivativeWorker();
+		if(worker==NULL) break;
+		_derivativeWorkers.append(worker);
+	}
+	for(int i=0;i<n-1 && i<_derivativeWorkers.getSize();i++) {
+		updateDerivativeWorker(*_derivativeWorkers[i]);
+		rWorkers.append(_derivativeWorkers[i]);
+	}
+
+	return(rWorkers.getSize());
+}
+//______________________________________________________________________________
+/**
+ * Get the thread pool used to compute derivatives with aNumThreads workers.
+ * The pool is kept between calls and only created again when the number of
+ * workers changes.
+ *
+ * @param aNumThreads Number of derivative workers.
+ * @return Thread pool, or NULL if aNumThreads is 1 or less.
+ */
+SimTK::ParallelExecutor* OptimizationTarget::
+getDerivativeExecutor(int aNumThreads) const
+{
+	if(aNumThreads<=1) return(NULL);
+	if(!_derivativeExecutor ||
+	   _derivativeExecutor->getMaxThreads()!=aNumThreads)
+		_derivativeExecutor.reset(new SimTK::ParallelExecutor(aNumThreads));
+	return(_derivativeExecutor.get());
+}
 //______________________________________________________________________________
 /**
  */
@@ -161,6 +274,91 @@ printPerformance(double *x)
 //=============================================================================
 // STATIC DERIVATIVES
 //=============================================================================
+//_____________________________________________________________________________
+/*
+ * Task that evaluates the finite differences for every n-th control, where n
+ * is the number of workers.  Each index uses its own worker, so no worker is
+ * ever evaluated by two threads at once.
+ */
+class FiniteDifferencesTask : public SimTK::ParallelExecutor::Task {
+public:
+	enum Scheme { Central, Forward, CentralConstraint };
+
+	FiniteDifferencesTask(Scheme scheme,
+		const Array<const OptimizationTarget*>& workers, const double *dx,
+		const Vector &x, double p, Vector *dpdx, Matrix *jacobian) :
+		_scheme(scheme), _workers(workers), _dx(dx), _x(x), _p(p),
+		_dpdx(dpdx), _jacobian(jacobian), _status(-1,workers.getSize()) {}
+
+	void execute(int index) {
+		const OptimizationTarget *target = _workers[index];
+		int nw = _workers.getSize();
+		int nx = _x.size();
+		int nc = _scheme==CentralConstraint ? target->getNumConstraints() : 0;
+		Vector xp=_x;
+		Vector cf(nc),cb(nc);
+		double pf=0.0,pb=0.0;
+		int status = -1;
+
+		for(int i=index;i<nx;i+=nw) {
+			// PERTURB FORWARD
+			xp[i] = _x[i] + _dx[i];
+			if(_scheme==CentralConstraint)
+				status = target->constraintFunc(xp,true,cf);
+			else
+				status = target->objectiveFunc(xp,true,pf);
+			if(status<0) break;
+
+			if(_scheme==Forward) {
+				(*_dpdx)[i] = (pf-_p)/_dx[i];
+			} else {
+				// PERTURB BACKWARD
+				xp[i] = _x[i] - _dx[i];
+				if(_scheme==CentralConstraint)
+					status = target->constraintFunc(xp,true,cb);
+				else
+					status = target->objectiveFunc(xp,true,pb);
+				if(status<0) break;
+
+				// DERIVATIVES
+				double rdx = 0.5 / _dx[i];
+				if(_scheme==CentralConstraint)
+					for(int j=0;j<nc;j++) (*_jacobian)(j,i) = rdx*(cf[j]-cb[j]);
+				else
+					(*_dpdx)[i] = rdx*(pf-pb);
+			}
+
+			// RESTORE CONTROLS
+			xp[i] = _x[i];
+		}
+		_status[index] = status;
+	}
+
+	// Evaluate all controls, in parallel on aExecutor if there is more than
+	// one worker, and return the lowest status of the workers.
+	int run(SimTK::ParallelExecutor *aExecutor) {
+		int nw = _workers.getSize();
+		if(nw>1) {
+			aExecutor->execute(*this,nw);
+		} else {
+			execute(0);
+		}
+		int status = _status[0];
+		for(int i=1;i<nw;i++) if(_status[i]<status) status = _status[i];
+		return(status);
+	}
+
+private:
+	Scheme _scheme;
+	const Array<const OptimizationTarget*>& _workers;
+	const double *_dx;
+	const Vector &_x;
+	double _p;
+	Vector *_dpdx;
+	Matrix *_jacobian;
+	Array<int> _status;
+};
+
 //_____________________________________________________________________________
 /**
  * Compute derivatives of a constraint with respect to the
@@ -182,34 +380,13 @@ CentralDifferencesConstraint(const OptimizationTarget *aTarget,
 	// INITIALIZE CONTROLS
 	int nx = aTarget->getNumParameters(); if(nx<=0) return(-1);
 	int nc = aTarget->getNumConstraints(); if(nc<=0) return(-1);
-	Vector xp=x;
-	Vector cf(nc),cb(nc);
-
-	// INITIALIZE STATUS
-	int status = -1;
 
 	// LOOP OVER CONTROLS
-	for(int i=0;i<nx;i++) {
-
-		// PERTURB FORWARD
-		xp[i] = x[i] + dx[i];
-		status = aTarget->constraintFunc(xp,true,cf);
-		if(status<0) return(status);
-
-		// PERTURB BACKWARD
-		xp[i] = x[i] - dx[i];
-		status = aTarget->constraintFunc(xp,true,cb);
-		if(status<0) return(status);
-
-		// DERIVATIVES OF CONSTRAINTS
-		double rdx = 0.5 / dx[i];
-		for(int j=0;j<nc;j++) jacobian(j,i) = rdx*(cf[j]-cb[j]);
-
-		// RESTORE CONTROLS
-		xp[i] = x[i];
-	}
-
-	return(status);
+	Array<const OptimizationTarget*> workers;
+	int nw = aTarget->getDerivativeWorkers(workers);
+	FiniteDifferencesTask task(FiniteDifferencesTask::CentralConstraint,
+		workers,dx,x,0.0,NULL,&jacobian);
+	return(task.run(aTarget->getDerivativeExecutor(nw)));
 }
 //_____________________________________________________________________________
 /**
@@ -231,36 +408,13 @@ CentralDifferences(const OptimizationTarget *aTarget,
 
 	// CONTROLS
 	int nx = aTarget->getNumParameters();  if(nx<=0) return(-1);
-	Vector xp=x;
-
-	// PERFORMANCE
-	double pf,pb;
-
-	// INITIALIZE STATUS
-	int status = -1;
 
 	// LOOP OVER CONTROLS
-	for(int i=0;i<nx;i++) {
-
-		// PERTURB FORWARD
-		xp[i] = x[i] + dx[i];
-		status = aTarget->objectiveFunc(xp,true,pf);
-		if(status<0) return(status);
-
-		// PERTURB BACKWARD
-		xp[i] = x[i] - dx[i];
-		status = aTarget->objectiveFunc(xp,true,pb);
-		if(status<0) return(status);
-
-		// DERIVATIVES OF PERFORMANCE
-		double rdx = 0.5 / dx[i];
-		dpdx[i] = rdx*(pf-pb);
-
-		// RESTORE CONTROLS
-		xp[i] = x[i];
-	}
-
-	return(status);
+	Array<const OptimizationTarget*> workers;
+	int nw = aTarget->getDerivativeWorkers(workers);
+	FiniteDifferencesTask task(FiniteDifferencesTask::Central,
+		workers,dx,x,0.0,&dpdx,NULL);
+	return(task.run(aTarget->getDerivativeExecutor(nw)));
 }
 
 //_____________________________________________________________________________
@@ -283,31 +437,16 @@ ForwardDifferences(const OptimizationTarget *aTarget,
 
 	// CONTROLS
 	int nx = aTarget->getNumParameters();  if(nx<=0) return(-1);
-	Vector xp=x;
 
-	// INITIALIZE STATUS
-	int status = -1;
-
-	// PERFORMANCE
-	double pf,pb;
-	
 	// current objective function value
-	status = aTarget->objectiveFunc(xp,true,pb);
+	double pb;
+	int status = aTarget->objectiveFunc(x,true,pb);
 	if(status<0) return(status);
 
 	// LOOP OVER CONTROLS
-	for(int i=0;i<nx;i++) {
-		// PERTURB FORWARD
-		xp[i] = x[i] + dx[i];
-		status = aTarget->objectiveFunc(xp,true,pf);
-		if(status<0) return(status);
-
-		// DERIVATIVES OF PERFORMANCE
-		dpdx[i] = (pf-pb)/dx[i];
-
-		// RESTORE CONTROLS
-		xp[i] = x[i];
-	}
-
-	return(status);
-}
\ No newline at end of file
+	Array<const OptimizationTarget*> workers;
+	int nw = aTarget->getDerivativeWorkers(workers);
+	FiniteDifferencesTask task(FiniteDifferencesTask::Forward,
+		workers,dx,x,pb,&dpdx,NULL);
+	return(task.run(aTarget->getDerivativeExecutor(nw)));
+}
@@ -34,6 +34,7 @@
 #include "osimCommonDLL.h"
 #include "Array.h"
 #include <simmath/Optimizer.h>
+#include <memory>
 
 
 namespace OpenSim { 
@@ -58,12 +59,28 @@ public:
 protected:
 	/** Perturbation size for computing numerical derivatives. */
 	Array<double> _dx;
+	/** Number of threads used to compute numerical derivatives. */
+	int _numDerivativeThreads;
+private:
+	/** Copies of this target used by derivative threads other than the
+	first, created on demand by createDerivativeWorker(). */
+	mutable Array<OptimizationTarget*> _derivativeWorkers;
+	/** Thread pool shared by the derivative computations of this target,
+	created on demand. */
+	mutable std::unique_ptr<SimTK::ParallelExecutor> _derivativeExecutor;
 
 //=============================================================================
 // METHODS
 //=============================================================================
 public:
 	OptimizationTarget(int aNX=0);
+	/** Copy a target. The derivative workers and thread pool of aTarget are
+	not shared; the copy creates its own when it needs them. */
+	OptimizationTarget(const OptimizationTarget& aTarget);
+	virtual ~OptimizationTarget();
+#ifndef SWIG
+	OptimizationTarget& operator=(const OptimizationTarget& aTarget);
+#endif
 
 	// SET AND GET
 	void setNumParameters(const int aNX); // OptimizerSystem function
@@ -71,6 +88,25 @@ public:
 	void setDX(int aIndex,double aVal);
 	double getDX(int aIndex);
 	double* getDXArray();
+	/** Set the number of threads used by CentralDifferences(),
+	ForwardDifferences() and CentralDifferencesConstraint() to evaluate
+	perturbed parameters. Threads beyond the first each use a worker created
+	by createDerivativeWorker(); if the target does not provide workers the
+	derivatives are computed serially. The default is 1. */
+	void setNumDerivativeThreads(int aNumThreads);
+	int getNumDerivativeThreads() const { return _numDerivativeThreads; }
+
+	// PARALLEL DERIVATIVES
+	/** Create an independent copy of this target, with its own model and
+	state, whose objectiveFunc() and constraintFunc() may be evaluated
+	concurrently with those of this target. The copy is owned and cached by
+	this target. The default returns NULL, meaning the target cannot be
+	evaluated concurrently. */
+	virtual OptimizationTarget* createDerivativeWorker() const { return NULL; }
+	/** Bring a worker up to date with this target before derivatives are
+	computed with it, e.g., by copying the current state. Called serially
+	each time the derivatives are computed. The default does nothing. */
+	virtual void updateDerivativeWorker(OptimizationTarget& aWorker) const {}
 
 	// UTILITY
 	void validatePerturbationSize(double &aSize);
@@ -88,6 +124,11 @@ public:
 		ForwardDifferences(const OptimizationTarget *aTarget,
 		double *dx,const SimTK::Vector &x,SimTK::Vector &dpdx);
 
+private:
+	int getDerivativeWorkers(Array<const OptimizationTarget*>& rWorkers) const;
+	SimTK::ParallelExecutor* getDerivativeExecutor(int aNumThreads) const;
+	void deleteDerivativeWorkers();
+
 };
 
 }; //namespace
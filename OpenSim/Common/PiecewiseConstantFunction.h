@@ -118,6 +118,8 @@ public:
     virtual double evaluateTotalSecondDerivative(double aX,double aDxdt,double aD2xdt2) const;
     double calcValue(const SimTK::Vector& x) const;
     double calcDerivative(const std::vector<int>& derivComponents, const SimTK::Vector& x) const;
+    double calcValue(double x) const;
+    double calcDerivative(double x, int order) const;
     int getArgumentSize() const;
     int getMaxDerivativeOrder() const;
     SimTK::Function* createSimTKFunction() const;
@@ -427,9 +427,13 @@ void PiecewiseLinearFunction::calcCoefficients()
 }
 
 double PiecewiseLinearFunction::calcValue(const Vector& x) const
+{
+    return calcValue(x[0]);
+}
+
+double PiecewiseLinearFunction::calcValue(double aX) const
 {
     int n = _x.getSize();
-    double aX = x[0];
 
     if (aX < _x[0])
         return _y[0] + (aX - _x[0]) * _b[0];
@@ -466,11 +470,17 @@ double PiecewiseLinearFunction::calcDerivative(const std::vector<int>& derivComp
 {
     if (derivComponents.size() == 0)
         return SimTK::NaN;
-    if (derivComponents.size() > 1)
+    return calcDerivative(x[0], (int)derivComponents.size());
+}
+
+double PiecewiseLinearFunction::calcDerivative(double aX, int order) const
+{
+    if (order == 0)
+        return calcValue(aX);
+    if (order > 1)
         return 0.0;
 
     int n = _x.getSize();
-    double aX = x[0];
 
     if (aX < _x[0]) {
         return _b[0];
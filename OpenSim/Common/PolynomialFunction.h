@@ -105,6 +105,31 @@ public:
 		return new SimTK::Function::Polynomial(get_coefficients());
 	}
 
+	using Function::calcValue;
+	using Function::calcDerivative;
+
+	/** Evaluate the polynomial at x by Horner's rule. */
+	virtual double calcValue(double x) const
+	{
+		return calcDerivative(x, 0);
+	}
+
+	/** Evaluate a derivative of the polynomial at x by Horner's rule on the
+	 * coefficients of the derivative. */
+	virtual double calcDerivative(double x, int order) const
+	{
+		const SimTK::Vector& c = get_coefficients();
+		const int n = c.size()-1;
+		double value = 0;
+		for (int i = 0; i <= n-order; ++i) {
+			double factor = 1;
+			for (int j = 0; j < order; ++j)
+				factor *= n-i-j;
+			value = value*x + factor*c[i];
+		}
+		return value;
+	}
+
 private:
 	/**
 	* Construct the serializiable property member variables and
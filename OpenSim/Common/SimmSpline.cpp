@@ -512,6 +512,11 @@ int SimmSpline::addPoint(double aX, double aY)
 }
 
 double SimmSpline::calcValue(const Vector& x) const
+{
+	return calcValue(x[0]);
+}
+
+double SimmSpline::calcValue(double aX) const
 {
 	// NOT A NUMBER
 	if(!_y.getSize()) return(SimTK::NaN);
@@ -523,7 +528,6 @@ double SimmSpline::calcValue(const Vector& x) const
     double dx;
 
 	int n = _x.getSize();
-    double aX = x[0];
 
    /* Check if the abscissa is out of range of the function. If it is,
     * then use the slope of the function at the appropriate end point to
@@ -580,6 +584,14 @@ double SimmSpline::calcValue(const Vector& x) const
 
 double SimmSpline::calcDerivative(const std::vector<int>& derivComponents, const Vector& x) const
 {
+	return calcDerivative(x[0], (int)derivComponents.size());
+}
+
+double SimmSpline::calcDerivative(double aX, int aDerivOrder) const
+{
+	if (aDerivOrder == 0)
+		return calcValue(aX);
+
 	// NOT A NUMBER
 	if(!_y.getSize()) return(SimTK::NaN);
 	if(!_b.getSize()) return(SimTK::NaN);
@@ -590,8 +602,6 @@ double SimmSpline::calcDerivative(const std::vector<int>& derivComponents, const
     double dx;
 
 	int n = _x.getSize();
-    double aX = x[0];
-    int aDerivOrder = (int)derivComponents.size();
     if (aDerivOrder < 1 || aDerivOrder > 2)
 		throw Exception("SimmSpline::calcDerivative(): derivative order must be 1 or 2.");
 
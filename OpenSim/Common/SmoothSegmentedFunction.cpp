@@ -24,6 +24,14 @@
 // INCLUDES
 //=============================================================================
 #include "SmoothSegmentedFunction.h"
+#include "IO.h"
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
 
 //=============================================================================
 // STATICS
@@ -37,6 +45,332 @@ static double UTOL = (double)SimTK::Eps*1e2;
 static double INTTOL = (double)SimTK::Eps*1e2;
 static int MAXITER = 20;
 static int NUM_SAMPLE_PTS = 100;
+
+//=============================================================================
+// SHARED CURVE FITS
+//=============================================================================
+struct SmoothSegmentedFunction::CurveFit {
+    // The definition of the curve
+    SimTK::Matrix mX;
+    SimTK::Matrix mY;
+    bool intx0x1;
+    // Spline fit functions X(u) for each Bezier elbow
+    SimTK::Array_<SimTK::Spline> splinesUX;
+    // Spline fit of the integral, valid once hasIntegral is true
+    SimTK::Spline splineYintX;
+    std::atomic<bool> hasIntegral;
+    std::mutex integralMutex;
+    // The cache file of the fit, if cache files are in use
+    std::string cacheFile;
+    unsigned long long hash;
+
+    CurveFit() : intx0x1(true), hasIntegral(false), hash(0) {}
+
+    // The fits in use, by curve definition. A fit is released with the last
+    // curve that uses it. Curves may be constructed during the static 
+    // initialization of other libraries, hence the function statics.
+    typedef std::map<std::vector<double>, std::weak_ptr<CurveFit> > Registry;
+    static Registry& registry()
+    {   static Registry fits; return fits; }
+    static std::mutex& registryMutex()
+    {   static std::mutex mutex; return mutex; }
+};
+
+// Everything the fitted splines of a curve depend on.
+static std::vector<double> describeCurve(const SimTK::Matrix& mX, 
+    const SimTK::Matrix& mY, const double ends[6], bool intx0x1)
+{
+    std::vector<double> values;
+    values.push_back(mX.nrow());
+    values.push_back(mX.ncol());
+    for(int j=0; j < mX.ncol(); j++)
+        for(int i=0; i < mX.nrow(); i++){
+            values.push_back(mX(i,j));
+            values.push_back(mY(i,j));
+        }
+    values.insert(values.end(), ends, ends+6);
+    values.push_back(intx0x1 ? 1 : 0);
+    values.push_back(NUM_SAMPLE_PTS);
+    return values;
+}
+
+// Sample u and x(u) of Bezier section s
+static void sampleBezierSection(const SimTK::Matrix& mX, int s,
+                                SimTK::Vector& u, SimTK::Vector& x)
+{
+    for(int i=0;i<NUM_SAMPLE_PTS;i++){
+        u(i) = ( (double)i )/( (double)(NUM_SAMPLE_PTS-1) );
+        x(i) = SegmentedQuinticBezierToolkit::
+            calcQuinticBezierCurveVal(u(i),mX(s));            
+    }
+}
+
+//=============================================================================
+// CACHE FILES
+//=============================================================================
+// Tag at the start of a curve cache file, which also identifies its layout.
+static const char CurveCacheTag[] = "OpenSimSmoothSegmentedFunction2";
+static std::mutex& curveCacheMutex()
+{   static std::mutex mutex; return mutex; }
+static std::string& curveCacheDirectory()
+{   static std::string directory; return directory; }
+
+// FNV-1a hash of a curve definition
+static unsigned long long hashCurve(const std::vector<double>& definition)
+{
+    unsigned long long hash = 14695981039346656037ULL;
+    const unsigned char* bytes = (const unsigned char*)&definition[0];
+    for(size_t b=0; b < definition.size()*sizeof(double); b++){
+        hash ^= bytes[b];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static void writeSpline(std::ostream& out, const SimTK::Spline& spline)
+{
+    int degree = spline.getSplineDegree();
+    const SimTK::Vector& x = spline.getControlPointLocations();
+    const SimTK::Vector& y = spline.getControlPointValues();
+    int n = x.size();
+    out.write((const char*)&degree, sizeof(degree));
+    out.write((const char*)&n, sizeof(n));
+    for(int i=0; i < n; i++) out.write((const char*)&x[i], sizeof(double));
+    for(int i=0; i < n; i++) out.write((const char*)&y[i], sizeof(double));
+}
+
+static bool readSpline(std::istream& in, SimTK::Spline& spline)
+{
+    int degree = -1, n = -1;
+    in.read((char*)&degree, sizeof(degree));
+    in.read((char*)&n, sizeof(n));
+    if(!in.good() || degree < 1 || n <= degree) return false;
+    SimTK::Vector x(n), y(n);
+    for(int i=0; i < n; i++) in.read((char*)&x[i], sizeof(double));
+    for(int i=0; i < n; i++) in.read((char*)&y[i], sizeof(double));
+    if(in.fail()) return false;
+    spline = SimTK::Spline(degree, x, y);
+    return true;
+}
+
+// Read the fitted splines of a curve from a cache file. Fails if the file
+// does not exist or was written for a different curve. The integral is read
+// too if it had been computed when the file was written.
+static bool readCurveCacheFile(const std::string& cacheFile,
+    unsigned long long hash, int numSections, 
+    SimTK::Array_<SimTK::Spline>& splinesUX, 
+    bool& computedIntegral, SimTK::Spline& splineYintX)
+{
+    std::ifstream in(cacheFile.c_str(), std::ios::in | std::ios::binary);
+    if(!in.good()) return false;
+
+    char tag[sizeof(CurveCacheTag)-1];
+    unsigned long long fileHash = 0;
+    int n = -1, hasIntegral = -1;
+    in.read(tag, sizeof(tag));
+    in.read((char*)&fileHash, sizeof(fileHash));
+    in.read((char*)&n, sizeof(n));
+    in.read((char*)&hasIntegral, sizeof(hasIntegral));
+    if(!in.good() || std::string(tag, sizeof(tag))!=CurveCacheTag ||
+        fileHash!=hash || n!=numSections || (hasIntegral!=0 && hasIntegral!=1))
+        return false;
+
+    SimTK::Array_<SimTK::Spline> splines(n);
+    for(int s=0; s < n; s++)
+        if(!readSpline(in, splines[s])) return false;
+    SimTK::Spline integral;
+    if(hasIntegral==1 && !readSpline(in, integral)) return false;
+
+    splinesUX = splines;
+    computedIntegral = hasIntegral==1;
+    if(computedIntegral) splineYintX = integral;
+    return true;
+}
+
+// Save the fitted splines of a curve to a cache file. The file is written
+// under a temporary name of this thread first, then renamed over the cache
+// file, so that a reader never sees a partial file even when two threads
+// fit the same curve. Failure (e.g., a read-only directory) only means
+// later runs fit again.
+static void writeCurveCacheFile(const std::string& cacheFile,
+    unsigned long long hash, bool computedIntegral,
+    const SimTK::Array_<SimTK::Spline>& splinesUX,
+    const SimTK::Spline& splineYintX)
+{
+    std::ostringstream tmpName;
+    tmpName << cacheFile << "." << std::this_thread::get_id() << ".tmp";
+    std::string tmpFile = tmpName.str();
+    std::ofstream out(tmpFile.c_str(), std::ios::out | std::ios::binary);
+    if(!out.good()) return;
+
+    int n = (int)splinesUX.size();
+    int hasIntegral = computedIntegral ? 1 : 0;
+    out.write(CurveCacheTag, sizeof(CurveCacheTag)-1);
+    out.write((const char*)&hash, sizeof(hash));
+    out.write((const char*)&n, sizeof(n));
+    out.write((const char*)&hasIntegral, sizeof(hasIntegral));
+    for(int s=0; s < n; s++) writeSpline(out, splinesUX[s]);
+    if(computedIntegral) writeSpline(out, splineYintX);
+    out.close();
+
+    if(out.fail()){
+        std::remove(tmpFile.c_str());
+        return;
+    }
+    if(IO::renameFile(tmpFile, cacheFile) != 0)
+        std::remove(tmpFile.c_str());
+}
+
+void SmoothSegmentedFunction::setCacheDirectory(const std::string& directory)
+{
+    std::lock_guard<std::mutex> lock(curveCacheMutex());
+    curveCacheDirectory() = directory;
+}
+
+std::string SmoothSegmentedFunction::getCacheDirectory()
+{
+    std::lock_guard<std::mutex> lock(curveCacheMutex());
+    return curveCacheDirectory();
+}
+
+std::string SmoothSegmentedFunction::getCacheFileName() const
+{
+    return _fit->cacheFile;
+}
+
+int SmoothSegmentedFunction::getNumSharedCurves()
+{
+    std::lock_guard<std::mutex> lock(CurveFit::registryMutex());
+    const CurveFit::Registry& registry = CurveFit::registry();
+    int n = 0;
+    CurveFit::Registry::const_iterator it;
+    for(it = registry.begin(); it != registry.end(); ++it)
+        if(!it->second.expired()) n++;
+    return n;
+}
+
+std::shared_ptr<SmoothSegmentedFunction::CurveFit> SmoothSegmentedFunction::
+    findCurveFit(const SimTK::Matrix& mX, const SimTK::Matrix& mY,  
+          double x0, double x1, double y0, double y1,double dydx0, double dydx1,
+          bool intx0x1)
+{
+    double ends[6] = {x0, x1, y0, y1, dydx0, dydx1};
+    std::vector<double> definition = describeCurve(mX, mY, ends, intx0x1);
+
+    //The fit of a curve with the same definition, if one is in use
+    {
+        std::lock_guard<std::mutex> lock(CurveFit::registryMutex());
+        CurveFit::Registry::iterator it = CurveFit::registry().find(definition);
+        if(it != CurveFit::registry().end()){
+            std::shared_ptr<CurveFit> fit = it->second.lock();
+            if(fit) return fit;
+        }
+    }
+
+    //Fit the curve without holding the lock so that other curves can be
+    //found and fitted meanwhile
+    std::shared_ptr<CurveFit> fit(new CurveFit());
+    fit->mX = mX;
+    fit->mY = mY;
+    fit->intx0x1 = intx0x1;
+
+    //Reuse the splines fitted for the same curve by an earlier run, if the
+    //cache files are on
+    std::string cacheDirectory = getCacheDirectory();
+    if(!cacheDirectory.empty()){
+        fit->hash = hashCurve(definition);
+        std::ostringstream name;
+        name << cacheDirectory << "/" << std::hex << fit->hash << ".ssf";
+        fit->cacheFile = name.str();
+    }
+
+    bool computedIntegral = false;
+    if(fit->cacheFile.empty() || !readCurveCacheFile(fit->cacheFile, fit->hash,
+        mX.ncol(), fit->splinesUX, computedIntegral, fit->splineYintX)){
+
+        //////////////////////////////////////////////////
+        //Generate the set of splines that approximate u(x)
+        //////////////////////////////////////////////////
+        SimTK::Vector u(NUM_SAMPLE_PTS); //Used for the approximate inverse
+        SimTK::Vector x(NUM_SAMPLE_PTS); //Used for the approximate inverse
+
+        fit->splinesUX.resize(mX.ncol());
+        for(int s=0; s < mX.ncol(); s++){
+            sampleBezierSection(mX, s, u, x);
+            //Create the array of approximate inverses for u(x)    
+            fit->splinesUX[s] = SimTK::SplineFitter<Real>::
+                fitForSmoothingParameter(3,x,u,0).getSpline();
+        }
+
+        if(!fit->cacheFile.empty())
+            writeCurveCacheFile(fit->cacheFile, fit->hash, false, 
+                                fit->splinesUX, fit->splineYintX);
+    }
+    fit->hasIntegral = computedIntegral;
+
+    std::lock_guard<std::mutex> lock(CurveFit::registryMutex());
+    CurveFit::Registry& registry = CurveFit::registry();
+
+    //Another thread may have fitted the same curve meanwhile; use its fit so
+    //that the curve is shared
+    std::weak_ptr<CurveFit>& entry = registry[definition];
+    std::shared_ptr<CurveFit> existing = entry.lock();
+    if(existing) return existing;
+    entry = fit;
+
+    //Drop the entries of fits that are no longer used
+    CurveFit::Registry::iterator it;
+    for(it = registry.begin(); it != registry.end();){
+        if(it->second.expired()) registry.erase(it++);
+        else ++it;
+    }
+    return fit;
+}
+
+const SimTK::Spline& SmoothSegmentedFunction::getIntegralSpline() const
+{
+    CurveFit& fit = *_fit;
+    if(fit.hasIntegral) return fit.splineYintX;
+
+    std::lock_guard<std::mutex> lock(fit.integralMutex);
+    if(fit.hasIntegral) return fit.splineYintX;
+
+    //////////////////////////////////////////////////
+    //Compute the integral of y(x) and spline the result    
+    //////////////////////////////////////////////////
+    int numSections = fit.mX.ncol();
+    SimTK::Vector u(NUM_SAMPLE_PTS);
+    SimTK::Vector x(NUM_SAMPLE_PTS);
+
+    //The knot points of the integral of y(x). The last point of a section 
+    //that has another section after it is skipped, because it is identical
+    //to the first point of the next section.
+    SimTK::Vector xALL(NUM_SAMPLE_PTS*numSections-(numSections-1));
+    int xidx = 0;
+    for(int s=0; s < numSections; s++){
+        sampleBezierSection(fit.mX, s, u, x);
+        for(int i=0;i<NUM_SAMPLE_PTS;i++){
+            if(i<(NUM_SAMPLE_PTS-1) || s == (numSections-1)){
+                xALL(xidx) = x(i);
+                xidx++;
+            }
+        }
+    }
+
+    SimTK::Matrix yInt =  SegmentedQuinticBezierToolkit::
+        calcNumIntBezierYfcnX(xALL,0,INTTOL, UTOL, MAXITER,fit.mX, fit.mY,
+        fit.splinesUX,fit.intx0x1,_name);
+
+    fit.splineYintX = SimTK::SplineFitter<Real>::
+            fitForSmoothingParameter(3,yInt(0),yInt(1),0).getSpline();
+
+    if(!fit.cacheFile.empty())
+        writeCurveCacheFile(fit.cacheFile, fit.hash, true, 
+                            fit.splinesUX, fit.splineYintX);
+
+    fit.hasIntegral = true;
+    return fit.splineYintX;
+}
 //=============================================================================
 // UTILITY FUNCTIONS
 //=============================================================================
@@ -71,7 +405,7 @@ static int NUM_SAMPLE_PTS = 100;
                                                     +m+m*100*3  +m*100*4+9+M:2                             
                     + m*Cost(SimTK::SplineFitter ...)
        =========================================================================
-        ADDITIONAL COST OF COMPUTING THE INTEGRAL CURVE
+        ADDITIONAL COST OF COMPUTING THE INTEGRAL CURVE (ON ITS FIRST USE)
         
                                Comp Div     Mult  Add      Assign       
        RK45 Fn.Eval     m*100*(156  12      618   390      456)
@@ -99,59 +433,8 @@ _x0(x0),_x1(x1),_y0(y0),_y1(y1),_dydx0(dydx0),_dydx1(dydx1),
 
     _numBezierSections = mX.ncol();
 
-    //////////////////////////////////////////////////
-    //Generate the set of splines that approximate u(x)
-    //////////////////////////////////////////////////
-    SimTK::Vector u(NUM_SAMPLE_PTS); //Used for the approximate inverse
-    SimTK::Vector x(NUM_SAMPLE_PTS); //Used for the approximate inverse
-
-    //Used to generate the set of knot points of the integral of y(x)    
-   SimTK::Vector xALL(NUM_SAMPLE_PTS*_numBezierSections-(_numBezierSections-1));
-    _arraySplineUX.resize(_numBezierSections);
-    int xidx = 0;
-
-    for(int s=0; s < _numBezierSections; s++){
-        //Sample the local set for u and x
-        for(int i=0;i<NUM_SAMPLE_PTS;i++){
-            u(i) = ( (double)i )/( (double)(NUM_SAMPLE_PTS-1) );
-            x(i) = SegmentedQuinticBezierToolkit::
-                calcQuinticBezierCurveVal(u(i),mX(s));            
-            if(_numBezierSections > 1){
-                //Skip the last point of a set that has another set of points
-                //after it. Why? The last point and the starting point of the
-                //next set are identical in value.
-                if(i<(NUM_SAMPLE_PTS-1) || s == (_numBezierSections-1)){
-                    xALL(xidx) = x(i);
-                    xidx++;
-                }
-            }else{
-                xALL(xidx) = x(i);                
-                xidx++;
-            }
-        }
-        //Create the array of approximate inverses for u(x)    
-        _arraySplineUX[s] = SimTK::SplineFitter<Real>::
-            fitForSmoothingParameter(3,x,u,0).getSpline();
-    }
-
-    if(_computeIntegral){
-        //////////////////////////////////////////////////
-        //Compute the integral of y(x) and spline the result    
-        //////////////////////////////////////////////////
-
-        SimTK::Matrix yInt =  SegmentedQuinticBezierToolkit::
-            calcNumIntBezierYfcnX(xALL,0,INTTOL, UTOL, MAXITER,mX, mY,
-            _arraySplineUX,_intx0x1,_name);
-
-        //not correct
-        //if(_intx0x1==false){
-        //    yInt = yInt*-1;
-        //    yInt = yInt - yInt(yInt.nelt()-1);
-        //}
-
-        _splineYintX = SimTK::SplineFitter<Real>::
-                fitForSmoothingParameter(3,yInt(0),yInt(1),0).getSpline();
-    }
+    //Share the splines of any other curve with the same definition
+    _fit = findCurveFit(mX, mY, x0, x1, y0, y1, dydx0, dydx1, intx0x1);
     
 	_mXVec.resize(_numBezierSections);
 	_mYVec.resize(_numBezierSections);
@@ -166,10 +449,8 @@ _x0(x0),_x1(x1),_y0(y0),_y1(y1),_dydx0(dydx0),_dydx1(dydx1),
      ,_y1(SimTK::NaN),_dydx0(SimTK::NaN),_dydx1(SimTK::NaN),
      _computeIntegral(false),_intx0x1(false),_name("NOT_YET_SET")
  {
-        _arraySplineUX.resize(0);        
 		_mXVec.resize(0);
 		_mYVec.resize(0);
-        _splineYintX = SimTK::Spline();
         _numBezierSections = (int)SimTK::NaN;
        
  }
@@ -202,7 +483,7 @@ double SmoothSegmentedFunction::calcValue(double x) const
     {
         int idx  = SegmentedQuinticBezierToolkit::calcIndex(x,_mXVec);
         double u = SegmentedQuinticBezierToolkit::
-                 calcU(x,_mXVec[idx], _arraySplineUX[idx], UTOL,MAXITER);
+                 calcU(x,_mXVec[idx], _fit->splinesUX[idx], UTOL,MAXITER);
         yVal = SegmentedQuinticBezierToolkit::
                  calcQuinticBezierCurveVal(u,_mYVec[idx]);
     }else{
@@ -270,7 +551,7 @@ double SmoothSegmentedFunction::calcDerivative(double x, int order) const
             if(x >= _x0 && x <= _x1){        
         		int idx  = SegmentedQuinticBezierToolkit::calcIndex(x,_mXVec);
                 double u = SegmentedQuinticBezierToolkit::
-                                calcU(x,_mXVec[idx], _arraySplineUX[idx], 
+                                calcU(x,_mXVec[idx], _fit->splinesUX[idx], 
                                 UTOL,MAXITER);
                 yVal = SegmentedQuinticBezierToolkit::
                             calcQuinticBezierCurveDerivDYDX(u, _mXVec[idx], 
@@ -349,15 +630,17 @@ double SmoothSegmentedFunction::calcIntegral(double x) const
         "%s: This curve was not constructed with its integral because"
         "computeIntegral was false",_name.c_str());
 
+    const SimTK::Spline& splineYintX = getIntegralSpline();
+
     double yVal = 0;    
     if(x >= _x0 && x <= _x1){
-        yVal = _splineYintX.calcValue(SimTK::Vector(1,x));
+        yVal = splineYintX.calcValue(SimTK::Vector(1,x));
     }else{
         //LINEAR EXTRAPOLATION         
         if(x < _x0){
             SimTK::Vector tmp(1);
             tmp(0) = _x0;
-            double ic = _splineYintX.calcValue(tmp);
+            double ic = splineYintX.calcValue(tmp);
             if(_intx0x1){//Integrating left to right
                 yVal = _y0*(x-_x0) 
                     + _dydx0*(x-_x0)*(x-_x0)*0.5 
@@ -370,7 +653,7 @@ double SmoothSegmentedFunction::calcIntegral(double x) const
         }else{
             SimTK::Vector tmp(1);
             tmp(0) = _x1;
-            double ic = _splineYintX.calcValue(tmp);
+            double ic = splineYintX.calcValue(tmp);
             if(_intx0x1){
                 yVal = _y1*(x-_x1) 
                     + _dydx1*(x-_x1)*(x-_x1)*0.5 
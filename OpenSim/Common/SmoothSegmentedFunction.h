@@ -26,6 +26,7 @@
 
 //#include "SmoothSegmentedFunctionFactory.h"
 #include "SegmentedQuinticBezierToolkit.h"
+#include <memory>
 
 namespace OpenSim { 
 
@@ -136,9 +137,9 @@ namespace OpenSim {
        @return the value of the functions integral evaluated at x
 
        The integral is approximate, though its errors are small.
-       The integral is computed by numerically integrating the function when
-       the constructor for this class is called (if computeIntegral is true) and 
-       then splining the result, thus the regions between the knot points may
+       The integral is computed by numerically integrating the function the
+       first time it is requested (if computeIntegral is true) and then 
+       splining the result, thus the regions between the knot points may
        have some error in them. A very fine mesh of points is used to create the
        spline so the errors will be small
 
@@ -256,6 +257,29 @@ namespace OpenSim {
        void printMuscleCurveToCSVFile(const std::string& path,
                                       double domainMin,
                                       double domainMax) const;
+
+       /**Curves constructed with the same definition share one set of fitted
+       splines, and the integral of a curve is computed once for all of them.
+       @return The number of distinct curve definitions in use in this 
+               process.*/
+       static int getNumSharedCurves();
+
+       /**Sets the directory where the fitted splines of each curve are saved
+       to binary cache files, named by a hash of the curve definition. A curve
+       constructed with the same definition in a later run reads its splines
+       from the file instead of fitting them and computing its integral again.
+       An empty directory, the default, turns the cache files off. Files that
+       cannot be written are silently skipped.
+
+       @param directory The (existing) directory of the cache files
+       */
+       static void setCacheDirectory(const std::string& directory);
+       /**@return The directory of the curve cache files, or an empty string
+                  if they are not in use.*/
+       static std::string getCacheDirectory();
+       /**@return The cache file of the fitted splines of this curve, or an
+                  empty string if cache files were off when it was fitted.*/
+       std::string getCacheFileName() const;
        
 ///@cond       
        /**
@@ -302,10 +326,14 @@ namespace OpenSim {
 
     private:
        
-        /**Array of spline fit functions X(u) for each Bezier elbow*/
-        SimTK::Array_<SimTK::Spline> _arraySplineUX;        
-        /**Spline fit of the integral of the curve y(x)*/
-        SimTK::Spline _splineYintX;
+        /**The fitted splines of a curve definition, shared by all of the 
+        curves constructed with it. Defined in SmoothSegmentedFunction.cpp*/
+        struct CurveFit;
+
+        /**The shared fit of this curve: the array of spline fit functions 
+        X(u) for each Bezier elbow and, once it has been computed, the spline
+        fit of the integral of the curve y(x)*/
+        std::shared_ptr<CurveFit> _fit;
 		
         /**Bezier X1,...,Xn control point locations. Control points are 
         stored in 6x1 vectors in the order above*/
@@ -381,8 +409,9 @@ namespace OpenSim {
                          as x0.
 
        @param computeIntegral  If this is true, the integral is numerically
-                               calculated and splined. If false, this integral
-                               is not computed, and a call to .calcIntegral will
+                               calculated and splined the first time it is
+                               requested. If false, this integral is not 
+                               available, and a call to .calcIntegral will
                                throw an exception
 
        @param intx0x1       If this is true, the integral of the curve will be
@@ -394,8 +423,8 @@ namespace OpenSim {
        @param name          The name of the data this SmoothSegmentedFunction 
 
        <B>Computational Costs</B>
-       Generating the integral curve is not cheap, and so should only be used 
-       when if it will be evaluated during a simulation. 
+       Generating the integral curve is not cheap, and so is only done when
+       the integral is first evaluated. 
        \verbatim     
         Computatonal Cost Per Bezier Section:
             Without Integral :   4,100 flops
@@ -407,6 +436,18 @@ namespace OpenSim {
           double x0, double x1,double y0, double y1,double dydx0, double dydx1,
           bool computeIntegral, bool intx0x1, const std::string& name); 
 
+       /**Returns the shared fit of the curve definition given to the 
+       constructor, fitting the splines (or reading them from a cache file)
+       if no other curve uses the same definition.*/
+       static std::shared_ptr<CurveFit> findCurveFit(
+          const SimTK::Matrix& mX, const SimTK::Matrix& mY, 
+          double x0, double x1,double y0, double y1,double dydx0, double dydx1,
+          bool intx0x1);
+
+       /**Returns the spline fit of the integral of the curve, computing it
+       the first time it is requested.*/
+       const SimTK::Spline& getIntegralSpline() const;
+
         /**
         This function will print cvs file of the column vector col0 and the 
         matrix data
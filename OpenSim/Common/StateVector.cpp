@@ -548,35 +548,57 @@ print(FILE *fp) const
 		return(-1);
 	}
 
-	// TIME
-	char format[IO_STRLEN];
-	sprintf(format,"%s",IO::GetDoubleOutputFormat());
-	int n=0,nTotal=0;
-	n = fprintf(fp,format,_t);
-	if(n<0) {
+	// FORMAT AND WRITE THE ROW IN ONE CALL
+	string row;
+	int nTotal = format(row);
+	if(fwrite(row.data(),1,row.size(),fp)!=row.size()) {
 		printf("StateVector.print(FILE*): error writing to file.\n");
-		return(n);
+		return(-1);
 	}
-	nTotal += n;
+
+	return(nTotal);
+}
+//_____________________________________________________________________________
+/**
+ * Append the contents of this StateVector, formatted as print() writes them
+ * (time, tab-separated states, and a newline), to a string.  Filling one
+ * string per row, or per block of rows, avoids a formatted write to the
+ * file for every value.
+ *
+ * @param rBuffer String to which the row is appended.
+ * @return Number of characters appended.
+ */
+int StateVector::
+format(string &rBuffer) const
+{
+	return(format(rBuffer,IO::GetOutputFormat()));
+}
+//_____________________________________________________________________________
+/**
+ * Append the contents of this StateVector to a string using the output
+ * format aFormat rather than the current one.
+ *
+ * @param rBuffer String to which the row is appended.
+ * @param aFormat Output format, as returned by IO::GetOutputFormat().
+ * @return Number of characters appended.
+ */
+int StateVector::
+format(string &rBuffer,const IO::OutputFormat &aFormat) const
+{
+	size_t start = rBuffer.size();
+	char value[IO_STRLEN];
+
+	// TIME
+	rBuffer.append(value,IO::FormatDouble(_t,value,IO_STRLEN,aFormat));
 
 	// STATES
-	sprintf(format,"\t%s",IO::GetDoubleOutputFormat());
 	for(int i=0;i<_data.getSize();i++) {
-		n = fprintf(fp,format,_data[i]);
-		if(n<0) {
-			printf("StateVector.print(FILE*): error writing to file.\n");
-			return(n);
-		}
-		nTotal += n;
+		rBuffer += '\t';
+		rBuffer.append(value,IO::FormatDouble(_data[i],value,IO_STRLEN,aFormat));
 	}
 
 	// CARRIAGE RETURN
-	n = fprintf(fp,"\n");
-	if(n<0) {
-		printf("StateVector.print(FILE*): error writing to file.\n");
-		return(n);
-	}
-	nTotal += n;
+	rBuffer += '\n';
 
-	return(nTotal);
+	return((int)(rBuffer.size()-start));
 }
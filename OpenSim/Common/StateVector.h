@@ -30,6 +30,8 @@
 
 #include "osimCommonDLL.h"
 #include "Array.h"
+#include "IO.h"
+#include <string>
 
 
 //template class OSIMCOMMON_API Array<double>;
@@ -132,6 +134,8 @@ public:
 	//--------------------------------------------------------------------------
 #ifndef SWIG
 	int print(FILE *fp) const;
+	int format(std::string &rBuffer) const;
+	int format(std::string &rBuffer,const IO::OutputFormat &aFormat) const;
 #endif
 
 //=============================================================================
@@ -183,3 +183,28 @@ SimTK::Function* StepFunction::createSimTKFunction() const
 {
 	return new SimTK::Function::Step(_startValue, _endValue, _startTime, _endTime);
 }
+
+// Same smooth step as SimTK::Function::Step, evaluated without a Vector.
+double StepFunction::calcValue(double x) const
+{
+	const double t = (x - _startTime)/(_endTime - _startTime);
+	if (t <= 0) return _startValue;
+	if (t >= 1) return _endValue;
+	return _startValue + (_endValue - _startValue)*SimTK::stepUp(t);
+}
+
+double StepFunction::calcDerivative(double x, int order) const
+{
+	if (order == 0)
+		return calcValue(x);
+	const double ooxr = 1.0/(_endTime - _startTime);
+	const double t = (x - _startTime)*ooxr;
+	if (t <= 0 || t >= 1) return 0.0;
+	const double yr = _endValue - _startValue;
+	switch (order) {
+		case 1: return yr*SimTK::dstepUp(t)*ooxr;
+		case 2: return yr*SimTK::d2stepUp(t)*ooxr*ooxr;
+		case 3: return yr*SimTK::d3stepUp(t)*ooxr*ooxr*ooxr;
+		default: return Function::calcDerivative(x, order);
+	}
+}
@@ -126,6 +126,10 @@ public:
 	// EVALUATION
 	//--------------------------------------------------------------------------
     virtual SimTK::Function* createSimTKFunction() const;
+    using Function::calcValue;
+    using Function::calcDerivative;
+    virtual double calcValue(double x) const;
+    virtual double calcDerivative(double x, int order) const;
 
 //=============================================================================
 };	// END class StepFunction
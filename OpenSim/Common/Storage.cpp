@@ -28,8 +28,15 @@
 
 // INCLUDES
 #include "osimCommonDLL.h"
+#include <cstdio>
 #include <sstream>
 #include <iostream>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <exception>
 #include "IO.h"
 #include "Signal.h"
 #include "Storage.h"
@@ -82,6 +89,7 @@ const int Storage::LatestVersion = 1;
  */
 Storage::~Storage()
 {
+	closeOutputFile();
 }
 
 //=============================================================================
@@ -314,6 +322,12 @@ setNull()
 	_stepInterval = 1;
 	_lastI = 0;
 	_fp = 0;
+	_streamIndex = 0;
+	_numRowsWritten = 0;
+	_numColumnsWritten = 0;
+	_numRowsDropped = 0;
+	_streamHeaderOffset = -1;
+	_maxRowsInMemory = -1;
 	_inDegrees = false;
 }
 //_____________________________________________________________________________
@@ -1256,6 +1270,8 @@ reset(int aIndex)
 	if(aIndex>=_storage.getSize()) return(_storage.getSize());
 	if(aIndex<0) aIndex = 0;
 	_storage.setSize(aIndex);
+	// Rows already streamed to file cannot be taken back.
+	if(_streamIndex>aIndex) _streamIndex = aIndex;
 
 	return(_storage.getSize());
 }
@@ -1322,10 +1338,8 @@ append(const StateVector &aStateVector,bool aCheckForDuplicateTime)
 	else
 		_storage.append(aStateVector);
 
-	if (_fp!=0){
-		aStateVector.print(_fp);
-		fflush(_fp);
-	}
+	// STREAM ALL BUT THE LAST ROW, WHICH MAY STILL BE REPLACED
+	if(_fp!=NULL) writeStreamRows(_storage.getSize()-1);
 	return(_storage.getSize());
 }
 //_____________________________________________________________________________
@@ -1343,6 +1357,7 @@ append(const Array<StateVector> &aStorage)
 {
 	for(int i=0; i<aStorage.getSize(); i++)
 		_storage.append(aStorage[i]);
+	if(_fp!=NULL) writeStreamRows(_storage.getSize()-1);
 	return(_storage.getSize());
 }
 //_____________________________________________________________________________
@@ -2567,24 +2582,105 @@ void Storage::interpolateAt(const Array<double> &targetTimes)
 //_____________________________________________________________________________
 /**
  * Set name of output file to be written into.
- * This has the side effect of openning the file for writing. The header will not have the correct
- * number of rows but this may not be an issue for ersion 2 of the Storage class
+ * This has the side effect of openning the file for writing.  Rows are then
+ * streamed to the file as they are appended, through a large stdio buffer,
+ * and the header is completed with the correct number of rows and columns
+ * when the file is closed (see closeOutputFile()).  The file reads back the
+ * same as one written by print(), but it is not byte-identical: the row and
+ * column counts in its header are padded with spaces so that they can be
+ * completed in place.
+ *
+ * If a maximum number of rows in memory has been set (see
+ * setMaxRowsInMemory()), rows that have already been written are released
+ * from memory so that arbitrarily long simulations can be recorded.
  */
 void Storage::
 setOutputFileName(const std::string& aFileName)
 {
-	assert(_fileName=="");
+	assert(_fp==NULL);
 	_fileName = aFileName;
 
 	// OPEN THE FILE
 	_fp = IO::OpenFile(aFileName,"w");
 	if(_fp==NULL) throw(Exception("Could not open file "+aFileName));
-	// WRITE THE HEADER
-	int n=0,nTotal=0;
-	n = writeHeader(_fp);
-	n = writeDescription(_fp);
-	// WRITE THE COLUMN LABELS
-	n = writeColumnLabels(_fp);
+	setvbuf(_fp,NULL,_IOFBF,1<<16);
+
+	// ROWS ALREADY IN MEMORY ARE WRITTEN WITH THE NEXT APPEND
+	_streamIndex = 0;
+	_numRowsWritten = 0;
+	_numColumnsWritten = 0;
+	_numRowsDropped = 0;
+	_streamHeaderOffset = -1;
+}
+//_____________________________________________________________________________
+/**
+ * Write any rows not yet streamed, complete the header of the output file
+ * and close it.  Does nothing if no output file is open.
+ */
+void Storage::
+closeOutputFile()
+{
+	if(_fp==NULL) return;
+
+	writeStreamRows(_storage.getSize());
+	if(_streamHeaderOffset<0) writeStreamHeader();
+
+	// PATCH THE ROW AND COLUMN COUNTS
+	fseek(_fp,_streamHeaderOffset,SEEK_SET);
+	fprintf(_fp,"nRows=%-10d\nnColumns=%-10d\n",_numRowsWritten,
+		_numColumnsWritten);
+
+	fclose(_fp);
+	_fp = NULL;
+}
+//_____________________________________________________________________________
+/**
+ * Write the header of a streamed file.  The row and column counts are not
+ * known yet, so they are padded to leave room for closeOutputFile() to
+ * overwrite them in place.
+ */
+void Storage::
+writeStreamHeader()
+{
+	fprintf(_fp,"%s\n",getName().c_str());
+	fprintf(_fp,"version=%d\n",LatestVersion);
+	_streamHeaderOffset = ftell(_fp);
+	fprintf(_fp,"nRows=%-10d\nnColumns=%-10d\n",0,0);
+	fprintf(_fp,"inDegrees=%s\n",(_inDegrees?"yes":"no"));
+	writeDescription(_fp);
+	writeColumnLabels(_fp);
+}
+//_____________________________________________________________________________
+/**
+ * Write rows up to (but not including) aEnd to the output file, and release
+ * written rows from memory if the storage holds more than twice the maximum
+ * number of rows allowed in memory.
+ */
+void Storage::
+writeStreamRows(int aEnd)
+{
+	if(_streamIndex>=aEnd) return;
+	if(_streamHeaderOffset<0) writeStreamHeader();
+
+	for(;_streamIndex<aEnd;_streamIndex++) {
+		const StateVector& vec = _storage[_streamIndex];
+		vec.print(_fp);
+		int nc = vec.getSize()+1;
+		if(_numRowsWritten==0 || nc<_numColumnsWritten) _numColumnsWritten = nc;
+		_numRowsWritten++;
+	}
+
+	// RELEASE WRITTEN ROWS, KEEPING THE MOST RECENT _maxRowsInMemory
+	int size = _storage.getSize();
+	if(_maxRowsInMemory<=0 || size<2*_maxRowsInMemory) return;
+	int nDrop = size - _maxRowsInMemory;
+	if(nDrop>_streamIndex) nDrop = _streamIndex;
+	for(int i=0;i<size-nDrop;i++)
+		_storage[i] = _storage[nDrop+i];
+	_storage.setSize(size-nDrop);
+	_streamIndex -= nDrop;
+	_numRowsDropped += nDrop;
+	_lastI = 0;
 }
 //_____________________________________________________________________________
 /**
@@ -2606,6 +2702,26 @@ setOutputFileName(const std::string& aFileName)
 bool Storage::
 print(const string &aFileName,const string &aMode, const string& aComment) const
 {
+	return(writeFile(aFileName,aMode,aComment,IO::GetOutputFormat()));
+}
+//_____________________________________________________________________________
+/**
+ * Print the contents of this storage instance to a file, formatting numbers
+ * with aFormat rather than the current output format.
+ *
+ * @see print(const string&,const string&,const string&)
+ */
+bool Storage::
+writeFile(const string &aFileName,const string &aMode,const string& aComment,
+	const IO::OutputFormat &aFormat) const
+{
+	// PRINTING TO THE FILE BEING STREAMED COMPLETES IT; IF ROWS HAVE BEEN
+	// RELEASED FROM MEMORY THE STREAMED FILE IS THE ONLY COMPLETE COPY
+	if(_fp!=NULL && aFileName==_fileName) {
+		const_cast<Storage*>(this)->closeOutputFile();
+		if(_numRowsDropped>0) return(true);
+	}
+
 	// OPEN THE FILE
 	FILE *fp = IO::OpenFile(aFileName,aMode);
 	if(fp==NULL) return(false);
@@ -2649,13 +2765,11 @@ print(const string &aFileName,const string &aMode, const string& aComment) const
 //std::cout << aFileName << endl;
 
 	// VECTORS
-	for(int i=0;i<_storage.getSize();i++) {
-		n = getStateVector(i)->print(fp);
-		if(n<0) {
-			cout << "Storage.print(const string&,const string&): error printing to " << aFileName;
-			return(false);
-		}
-		nTotal += n;		
+	nTotal = writeRows(fp,aFormat);
+	if(nTotal<0) {
+		cout << "Storage.print(const string&,const string&): error printing to " << aFileName;
+		fclose(fp);
+		return(false);
 	}
 
 	// CLOSE
@@ -2679,11 +2793,24 @@ print(const string &aFileName,const string &aMode, const string& aComment) const
  */
 int Storage::
 print(const string &aFileName,double aDT,const string &aMode) const
+{
+	return(writeFile(aFileName,aDT,aMode,IO::GetOutputFormat()));
+}
+//_____________________________________________________________________________
+/**
+ * Print the contents of this storage instance using uniform time spacing,
+ * formatting numbers with aFormat rather than the current output format.
+ *
+ * @see print(const string&,double,const string&)
+ */
+int Storage::
+writeFile(const string &aFileName,double aDT,const string &aMode,
+	const IO::OutputFormat &aFormat) const
 {
 	// CHECK FOR VALID DT
 	if(aDT<=0) return(0);
 
-	if (_fp!= NULL) fclose(_fp);
+	const_cast<Storage*>(this)->closeOutputFile();
 	// OPEN THE FILE
 	FILE *fp = IO::OpenFile(aFileName,aMode);
 	if(fp==NULL) return(-1);
@@ -2734,6 +2861,7 @@ print(const string &aFileName,double aDT,const string &aMode) const
 	int i,ny=0;
 	double t,*y=NULL;
 	StateVector vec;
+	string row;
 	for(t=ti,i=0;i<nr;i++,t=ti+aDT*(double)i) {
 
 		// INTERPOLATE THE STATES
@@ -2741,10 +2869,11 @@ print(const string &aFileName,double aDT,const string &aMode) const
 		vec.setStates(t,ny,y);
 
 		// PRINT
-		n = vec.print(fp);
-		if(n<0) {
+		row.clear();
+		n = vec.format(row,aFormat);
+		if(fwrite(row.data(),1,row.size(),fp)!=row.size()) {
 			cout << "Storage.print(const string&,const string&): error printing to " << aFileName;
-			return(n);
+			return(-1);
 		}
 		nTotal += n;		
 	}
@@ -2756,6 +2885,151 @@ print(const string &aFileName,double aDT,const string &aMode) const
 	return(nTotal);
 }
 
+//_____________________________________________________________________________
+/*
+ * Task that formats one block of rows per index into its own buffer.
+ */
+class FormatRowsTask : public SimTK::ParallelExecutor::Task {
+public:
+	FormatRowsTask(const Array<StateVector>& rows, int rowsPerBlock,
+		const IO::OutputFormat& format, std::vector<std::string>& buffers) :
+		_rows(rows), _first(0), _rowsPerBlock(rowsPerBlock), _format(format),
+		_buffers(buffers) {}
+
+	void setFirstRow(int first) { _first = first; }
+
+	void execute(int index) {
+		std::string& buffer = _buffers[index];
+		buffer.clear();
+		int begin = _first + index*_rowsPerBlock;
+		int end = begin + _rowsPerBlock;
+		if(end>_rows.getSize()) end = _rows.getSize();
+		for(int i=begin;i<end;i++) _rows[i].format(buffer,_format);
+	}
+private:
+	const Array<StateVector>& _rows;
+	int _first;
+	int _rowsPerBlock;
+	const IO::OutputFormat& _format;
+	std::vector<std::string>& _buffers;
+};
+//_____________________________________________________________________________
+/**
+ * Write all rows to a file.  Rows are formatted in blocks, several blocks
+ * at a time on separate threads when there are many rows, and each block is
+ * written with a single call.
+ *
+ * @param rFP File pointer.
+ * @param aFormat Output format for the numbers.
+ * @return Number of characters written, or -1 on error.
+ */
+int Storage::
+writeRows(FILE *rFP,const IO::OutputFormat &aFormat) const
+{
+	if(rFP==NULL) return(-1);
+
+	const int rowsPerBlock = 512;
+	int nRows = _storage.getSize();
+	int nBlocks = (nRows + rowsPerBlock - 1)/rowsPerBlock;
+	int nThreads = SimTK::ParallelExecutor::getNumProcessors();
+	if(nThreads>nBlocks) nThreads = nBlocks;
+
+	std::vector<std::string> buffers(nThreads>1 ? nThreads : 1);
+	std::unique_ptr<SimTK::ParallelExecutor> executor;
+	if(nThreads>1) executor.reset(new SimTK::ParallelExecutor(nThreads));
+	FormatRowsTask task(_storage,rowsPerBlock,aFormat,buffers);
+	int nTotal = 0;
+	for(int first=0;first<nRows;first+=(int)buffers.size()*rowsPerBlock) {
+		int n = (nRows-first+rowsPerBlock-1)/rowsPerBlock;
+		if(n>(int)buffers.size()) n = (int)buffers.size();
+		task.setFirstRow(first);
+		if(n>1) {
+			executor->execute(task,n);
+		} else {
+			task.execute(0);
+		}
+		for(int b=0;b<n;b++) {
+			if(fwrite(buffers[b].data(),1,buffers[b].size(),rFP)!=buffers[b].size())
+				return(-1);
+			nTotal += (int)buffers[b].size();
+		}
+	}
+
+	return(nTotal);
+}
+
+//=============================================================================
+// BACKGROUND PRINTING
+//=============================================================================
+// Threads writing copies of storages for printResult().  An error in one of
+// them is kept and rethrown by the next wait().  Threads still running at
+// exit are joined when the registry is destroyed.
+class BackgroundPrints {
+public:
+	~BackgroundPrints() {
+		try {
+			wait();
+		} catch(const std::exception &x) {
+			cout << "Storage: ERROR- background print failed: " << x.what() << endl;
+		}
+	}
+	void add(std::thread* aThread) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		_threads.push_back(aThread);
+	}
+	void fail(std::exception_ptr aError) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		if(!_error) _error = aError;
+	}
+	void wait() {
+		std::vector<std::thread*> threads;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			threads.swap(_threads);
+		}
+		for(size_t i=0;i<threads.size();i++) {
+			threads[i]->join();
+			delete threads[i];
+		}
+		std::exception_ptr error;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			std::swap(error,_error);
+		}
+		if(error) std::rethrow_exception(error);
+	}
+private:
+	std::mutex _mutex;
+	std::vector<std::thread*> _threads;
+	std::exception_ptr _error;
+};
+
+static std::atomic<bool> printInBackground(false);
+
+static BackgroundPrints& getBackgroundPrints()
+{
+	static BackgroundPrints prints;
+	return prints;
+}
+
+void Storage::
+setPrintInBackground(bool aTrueFalse)
+{
+	printInBackground = aTrueFalse;
+}
+
+bool Storage::
+getPrintInBackground()
+{
+	return(printInBackground);
+}
+
+void Storage::
+waitForBackgroundPrints()
+{
+	getBackgroundPrints().wait();
+}
+
 void Storage::
 printResult(const Storage *aStorage,const std::string &aName,
 				const std::string &aDir,double aDT,const std::string &aExtension)
@@ -2763,6 +3037,45 @@ printResult(const Storage *aStorage,const std::string &aName,
 	if(!aStorage) return;
 	std::string path = (aDir=="") ? "." : aDir;
 	std::string name = (aName.rfind(aExtension)==string::npos)? (path + "/" + aName + aExtension) :  (path + "/" + aName);
+
+	// A STREAMED STORAGE IS COMPLETED AND MOVED INTO PLACE
+	if(aStorage->isStreaming() && aStorage->getOutputFileName()!=name) {
+		Storage *store = const_cast<Storage*>(aStorage);
+		std::string streamFile = store->getOutputFileName();
+		store->closeOutputFile();
+		if(store->_numRowsDropped>0) {
+			if(aDT>0.0)
+				cout << "Storage.printResult: WARNING: rows of " << name << " were released"
+					 << " from memory while streaming; printing them without resampling." << endl;
+			if(IO::renameFile(streamFile,name)==0) return;
+			// THE STREAMED FILE IS THE ONLY COMPLETE COPY, SO IT IS KEPT
+			throw Exception("Storage.printResult: could not move "+streamFile+
+				" to "+name+". The results are in "+streamFile+".",
+				__FILE__,__LINE__);
+		}
+		// EVERYTHING IS STILL IN MEMORY, SO PRINT AS USUAL
+		std::remove(streamFile.c_str());
+	}
+
+	// WRITE A COPY ON ANOTHER THREAD, IN THE OUTPUT FORMAT OF NOW
+	if(printInBackground) {
+		std::shared_ptr<Storage> copy(new Storage(*aStorage));
+		copy->_writeSIMMHeader = aStorage->_writeSIMMHeader;
+		copy->_keyValueMap = aStorage->_keyValueMap;
+		IO::OutputFormat format = IO::GetOutputFormat();
+		getBackgroundPrints().add(new std::thread([copy,name,aDT,format]() {
+			try {
+				bool ok = (aDT<=0.0) ? copy->writeFile(name,"w","",format) :
+					copy->writeFile(name,aDT,"w",format)>=0;
+				if(!ok) throw Exception("Storage.printResult: could not write "+
+					name+".",__FILE__,__LINE__);
+			} catch(...) {
+				getBackgroundPrints().fail(std::current_exception());
+			}
+		}));
+		return;
+	}
+
 	if(aDT<=0.0) aStorage->print(name);
 	else aStorage->print(name,aDT);
 }
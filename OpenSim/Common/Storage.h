@@ -99,6 +99,22 @@ protected:
 	/** Cache for fileName and file pointer when the file is opened so we can flush and write intermediate files if needed */
 	std::string _fileName;
 	FILE *_fp;
+	/** Index of the first row in memory that has not yet been written to
+	_fp.  The last row is held back so that duplicate-time appends can still
+	replace it. */
+	int _streamIndex;
+	/** Number of rows written to _fp and smallest number of columns among
+	them; patched into the header when the file is closed. */
+	int _numRowsWritten;
+	int _numColumnsWritten;
+	/** Number of streamed rows released from memory. */
+	int _numRowsDropped;
+	/** File offset of the nRows field in the streamed header (-1 if the
+	header has not been written yet). */
+	long _streamHeaderOffset;
+	/** Maximum number of rows kept in memory while streaming (<=0 keeps
+	all rows). */
+	int _maxRowsInMemory;
 	/** Name and Description */
 	std::string _name;
 	std::string _description;
@@ -298,15 +314,37 @@ public:
 	bool print(const std::string &aFileName,const std::string &aMode="w", const std::string& aComment="") const;
 	int print(const std::string &aFileName,double aDT,const std::string &aMode="w") const;
 	void setOutputFileName(const std::string& aFileName) ;
-	// convenience function for Analyses and DerivCallbacks
+	const std::string& getOutputFileName() const { return _fileName; }
+	bool isStreaming() const { return _fp!=NULL; }
+	void setMaxRowsInMemory(int aMaxRows) { _maxRowsInMemory = aMaxRows; }
+	int getMaxRowsInMemory() const { return _maxRowsInMemory; }
+	void closeOutputFile();
+	// convenience function for Analyses and DerivCallbacks. A streamed 
+	// storage is moved into place; if that fails an Exception is thrown and
+	// the streamed file, which holds the results, is kept.
 	static void printResult(const Storage *aStorage,const std::string &aName,
 		const std::string &aDir,double aDT,const std::string &aExtension);
+	/** When on, printResult() copies the storage and writes the copy on a
+	background thread, so the caller continues while the file is written.
+	Call waitForBackgroundPrints() before reading such files; it rethrows
+	the first error of the background writes.  Pending files are also
+	completed when the program exits.  The default is off. */
+	static void setPrintInBackground(bool aTrueFalse);
+	static bool getPrintInBackground();
+	static void waitForBackgroundPrints();
     void interpolateAt(const Array<double> &targetTimes);
 private:
 	int writeHeader(FILE *rFP,double aDT=-1) const;
 	int writeSIMMHeader(FILE *rFP,double aDT=-1, const char*aComment=0) const;
 	int writeDescription(FILE *rFP) const;
 	int writeColumnLabels(FILE *rFP) const;
+	int writeRows(FILE *rFP,const IO::OutputFormat &aFormat) const;
+	bool writeFile(const std::string &aFileName,const std::string &aMode,
+		const std::string &aComment,const IO::OutputFormat &aFormat) const;
+	int writeFile(const std::string &aFileName,double aDT,
+		const std::string &aMode,const IO::OutputFormat &aFormat) const;
+	void writeStreamHeader();
+	void writeStreamRows(int aEnd);
 	int integrate(double aTI,double aTF,int aN,double *rArea,Storage *rStorage) const;
 	int integrate(int aI1,int aI2,int aN,double *rArea,Storage *rStorage) const;
 
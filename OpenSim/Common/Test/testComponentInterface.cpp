@@ -160,6 +160,9 @@ public:
 			.getBodyAcceleration(state);
 	}
 
+	/** Number of times any of the output functions has been evaluated. */
+	int getNumOutputEvaluations() const { return m_mutableCtr; }
+
 protected:
 	/** Component Interface */
 	void connect(Component& root) override {
@@ -221,9 +224,13 @@ private:
 			std::bind([=](const SimTK::State& s)->Vector{return s.getQ(); }, std::placeholders::_1),
 			SimTK::Stage::Position);
 
+		constructOutput<Vector>("Us",
+			std::bind([=](const SimTK::State& s)->Vector{return s.getU(); }, std::placeholders::_1),
+			SimTK::Stage::Velocity);
+
 		constructOutput<SpatialVec>("BodyAcc",
 			std::bind(&Foo::calcSpatialAcc, this, std::placeholders::_1),
-			SimTK::Stage::Velocity);
+			SimTK::Stage::Acceleration);
 	}
 
 	// Keep indices and reference to the world
@@ -247,6 +254,12 @@ public:
 		return spring.calcPotentialEnergyContribution(state);
 	}
 
+	// Like a muscle's fiber length, which may be a state variable but is
+	// available at Position.
+	double getFiberLengthAtPosition(const SimTK::State& state) const {
+		return getStateVariable(state, "fiberLength");
+	}
+
 protected:
 	/** Component Interface */
 	void connect(Component& root) override{
@@ -309,6 +322,8 @@ private:
 		constructOutput<double>("PotentialEnergy",
 		std::bind(&Bar::getPotentialEnergy, this, std::placeholders::_1),
 		SimTK::Stage::Velocity);
+		constructOutput<double>("FiberLengthAtPosition",
+			&Bar::getFiberLengthAtPosition, SimTK::Stage::Position, false);
 	}
 
 	// keep track of the force added by the component
@@ -463,9 +478,20 @@ int main() {
 			const AbstractOutput& out4 = foo.getOutput("BodyAcc");
 			const AbstractOutput& out5 = bar.getOutput("PotentialEnergy");
 
+			int nEvals = foo.getNumOutputEvaluations();
 			cout << "=========================[Time " << s.getTime() << "s]======================="<<endl;
 			cout << out1.getName() <<"|"<< out1.getTypeName() <<"|"<< out1.getValueAsString(s) << endl;
 			cout << out2.getName() <<"|"<< out2.getTypeName() <<"|"<< out2.getValueAsString(s) << endl;
+
+			// Output values are cached in the state, so reading them again
+			// must not call the output functions again.
+			ASSERT(foo.getNumOutputEvaluations() == nEvals+2, __FILE__, __LINE__,
+				"Outputs were not evaluated once each.");
+			ASSERT_EQUAL(s.getTime(), foo.getOutputValue<double>(s, "Output1"),
+				1e-15, __FILE__, __LINE__, "Cached Output1 value is wrong.");
+			foo.getOutputValue<SimTK::Vec3>(s, "Output2");
+			ASSERT(foo.getNumOutputEvaluations() == nEvals+2, __FILE__, __LINE__,
+				"Cached outputs were re-evaluated.");
 			cout << out3.getName() <<"|"<< out3.getTypeName() <<"|"<< out3.getValueAsString(s) << endl;
 			
 			system.realize(s, Stage::Acceleration);
@@ -478,6 +504,23 @@ int main() {
 			cout << "foo.input1 = " << foo.getInputValue<double>(s, "input1") << endl;
 		}
 
+		// Changing q or u between two reads must change the cached values.
+		s.updU() = u;
+		system.realize(s, Stage::Velocity);
+		Vector qBefore = foo.getOutputValue<Vector>(s, "Qs");
+		Vector uBefore = foo.getOutputValue<Vector>(s, "Us");
+		s.updQ() += 0.1;
+		s.updU() *= 2.0;
+		system.realize(s, Stage::Velocity);
+		Vector qAfter = foo.getOutputValue<Vector>(s, "Qs");
+		Vector uAfter = foo.getOutputValue<Vector>(s, "Us");
+		for (int i = 0; i < s.getNQ(); ++i)
+			ASSERT_EQUAL(qBefore[i]+0.1, qAfter[i], 1e-15, __FILE__, __LINE__,
+				"Cached Qs output was not updated after q changed.");
+		for (int i = 0; i < s.getNU(); ++i)
+			ASSERT_EQUAL(2.0*uBefore[i], uAfter[i], 1e-15, __FILE__, __LINE__,
+				"Cached Us output was not updated after u changed.");
+
 		MultibodySystem system2;
 		TheWorld *world2 = new TheWorld(modelFile);
 		
@@ -556,6 +599,21 @@ int main() {
 		// realize simbody system to velocity stage
 		system3.realize(s, Stage::Velocity);
 
+		// State variable outputs are not cached, so they follow the state,
+		// and neither are outputs constructed as not cacheable.
+		ASSERT(!bar.getOutput("FiberLengthAtPosition").isCacheable(),
+			__FILE__, __LINE__, "FiberLengthAtPosition output is cacheable.");
+		ASSERT_EQUAL(1.5, bar.getOutputValue<double>(s, "fiberLength"), 1e-15);
+		ASSERT_EQUAL(1.5,
+			bar.getOutputValue<double>(s, "FiberLengthAtPosition"), 1e-15);
+		bar.setStateVariable(s, "fiberLength", 2.5);
+		system3.realize(s, Stage::Velocity);
+		ASSERT_EQUAL(2.5, bar.getOutputValue<double>(s, "fiberLength"), 1e-15);
+		ASSERT_EQUAL(2.5,
+			bar.getOutputValue<double>(s, "FiberLengthAtPosition"), 1e-15);
+		bar.setStateVariable(s, "fiberLength", 1.5);
+		system3.realize(s, Stage::Velocity);
+
 		RungeKuttaFeldbergIntegrator integ(system3);
 		integ.setAccuracy(1.0e-3);
 
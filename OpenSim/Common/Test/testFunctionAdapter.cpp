@@ -21,11 +21,36 @@
  * -------------------------------------------------------------------------- */
 
 #include <OpenSim/Common/PiecewiseLinearFunction.h>
+#include <OpenSim/Common/PiecewiseConstantFunction.h>
+#include <OpenSim/Common/SimmSpline.h>
+#include <OpenSim/Common/GCVSpline.h>
+#include <OpenSim/Common/LinearFunction.h>
+#include <OpenSim/Common/StepFunction.h>
+#include <OpenSim/Common/Constant.h>
+#include <OpenSim/Common/Sine.h>
+#include <OpenSim/Common/PolynomialFunction.h>
+#include <OpenSim/Common/MultiplierFunction.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 
 using namespace OpenSim;
 using namespace std;
 
+// The scalar calcValue(double) and calcDerivative(double, int) of a function
+// of one variable must agree with its Vector versions.
+void testScalarEvaluation(const Function& f, int maxOrder)
+{
+    SimTK::Vector xvec(1);
+    for (int i = 0; i < 100; ++i) {
+        xvec[0] = -0.5 + i*0.11;
+        ASSERT_EQUAL(f.calcValue(xvec), f.calcValue(xvec[0]), 1e-10, __FILE__, __LINE__);
+        ASSERT_EQUAL(f.calcValue(xvec), f.calcDerivative(xvec[0], 0), 1e-10, __FILE__, __LINE__);
+        for (int order = 1; order <= maxOrder; ++order) {
+            vector<int> deriv(order, 0);
+            ASSERT_EQUAL(f.calcDerivative(deriv, xvec), f.calcDerivative(xvec[0], order), 1e-8, __FILE__, __LINE__);
+        }
+    }
+}
+
 int main() {
     try {
         double x[] = {0.0, 1.0, 2.0, 2.5, 5.0, 10.0};
@@ -43,6 +68,21 @@ int main() {
             ASSERT_EQUAL(f1.calcDerivative(deriv,xvec), f2.calcDerivative(deriv,xvec), 1e-10, __FILE__, __LINE__);
         }
         ASSERT(adapter.getArgumentSize() == 1, __FILE__, __LINE__);
+
+        double xs[] = {0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0};
+        double ys[] = {0.0, 0.8, 0.9, 0.1, -0.8, -1.0, -0.3, 0.7, 1.0, 0.4};
+        SimTK::Vector coefficients(4);
+        coefficients[0] = 0.5; coefficients[1] = -2.0; coefficients[2] = 1.0; coefficients[3] = 3.0;
+        testScalarEvaluation(f1, 1);
+        testScalarEvaluation(PiecewiseConstantFunction(6, x, y), 1);
+        testScalarEvaluation(SimmSpline(10, xs, ys), 2);
+        testScalarEvaluation(GCVSpline(5, 10, xs, ys), 3);
+        testScalarEvaluation(LinearFunction(2.5, -1.0), 2);
+        testScalarEvaluation(StepFunction(1.0, 3.0, -1.0, 2.0), 3);
+        testScalarEvaluation(Constant(1.5), 2);
+        testScalarEvaluation(Sine(2.0, 3.0, 0.5), 3);
+        testScalarEvaluation(PolynomialFunction(coefficients), 4);
+        testScalarEvaluation(MultiplierFunction(new SimmSpline(10, xs, ys), 2.0), 2);
     }
     catch (const Exception& e) {
         e.print(cerr);
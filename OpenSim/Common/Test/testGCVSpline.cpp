@@ -21,11 +21,61 @@
  * -------------------------------------------------------------------------- */
 
 #include <OpenSim/Common/GCVSpline.h>
+#include <OpenSim/Common/GCVSplineSet.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 
 using namespace OpenSim;
 using namespace std;
 
+// Splines fit in parallel by a GCVSplineSet, or taken from the fit cache,
+// must equal splines fit one at a time without the cache.
+void testSplineSet()
+{
+    const int size = 200, ncols = 6;
+    Storage store;
+    Array<string> labels;
+    labels.append("time");
+    for (int c = 0; c < ncols; ++c)
+        labels.append(string(1, (char)('a'+c)));
+    store.setColumnLabels(labels);
+    double row[ncols];
+    for (int i = 0; i < size; ++i) {
+        for (int c = 0; c < ncols; ++c)
+            row[c] = sin((c+1)*0.01*i) + 0.001*((i*(c+7))%5);
+        store.append(0.01*i, ncols, row);
+    }
+
+    GCVSpline::clearFitCache();
+    GCVSplineSet set(5, &store);
+    ASSERT(set.getSize() == ncols, __FILE__, __LINE__);
+    ASSERT(GCVSpline::getNumCachedFits() == ncols, __FILE__, __LINE__);
+
+    // A second set and copies of the splines reuse the cached fits.
+    GCVSplineSet again(5, &store);
+    GCVSpline copy(*set.getGCVSpline(0));
+    copy.calcValue(0.5);
+    ASSERT(GCVSpline::getNumCachedFits() == ncols, __FILE__, __LINE__);
+
+    GCVSpline::setUseFitCache(false);
+    double *times = NULL, *data = NULL;
+    for (int c = 0; c < ncols; ++c) {
+        store.getTimeColumn(times, c);
+        store.getDataColumn(c, data);
+        GCVSpline serial(5, size, times, data);
+        for (int i = 0; i < 10*(size-1); ++i) {
+            double t = 0.001*i;
+            for (int order = 0; order <= 2; ++order) {
+                ASSERT_EQUAL(serial.calcDerivative(t, order), set.getGCVSpline(c)->calcDerivative(t, order), 1e-12, __FILE__, __LINE__);
+                ASSERT_EQUAL(serial.calcDerivative(t, order), again.getGCVSpline(c)->calcDerivative(t, order), 1e-12, __FILE__, __LINE__);
+            }
+        }
+    }
+    ASSERT(GCVSpline::getNumCachedFits() == 0, __FILE__, __LINE__);
+    GCVSpline::setUseFitCache(true);
+    delete[] times;
+    delete[] data;
+}
+
 int main() {
     try {
         const int size = 100;
@@ -38,6 +88,7 @@ int main() {
         for (int i = 0; i < 10*(size-1); ++i) {
             ASSERT_EQUAL(sin(0.01*i), spline.calcValue(SimTK::Vector(1, 0.01*i)), 1e-4, __FILE__, __LINE__);
         }
+        testSplineSet();
     }
     catch(const Exception& e) {
         e.print(cerr);
@@ -0,0 +1,153 @@
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  testOptimizationTarget.cpp                    *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2014 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+//=============================================================================
+// testOptimizationTarget checks that the finite-difference derivatives of an
+// OptimizationTarget computed on several threads are identical to the serial
+// ones and close to the analytic derivatives.
+//=============================================================================
+#include <iostream>
+#include <math.h>
+#include <OpenSim/Common/OptimizationTarget.h>
+#include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+
+using namespace OpenSim;
+using namespace std;
+using SimTK::Vector;
+using SimTK::Matrix;
+
+// Separable objective p = sum (i+1)*x[i]^3 + sin(x[i]) with two constraints,
+// the sum and the sum of squares of the parameters.
+class ExampleTarget : public OptimizationTarget {
+public:
+	ExampleTarget(int aNX) : OptimizationTarget(aNX) {
+		setNumEqualityConstraints(2);
+		setDX(1.0e-5);
+	}
+
+	int objectiveFunc(const Vector &x, bool new_coefficients,
+		SimTK::Real &p) const override {
+		p = 0.0;
+		for(int i=0;i<x.size();i++) p += (i+1)*x[i]*x[i]*x[i] + sin(x[i]);
+		return(0);
+	}
+	int gradientFunc(const Vector &x, bool new_coefficients,
+		Vector &dpdx) const override {
+		for(int i=0;i<x.size();i++) dpdx[i] = 3*(i+1)*x[i]*x[i] + cos(x[i]);
+		return(0);
+	}
+	int constraintFunc(const Vector &x, bool new_coefficients,
+		Vector &c) const override {
+		c[0] = c[1] = 0.0;
+		for(int i=0;i<x.size();i++) { c[0] += x[i]; c[1] += x[i]*x[i]; }
+		return(0);
+	}
+	int constraintJacobian(const Vector &x, bool new_coefficients,
+		Matrix &jac) const override {
+		for(int i=0;i<x.size();i++) { jac(0,i) = 1.0; jac(1,i) = 2*x[i]; }
+		return(0);
+	}
+
+	OptimizationTarget* createDerivativeWorker() const override {
+		return new ExampleTarget(*this);
+	}
+};
+
+void testParallelDerivatives()
+{
+	const int nx = 13;
+	ExampleTarget serial(nx);
+	Vector x(nx);
+	for(int i=0;i<nx;i++) x[i] = 0.1*i - 0.5;
+
+	// The copy constructor gives a target with the same settings.
+	ExampleTarget parallel(serial);
+	parallel.setNumDerivativeThreads(4);
+	ASSERT(parallel.getNumParameters()==nx, __FILE__, __LINE__,
+		"Copied target has a different number of parameters.");
+
+	Vector exact(nx);
+	serial.gradientFunc(x, true, exact);
+	Matrix exactJac(2, nx);
+	serial.constraintJacobian(x, true, exactJac);
+
+	// Evaluate twice so that the second call reuses the workers and threads.
+	for(int k=0;k<2;k++) {
+		Vector dpdxSerial(nx), dpdxParallel(nx);
+
+		ASSERT(OptimizationTarget::CentralDifferences(&serial,
+			serial.getDXArray(), x, dpdxSerial)==0, __FILE__, __LINE__);
+		ASSERT(OptimizationTarget::CentralDifferences(&parallel,
+			parallel.getDXArray(), x, dpdxParallel)==0, __FILE__, __LINE__);
+		for(int i=0;i<nx;i++) {
+			ASSERT(dpdxSerial[i]==dpdxParallel[i], __FILE__, __LINE__,
+				"Parallel central differences differ from serial ones.");
+			ASSERT_EQUAL(exact[i], dpdxParallel[i], 1.0e-6, __FILE__, __LINE__,
+				"Central differences differ from the gradient.");
+		}
+
+		ASSERT(OptimizationTarget::ForwardDifferences(&serial,
+			serial.getDXArray(), x, dpdxSerial)==0, __FILE__, __LINE__);
+		ASSERT(OptimizationTarget::ForwardDifferences(&parallel,
+			parallel.getDXArray(), x, dpdxParallel)==0, __FILE__, __LINE__);
+		for(int i=0;i<nx;i++) {
+			ASSERT(dpdxSerial[i]==dpdxParallel[i], __FILE__, __LINE__,
+				"Parallel forward differences differ from serial ones.");
+			ASSERT_EQUAL(exact[i], dpdxParallel[i], 1.0e-3, __FILE__, __LINE__,
+				"Forward differences differ from the gradient.");
+		}
+
+		Matrix jacSerial(2, nx), jacParallel(2, nx);
+		ASSERT(OptimizationTarget::CentralDifferencesConstraint(&serial,
+			serial.getDXArray(), x, jacSerial)==0, __FILE__, __LINE__);
+		ASSERT(OptimizationTarget::CentralDifferencesConstraint(&parallel,
+			parallel.getDXArray(), x, jacParallel)==0, __FILE__, __LINE__);
+		for(int j=0;j<2;j++) for(int i=0;i<nx;i++) {
+			ASSERT(jacSerial(j,i)==jacParallel(j,i), __FILE__, __LINE__,
+				"Parallel constraint derivatives differ from serial ones.");
+			ASSERT_EQUAL(exactJac(j,i), jacParallel(j,i), 1.0e-6,
+				__FILE__, __LINE__,
+				"Constraint derivatives differ from the Jacobian.");
+		}
+	}
+
+	// Assignment keeps the settings of the assigned target.
+	ExampleTarget assigned(1);
+	assigned = parallel;
+	ASSERT(assigned.getNumParameters()==nx &&
+		assigned.getNumDerivativeThreads()==4, __FILE__, __LINE__,
+		"Assigned target has different settings.");
+}
+
+int main()
+{
+	try {
+		testParallelDerivatives();
+		cout << "Parallel finite differences: PASSED" << endl;
+	}
+	catch (const std::exception& e) {
+		cout << "testOptimizationTarget failed: " << e.what() << endl;
+		return 1;
+	}
+	cout << "Done" << endl;
+	return 0;
+}
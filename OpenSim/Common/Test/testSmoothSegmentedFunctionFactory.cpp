@@ -1230,6 +1230,55 @@ int main(int argc, char* argv[])
                   createTendonForceLengthCurve(e0,kiso,ftoe,1.01,true,"test"));
             cout << "    passed" << endl;
 
+        //6. Testing shared curve fits: a curve with the same definition
+        //   shares the fit of tendonCurve
+            cout << endl;
+            cout << "   Shared Curve Testing" << endl;
+            int numSharedCurves = SmoothSegmentedFunction::getNumSharedCurves();
+            SmoothSegmentedFunction* tendonCurveShared = 
+                SmoothSegmentedFunctionFactory::createTendonForceLengthCurve(
+                    e0,kiso,ftoe,c,false,"test_tendonCurveShared");
+            SimTK_TEST(SmoothSegmentedFunction::getNumSharedCurves() 
+                       == numSharedCurves);
+            SimTK_TEST(!tendonCurveShared->isIntegralAvailable());
+            SimTK_TEST_MUST_THROW(tendonCurveShared->calcIntegral(1.0));
+            for(int i=0; i < tendonCurveSample.nrow(); i++){
+                double x = tendonCurveSample(i,0);
+                SimTK_TEST(tendonCurveShared->calcValue(x) 
+                           == tendonCurve.calcValue(x));
+            }
+            delete tendonCurveShared;
+            cout << "    passed" << endl;
+
+        //7. Testing the curve cache files: a curve that is no longer in use
+        //   is read back from its cache file, with its integral
+            cout << endl;
+            cout << "   Cache File Testing" << endl;
+            SmoothSegmentedFunction::setCacheDirectory(".");
+            SmoothSegmentedFunction* tendonCurveFit = 
+                SmoothSegmentedFunctionFactory::createTendonForceLengthCurve(
+                    e0,kiso,ftoe,0.6,true,"test_tendonCurveCached");
+            SimTK::Matrix tendonCurveFitSample
+                =tendonCurveFit->calcSampledMuscleCurve(2,1.0,1+e0);
+            delete tendonCurveFit;
+            SmoothSegmentedFunction* tendonCurveRead = 
+                SmoothSegmentedFunctionFactory::createTendonForceLengthCurve(
+                    e0,kiso,ftoe,0.6,true,"test_tendonCurveCached");
+            SimTK::Matrix tendonCurveReadSample
+                =tendonCurveRead->calcSampledMuscleCurve(2,1.0,1+e0);
+            std::string cacheFileName = tendonCurveRead->getCacheFileName();
+            delete tendonCurveRead;
+            SmoothSegmentedFunction::setCacheDirectory("");
+            SimTK_TEST(!cacheFileName.empty());
+            remove(cacheFileName.c_str());
+            SimTK_TEST(tendonCurveReadSample.ncol() 
+                       == tendonCurveFitSample.ncol());
+            for(int i=0; i < tendonCurveFitSample.nrow(); i++)
+                for(int j=0; j < tendonCurveFitSample.ncol(); j++)
+                    SimTK_TEST(tendonCurveReadSample(i,j) 
+                               == tendonCurveFitSample(i,j));
+            cout << "    passed" << endl;
+
         ///////////////////////////////////////
         //FIBER FORCE LENGTH CURVE
         ///////////////////////////////////////
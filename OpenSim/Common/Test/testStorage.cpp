@@ -21,7 +21,9 @@
  * -------------------------------------------------------------------------- */
 
 #include <fstream>
+#include <iterator>
 #include <OpenSim/Common/Storage.h>
+#include <OpenSim/Common/IO.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 
 using namespace OpenSim;
@@ -72,6 +74,67 @@ int main() {
 		ASSERT(fabs(diff) < 1E-7);
 
 		delete st;
+
+		// Stream rows to file while keeping only a few in memory; the file
+		// must read back as if the whole storage had been printed.
+		Array<std::string> streamLabels;
+		streamLabels.append("time"); streamLabels.append("v1"); streamLabels.append("v2");
+		Storage streamed(100, "streamed");
+		streamed.setColumnLabels(streamLabels);
+		streamed.setMaxRowsInMemory(10);
+		streamed.setOutputFileName("testStreamed.sto");
+		double row[2];
+		for(i=0; i<1000; i++){
+			row[0] = i; row[1] = 2.0*i;
+			streamed.append(0.001*i, 2, row);
+			// Replaces the row just appended; only the last one is kept.
+			row[1] = 3.0*i;
+			streamed.append(0.001*i, 2, row);
+		}
+		ASSERT(streamed.getSize() < 20);
+		streamed.print("testStreamed.sto");
+		ASSERT(!streamed.isStreaming());
+
+		Storage readBack("testStreamed.sto");
+		ASSERT(readBack.getSize()==1000);
+		ASSERT(readBack.getColumnLabels().getSize()==3);
+		for(i=0; i<readBack.getSize(); i++){
+			StateVector& readRow = (*readBack.getStateVector(i));
+			ASSERT(readRow.getData()[0]==i);
+			ASSERT(readRow.getData()[1]==3.0*i);
+		}
+
+		// Fast formatting must match the printf format it replaces.
+		char fast[IO_STRLEN], slow[IO_STRLEN];
+		double values[] = { 0.0, -0.0, 1.0, -1.0e-12, 0.5e-8, 1.5e-8, 2.5e-8,
+			0.125, 123456.123456789, -98765.4321, 1.0e20, SimTK::NaN,
+			SimTK::Infinity, 3.0e-5*7.0, 1.0/3.0 };
+		for(int prec=0; prec<=12; prec+=4) {
+			IO::SetPrecision(prec);
+			for(i=0; i<(int)(sizeof(values)/sizeof(values[0])); i++){
+				IO::FormatDouble(values[i], fast, IO_STRLEN);
+				sprintf(slow, IO::GetDoubleOutputFormat(), values[i]);
+				ASSERT(string(fast)==string(slow));
+			}
+		}
+		IO::SetPrecision(8);
+
+		// Printing in the background writes the same file.
+		Storage big(5000);
+		big.setColumnLabels(streamLabels);
+		for(i=0; i<5000; i++){
+			double y[] = { 0.001*i, std::sin(0.01*i) };
+			big.append(0.01*i, 2, y);
+		}
+		big.print("testPrintDirect.sto");
+		Storage::setPrintInBackground(true);
+		Storage::printResult(&big, "testPrintBackground", ".", -1, ".sto");
+		Storage::waitForBackgroundPrints();
+		Storage::setPrintInBackground(false);
+		ifstream direct("testPrintDirect.sto"), background("testPrintBackground.sto");
+		string directText((istreambuf_iterator<char>(direct)), istreambuf_iterator<char>());
+		string backgroundText((istreambuf_iterator<char>(background)), istreambuf_iterator<char>());
+		ASSERT(directText.size()>0 && directText==backgroundText);
     }
     catch (const Exception& e) {
         e.print(cerr);
@@ -31,6 +31,7 @@
 //==============================================================================
 //==============================================================================
 #include <OpenSim/OpenSim.h>
+#include <OpenSim/Common/OptimizationTarget.h>
 #include <ctime>  // clock(), clock_t, CLOCKS_PER_SEC
 
 using namespace OpenSim;
@@ -44,18 +45,51 @@ double initialTime = 0.0;
 double finalTime = 0.25;
 double bestSoFar = Infinity;
 
-class ExampleOptimizationSystem : public OptimizerSystem {
+class ExampleOptimizationSystem : public OptimizationTarget {
    public:
 
-	   /* Constructor class. Parameters passed are accessed in the objectiveFunc() class. */
-	   ExampleOptimizationSystem(int numParameters, State& s, Model& aModel): 
-             numControls(numParameters), OptimizerSystem(numParameters), si(s), osimModel(aModel)
+	   /* Constructor class. Parameters passed are accessed in the objectiveFunc() class.
+	    * A worker owns its model and only evaluates perturbed controls for the gradient. */
+	   ExampleOptimizationSystem(int numParameters, State& s, Model& aModel, bool aIsWorker=false): 
+             numControls(numParameters), OptimizationTarget(numParameters), si(s), osimModel(aModel),
+			 isWorker(aIsWorker)
 	   {
 		   // Create the integrator for the simulation.
 		   p_integrator = new RungeKuttaMersonIntegrator(osimModel.getMultibodySystem());
 		   p_integrator->setAccuracy(1.0e-7);
 		   p_manager = new Manager(osimModel, *p_integrator);
+
+		   // Perturbation used for the forward difference gradient. This is about
+		   // the step SimTK's numerical gradient chooses for an objective accurate
+		   // to 1e-5.
+		   setDX(3.0e-3);
+	   }
+
+	   ~ExampleOptimizationSystem()
+	   {
+		   delete p_manager;
+		   delete p_integrator;
+		   if(isWorker) delete &osimModel;
 	   }
+
+	/* Each perturbed control vector is a full forward simulation, so the
+	 * gradient is spread over threads, each with its own copy of the model. */
+	int gradientFunc( const Vector &controls, bool new_coefficients, Vector &gradient ) const {
+		return ForwardDifferences(this, &_dx[0], controls, gradient);
+	}
+
+	OptimizationTarget* createDerivativeWorker() const {
+		Model* model = osimModel.clone();
+		State& s = model->initSystem();
+		return new ExampleOptimizationSystem(numControls, s, *model, true);
+	}
+
+	void updateDerivativeWorker(OptimizationTarget& aWorker) const {
+		// Start the worker's simulations from the same initial states.
+		ExampleOptimizationSystem& worker = static_cast<ExampleOptimizationSystem&>(aWorker);
+		worker.si.setTime(si.getTime());
+		worker.si.updY() = si.getY();
+	}
 			 	
 	int objectiveFunc(  const Vector &newControls, bool new_coefficients, Real& f ) const {
 
@@ -84,6 +118,9 @@ class ExampleOptimizationSystem : public OptimizerSystem {
 		osimModel.getSimbodyEngine().getVelocity(s, osimModel.getBodySet().get("r_ulna_radius_hand"), massCenter, velocity);
 		
 		f = -velocity[0];
+
+		// Workers run concurrently, so only this target keeps the record.
+		if(isWorker) return(0);
 		stepCount++;
 		
 		// Store and print the  results of the first step.
@@ -105,8 +142,9 @@ private:
     int numControls;
 	State& si;
 	Model& osimModel;
-	SimTK::ReferencePtr<Manager> p_manager;
-	SimTK::ReferencePtr<RungeKuttaMersonIntegrator> p_integrator;
+	bool isWorker;
+	Manager* p_manager;
+	RungeKuttaMersonIntegrator* p_integrator;
 
  };
 
@@ -145,6 +183,7 @@ int main()
 		
 		// Initialize the optimizer system we've defined.
 		ExampleOptimizationSystem sys(numControls, si, osimModel);
+		sys.setNumDerivativeThreads(ParallelExecutor::getNumProcessors());
 		Real f = NaN;
 		
 		/* Define initial values and bounds for the controls to optimize */
@@ -161,7 +200,7 @@ int main()
 
 		// Specify settings for the optimizer
 		opt.setConvergenceTolerance(0.1);
-		opt.useNumericalGradient(true, 1e-5);
+		opt.useNumericalGradient(false);
 		opt.setMaxIterations(100);
 		opt.setLimitedMemoryHistory(500);
 			
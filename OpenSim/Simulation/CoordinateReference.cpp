@@ -23,6 +23,7 @@
 
 #include "CoordinateReference.h"
 #include "Model/Model.h"
+#include <OpenSim/Common/Constant.h>
 
 using namespace std;
 using namespace SimTK;
@@ -91,9 +92,8 @@ const SimTK::Array_<std::string>& CoordinateReference::getNames() const
 /** get the values of the CoordinateReference */
 void CoordinateReference::getValues(const SimTK::State &s, SimTK::Array_<double> &values) const
 {
-	SimTK::Vector t(1, s.getTime());
 	values.resize(getNumRefs());
-	values[0] = _coordinateValueFunction->calcValue(t);
+	values[0] = _coordinateValueFunction->calcValue(s.getTime());
 }
 
 
@@ -108,24 +108,29 @@ void CoordinateReference::getWeights(const SimTK::State &s, SimTK::Array_<double
 /** get the value of the CoordinateReference */
 double CoordinateReference::getValue(const SimTK::State &s) const
 {
-	SimTK::Vector t(1, s.getTime());
-	return _coordinateValueFunction->calcValue(t);
+	return _coordinateValueFunction->calcValue(s.getTime());
 }
 
 /** get the speed value of the CoordinateReference */
 double CoordinateReference::getSpeedValue(const SimTK::State &s) const
 {
-	SimTK::Vector t(1, s.getTime());
-	std::vector<int> order(1, 0);
-	return _coordinateValueFunction->calcDerivative(order, t);
+	return _coordinateValueFunction->calcDerivative(s.getTime(), 1);
 }
 
 /** get the acceleration value of the CoordinateReference */
 double CoordinateReference::getAccelerationValue(const SimTK::State &s) const
 {
-	SimTK::Vector t(1, s.getTime());
-	std::vector<int> order(2, 0);
-	return _coordinateValueFunction->calcDerivative(order, t);
+	return _coordinateValueFunction->calcDerivative(s.getTime(), 2);
+}
+
+/** set the value of the CoordinateReference to a constant */
+void CoordinateReference::setValue(double value)
+{
+	Constant* constant = dynamic_cast<Constant*>(_coordinateValueFunction);
+	if(constant)
+		constant->setValue(value);
+	else
+		setValueFunction(Constant(value));
 }
 
 /** get the weight of the CoordinateReference */
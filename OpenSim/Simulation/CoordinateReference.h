@@ -112,6 +112,10 @@ public:
 	{
 		_coordinateValueFunction = function.clone();
 	}
+	/** Set the coordinate value to a constant. If the current value function
+	    is already a Constant its value is updated in place, so that repeated
+	    updates (e.g. frame-by-frame assembly) do not allocate. */
+	void setValue(double value);
 private:
     void copyData(const CoordinateReference& source);
 
@@ -130,15 +130,53 @@ void InverseDynamicsSolver::solve(SimTK::State &s, const FunctionSet &Qs, const
 	int nq = getModel().getNumCoordinates();
 	int nt = times.size();
 
+	if(Qs.getSize() != nq){
+		throw Exception("InverseDynamicsSolver::solve invalid number of q functions.");
+	}
+
+	if( nq != getModel().getNumSpeeds()){
+		throw Exception("InverseDynamicsSolver::solve using FunctionSet, nq != nu not supported.");
+	}
+
 	//Preallocate if not done already
 	genForceTrajectory.resize(nt, Vector(nq));
+
+	// evaluate the coordinate functions for all times before solving
+	Array_<Vector> qTraj, uTraj, udotTraj;
+	evaluateTrajectory(Qs, times, qTraj, uTraj, udotTraj);
 	
 	AnalysisSet& analysisSet = const_cast<AnalysisSet&>(getModel().getAnalysisSet());
 	//fill in results for each time
 	for(int i=0; i<nt; i++){ 
-		genForceTrajectory[i] = solve(s, Qs, times[i]);
+		s.updTime() = times[i];
+		s.updQ() = qTraj[i];
+		s.updU() = uTraj[i];
+		s.updUDot() = udotTraj[i];
+		genForceTrajectory[i] = solve(s, udotTraj[i]);
 		analysisSet.step(s, i);
 	}
 }
 
+/** Evaluate the coordinate functions, and their first and second derivatives,
+    at all times. Each function is evaluated over all the times in turn. */
+void InverseDynamicsSolver::evaluateTrajectory(const FunctionSet &Qs, const Array_<double> &times, 
+	Array_<Vector> &qTrajectory, Array_<Vector> &uTrajectory, Array_<Vector> &udotTrajectory)
+{
+	int nq = Qs.getSize();
+	int nt = times.size();
+
+	qTrajectory.resize(nt, Vector(nq));
+	uTrajectory.resize(nt, Vector(nq));
+	udotTrajectory.resize(nt, Vector(nq));
+
+	for(int j=0; j<nq; j++){
+		const Function& f = Qs[j];
+		for(int i=0; i<nt; i++){
+			qTrajectory[i][j] = f.calcValue(times[i]);
+			uTrajectory[i][j] = f.calcDerivative(times[i], 1);
+			udotTrajectory[i][j] = f.calcDerivative(times[i], 2);
+		}
+	}
+}
+
 } // end of namespace OpenSim
\ No newline at end of file
@@ -97,6 +97,15 @@ public:
 	virtual void solve(SimTK::State& s, const FunctionSet& Qs, 
 		         const SimTK::Array_<double>&  times,
 				 SimTK::Array_<SimTK::Vector>& genForceTrajectory);
+
+	/** Evaluate the coordinate functions and their first and second 
+	    derivatives at all the given times up front, one Vector of q, u and
+		udot per time, for solving a trajectory frame by frame. */
+	static void evaluateTrajectory(const FunctionSet& Qs, 
+		         const SimTK::Array_<double>& times,
+				 SimTK::Array_<SimTK::Vector>& qTrajectory,
+				 SimTK::Array_<SimTK::Vector>& uTrajectory,
+				 SimTK::Array_<SimTK::Vector>& udotTrajectory);
 #endif
 //=============================================================================
 };	// END of class InverseDynamicsSolver
@@ -25,6 +25,8 @@
  * Author: Frank C. Anderson 
  */
 #include <cstdio>
+#include <cstring>
+#include <fstream>
 #include "Manager.h"
 #include <OpenSim/Simulation/Control/ControlConstant.h>
 #include <OpenSim/Simulation/Model/Model.h>
@@ -34,6 +36,7 @@
 #include <OpenSim/Simulation/Control/Controller.h>
 #include <OpenSim/Simulation/Model/ControllerSet.h>
 #include <OpenSim/Common/Array.h>
+#include <OpenSim/Common/IO.h>
 
 
 
@@ -139,6 +142,10 @@ setNull()
 	_tArray.setSize(0);
     _system = 0;
 	_dtArray.setSize(0);
+	_reportInterval = 0.0;
+	_reportTimes.setSize(0);
+	_checkpointFile = "";
+	_checkpointInterval = 0.0;
 }
 //_____________________________________________________________________________
 /**
@@ -446,6 +453,34 @@ getNextTimeArrayTime(double aTime)
 	return(getTimeArrayTime( _tArray.searchBinary(aTime)+1));
 }
 //_____________________________________________________________________________
+/**
+ * Get the first time after a specified time at which analyses and state
+ * storage are to be updated when reporting at an interval or at explicit
+ * times.  The returned time is never greater than the final time.
+ *
+ * @param aTime Time of the last report.
+ * @return Time of the next report.
+ */
+double Manager::
+getNextReportTime(double aTime) const
+{
+	// Times this close to aTime have already been reported.
+	double tol = 1.0e-12*(1.0+fabs(aTime));
+	double next = _tf;
+
+	if(_reportTimes.getSize()>0) {
+		int i = _reportTimes.searchBinary(aTime+tol) + 1;
+		while(i<_reportTimes.getSize() && _reportTimes[i]<=aTime+tol) i++;
+		if(i<_reportTimes.getSize()) next = _reportTimes[i];
+	} else if(_reportInterval>0.0) {
+		double k = floor((aTime+tol-_ti)/_reportInterval) + 1.0;
+		next = _ti + k*_reportInterval;
+	}
+
+	if(next>_tf) next = _tf;
+	return(next);
+}
+//_____________________________________________________________________________
 //
 /**
  * Get the time of a specified integration step.
@@ -562,6 +597,25 @@ setIntegrator(SimTK::Integrator& integrator)
     _integ = &integrator;
 }
 
+/**
+ * Create an integrator by name.
+ */
+SimTK::Integrator* Manager::
+createIntegrator(const std::string& method, const SimTK::System& system)
+{
+	if(method == "RungeKuttaMerson")
+		return new SimTK::RungeKuttaMersonIntegrator(system);
+	if(method == "RungeKuttaFeldberg")
+		return new SimTK::RungeKuttaFeldbergIntegrator(system);
+	if(method == "RungeKutta3")
+		return new SimTK::RungeKutta3Integrator(system);
+	if(method == "CPodes")
+		return new SimTK::CPodesIntegrator(system, 
+			SimTK::CPodes::BDF, SimTK::CPodes::Newton);
+
+	throw Exception("Manager::createIntegrator: unrecognized integration "
+		"method '" + method + "'.", __FILE__, __LINE__);
+}
 
 //-----------------------------------------------------------------------------
 // INTIAL AND FINAL TIME
@@ -676,6 +730,192 @@ hasStateStorage() const
     return (_stateStore != NULL);
 }
 
+//-----------------------------------------------------------------------------
+// CHECKPOINTS
+//-----------------------------------------------------------------------------
+// Identifies checkpoint files and the version of their layout.
+static const char CheckpointTag[8] = {'O','S','I','M','C','K','P','1'};
+
+static void writeBinary(std::ofstream& out, const void* aData, size_t aSize)
+{
+	out.write(static_cast<const char*>(aData), aSize);
+}
+static void readBinary(std::ifstream& in, void* aData, size_t aSize,
+	const std::string& aFileName)
+{
+	in.read(static_cast<char*>(aData), aSize);
+	if(!in) throw Exception("Manager.readCheckpoint: ERR- file "+aFileName+
+		" is truncated.",__FILE__,__LINE__);
+}
+static void writeVector(std::ofstream& out, const SimTK::Vector& aVec)
+{
+	int n = aVec.size();
+	writeBinary(out, &n, sizeof(int));
+	for(int i=0;i<n;i++) writeBinary(out, &aVec[i], sizeof(double));
+}
+static void readVector(std::ifstream& in, SimTK::Vector& rVec,
+	const std::string& aWhat, const std::string& aFileName)
+{
+	int n;
+	readBinary(in, &n, sizeof(int), aFileName);
+	if(n!=rVec.size()) {
+		std::stringstream msg;
+		msg << "Manager.readCheckpoint: ERR- file " << aFileName << " has "
+			<< n << " " << aWhat << " but the model has " << rVec.size() << ".";
+		throw Exception(msg.str(),__FILE__,__LINE__);
+	}
+	for(int i=0;i<n;i++) readBinary(in, &rVec[i], sizeof(double), aFileName);
+}
+static void writeName(std::ofstream& out, const std::string& aName)
+{
+	int n = (int)aName.size();
+	writeBinary(out, &n, sizeof(int));
+	writeBinary(out, aName.c_str(), n);
+}
+static std::string readName(std::ifstream& in, const std::string& aFileName)
+{
+	int n;
+	readBinary(in, &n, sizeof(int), aFileName);
+	std::string name(n, ' ');
+	if(n>0) readBinary(in, &name[0], n, aFileName);
+	return name;
+}
+
+//_____________________________________________________________________________
+/**
+ * Set the file to which checkpoints are written during integration and the
+ * interval of simulated time between them.
+ */
+void Manager::
+setCheckpointFile(const std::string& aFileName, double aInterval)
+{
+	_checkpointFile = aFileName;
+	_checkpointInterval = aInterval;
+}
+//_____________________________________________________________________________
+/**
+ * Write a binary checkpoint of a state.
+ *
+ * @param s State to be written.
+ * @param aStep Number of integration steps taken so far.
+ * @param aFileName Name of the checkpoint file.
+ */
+void Manager::
+writeCheckpoint(const SimTK::State& s, int aStep,
+	const std::string& aFileName) const
+{
+	// Write to a temporary file first so that an interruption while writing
+	// never leaves a damaged checkpoint behind.
+	std::string tmpFileName = aFileName + ".tmp";
+	std::ofstream out(tmpFileName.c_str(), std::ios::out|std::ios::binary);
+	if(!out) {
+		cout<<"Manager.writeCheckpoint: WARN- could not open "<<tmpFileName
+			<<". No checkpoint written."<<endl;
+		return;
+	}
+
+	writeBinary(out, CheckpointTag, sizeof(CheckpointTag));
+	double time = s.getTime();
+	writeBinary(out, &time, sizeof(double));
+	writeBinary(out, &aStep, sizeof(int));
+	writeVector(out, s.getQ());
+	writeVector(out, s.getU());
+	writeVector(out, s.getZ());
+
+	Array<std::string> names = _model->getDiscreteVariableNames();
+	int n = names.getSize();
+	writeBinary(out, &n, sizeof(int));
+	for(int i=0;i<n;i++) {
+		double value = _model->getDiscreteVariable(s, names[i]);
+		writeName(out, names[i]);
+		writeBinary(out, &value, sizeof(double));
+	}
+
+	names = _model->getModelingOptionNames();
+	n = names.getSize();
+	writeBinary(out, &n, sizeof(int));
+	for(int i=0;i<n;i++) {
+		int flag = _model->getModelingOption(s, names[i]);
+		writeName(out, names[i]);
+		writeBinary(out, &flag, sizeof(int));
+	}
+
+	out.close();
+	if(!out) {
+		cout<<"Manager.writeCheckpoint: WARN- failed writing "<<tmpFileName
+			<<". No checkpoint written."<<endl;
+		remove(tmpFileName.c_str());
+		return;
+	}
+	// Replace the previous checkpoint in one step, so that it is there until
+	// the new one is.
+	if(IO::renameFile(tmpFileName, aFileName)!=0)
+		cout<<"Manager.writeCheckpoint: WARN- could not rename "<<tmpFileName
+			<<" to "<<aFileName<<"."<<endl;
+}
+//_____________________________________________________________________________
+/**
+ * Restore a checkpoint into a state and make its time the initial time.
+ *
+ * @param s State of the initialized model, which is overwritten.
+ * @param aFileName Name of the checkpoint file.
+ * @return Number of integration steps taken when the checkpoint was written.
+ */
+int Manager::
+readCheckpoint(SimTK::State& s, const std::string& aFileName)
+{
+	std::ifstream in(aFileName.c_str(), std::ios::in|std::ios::binary);
+	if(!in) throw Exception("Manager.readCheckpoint: ERR- could not open "+
+		aFileName+".",__FILE__,__LINE__);
+
+	char tag[sizeof(CheckpointTag)];
+	readBinary(in, tag, sizeof(tag), aFileName);
+	if(memcmp(tag, CheckpointTag, sizeof(tag))!=0)
+		throw Exception("Manager.readCheckpoint: ERR- "+aFileName+
+			" is not a checkpoint file.",__FILE__,__LINE__);
+
+	double time;
+	int step;
+	readBinary(in, &time, sizeof(double), aFileName);
+	readBinary(in, &step, sizeof(int), aFileName);
+	readVector(in, s.updQ(), "generalized coordinates", aFileName);
+	readVector(in, s.updU(), "generalized speeds", aFileName);
+	readVector(in, s.updZ(), "auxiliary states", aFileName);
+
+	// Variables the model no longer has are skipped; the rest keep the
+	// values given to them by the model.
+	int n;
+	readBinary(in, &n, sizeof(int), aFileName);
+	for(int i=0;i<n;i++) {
+		std::string name = readName(in, aFileName);
+		double value;
+		readBinary(in, &value, sizeof(double), aFileName);
+		try {
+			_model->setDiscreteVariable(s, name, value);
+		} catch(const Exception&) {
+			cout<<"Manager.readCheckpoint: WARN- model has no discrete "
+				<<"variable "<<name<<". Its value is ignored."<<endl;
+		}
+	}
+	readBinary(in, &n, sizeof(int), aFileName);
+	for(int i=0;i<n;i++) {
+		std::string name = readName(in, aFileName);
+		int flag;
+		readBinary(in, &flag, sizeof(int), aFileName);
+		try {
+			_model->setModelingOption(s, name, flag);
+		} catch(const Exception&) {
+			cout<<"Manager.readCheckpoint: WARN- model has no modeling "
+				<<"option "<<name<<". Its value is ignored."<<endl;
+		}
+	}
+
+	s.setTime(time);
+	setInitialTime(time);
+
+	return(step);
+}
+
 //-----------------------------------------------------------------------------
 // INTEGRATION
 //-----------------------------------------------------------------------------
@@ -741,6 +981,13 @@ bool Manager::doIntegration(SimTK::State& s, int step, double dtFirst ) {
     double fixedStepSize;
 	if( _constantDT || _specifiedDT) fixedStep = true;
 
+	// With a reporting interval or explicit report times, the integrator
+	// steps freely and only returns (interpolating its dense output) at the
+	// report times and at significant events, so analyses and storage are
+	// not updated on every internal step.
+	bool reportAtTimes = !fixedStep &&
+		(_reportInterval>0.0 || _reportTimes.getSize()>0);
+
     // If _system is has been set we should be integrating a CMC system
     // not the model's system.
     const SimTK::System& sys = _system ? *_system 
@@ -754,7 +1001,7 @@ bool Manager::doIntegration(SimTK::State& s, int step, double dtFirst ) {
     if( fixedStep ) {
         dt = getFixedStepSize(getTimeArrayStep(_ti));
     } else {
-        _integ->setReturnEveryInternalStep(true); 
+        _integ->setReturnEveryInternalStep(!reportAtTimes); 
     }
 
     if( s.getTime()+dt >= _tf ) dt = _tf - s.getTime();
@@ -784,6 +1031,10 @@ bool Manager::doIntegration(SimTK::State& s, int step, double dtFirst ) {
 
     double stepToTime = _tf;
 
+    // CHECKPOINTS
+    bool checkpoint = !_checkpointFile.empty() && _system==NULL;
+    double nextCheckpointTime = time + _checkpointInterval;
+
     // LOOP
     while( time  < _tf ) {
 		if( fixedStep ){
@@ -792,6 +1043,8 @@ bool Manager::doIntegration(SimTK::State& s, int step, double dtFirst ) {
              _integ->setFixedStepSize( fixedStepSize );
              stepToTime = time + fixedStepSize; 
         }
+        else if( reportAtTimes )
+            stepToTime = getNextReportTime( time );
 
         // stepTo() does not return if it fails. However, the final step
         // is returned once as an ordinary return; by the time we get
@@ -812,6 +1065,12 @@ bool Manager::doIntegration(SimTK::State& s, int step, double dtFirst ) {
 					_controllerSet->storeControls(s, step);
             }
             step++;
+
+            // CHECKPOINT
+            if( checkpoint && tReal>=nextCheckpointTime ) {
+                writeCheckpoint(s, step, _checkpointFile);
+                nextCheckpointTime = tReal + _checkpointInterval;
+            }
         }
         else
             halt();
@@ -96,6 +96,18 @@ private:
    Array<double> _tArray;
    /** Vector of integration time step deltas. */
    Array<double> _dtArray;
+   /** Interval at which analyses and state storage are updated during
+   variable step integration. If zero or less, they are updated after every
+   internal integrator step. */
+   double _reportInterval;
+   /** Explicit times at which analyses and state storage are updated during
+   variable step integration. Takes precedence over _reportInterval. */
+   Array<double> _reportTimes;
+   /** File to which checkpoints of the integration are written. No
+   checkpoints are written if empty. */
+   std::string _checkpointFile;
+   /** Simulated time between checkpoints. */
+   double _checkpointInterval;
 
 	/** Name to be shown by the UI */
 	static std::string _displayName;
@@ -144,6 +156,15 @@ public:
 	SimTK::Integrator& getIntegrator() const;
 	/** Set the integrator*/
     void setIntegrator( SimTK::Integrator&);
+	/** Create a new integrator of the named method for the given system.
+	    Recognized methods are "RungeKuttaMerson" (the default used by the
+	    tools), "RungeKuttaFeldberg", "RungeKutta3" and "CPodes". CPodes uses
+	    an implicit, variable-order BDF method with Newton iteration, which
+	    can take much larger steps than the explicit methods on stiff models
+	    such as equilibrium muscles with compliant tendons. The caller takes
+	    ownership of the returned integrator. */
+	static SimTK::Integrator* createIntegrator(const std::string& method,
+		const SimTK::System& system);
 	// Initial and final times
 	void setInitialTime(double aTI);
 	double getInitialTime() const;
@@ -170,6 +191,21 @@ public:
    void resetTimeAndDTArrays(double aTime);
 
    double getNextTimeArrayTime(double aTime);
+   // REPORTING
+   /** Report (run the analyses and store the states) every aDT seconds of
+   simulated time, starting at the initial time, instead of after every
+   internal step of a variable step integrator. The integrator steps freely
+   and the reported states are interpolated from its dense output. A value of
+   zero or less restores reporting at every internal step. Has no effect
+   when constant or specified time steps are used. */
+   void setReportingInterval(double aDT) { _reportInterval = aDT; }
+   double getReportingInterval() const { return _reportInterval; }
+   /** Report only at the given (increasing) times, in the same manner as
+   setReportingInterval(). The initial and final times are always reported.
+   An empty array clears the list. */
+   void setReportingTimes(const Array<double>& aTimes) { _reportTimes = aTimes; }
+   const Array<double>& getReportingTimes() const { return _reportTimes; }
+   double getNextReportTime(double aTime) const;
 
 
     // SYSTEM
@@ -186,6 +222,29 @@ public:
     void finalize( SimTK::State& s);
     double getFixedStepSize(int tArrayStep) const;
 
+	// CHECKPOINTS
+	/** Write a checkpoint of the integration to aFileName every aInterval
+	seconds of simulated time (at every reported step if aInterval is zero
+	or less), so that a long simulation can be resumed with
+	readCheckpoint() after it is interrupted. Each checkpoint replaces the
+	previous one. An empty file name turns checkpointing off. Checkpoints are
+	only written when integrating the model's own system. */
+	void setCheckpointFile(const std::string& aFileName, double aInterval);
+	const std::string& getCheckpointFile() const { return _checkpointFile; }
+	double getCheckpointInterval() const { return _checkpointInterval; }
+	/** Write a binary checkpoint of the state: time, Q, U, Z, the model's
+	discrete variables and modeling options (by name), and the number of
+	integration steps taken so far. The file is written in the byte order of
+	this machine and is replaced atomically. */
+	void writeCheckpoint(const SimTK::State& s, int aStep,
+		const std::string& aFileName) const;
+	/** Restore a checkpoint written by writeCheckpoint() into a state of the
+	same, initialized model and make its time the initial time of the
+	integration. Returns the step number to pass to doIntegration() to
+	resume. Throws an Exception if the file cannot be read or does not
+	match the model's state. */
+	int readCheckpoint(SimTK::State& s, const std::string& aFileName);
+
 	// STATE STORAGE
     bool hasStateStorage() const;
 	void setStateStorage(Storage& aStorage);
@@ -160,7 +160,10 @@ void Actuator::constructProperties()
 
 void Actuator::constructOutputs() 
 {
-	constructOutput<double>("force", &Actuator::getForce, SimTK::Stage::Velocity);
+	// The force of an actuator with states (e.g., a muscle) changes with
+	// them, so it is not cached at Velocity.
+	constructOutput<double>("force", &Actuator::getForce, SimTK::Stage::Velocity,
+		false);
 	constructOutput<double>("speed", &Actuator::getSpeed, SimTK::Stage::Velocity);	
 }
 
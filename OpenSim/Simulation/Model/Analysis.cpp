@@ -351,6 +351,26 @@ ArrayPtrs<Storage>& Analysis::getStorageList()
 {
 	return _storageList;
 }
+//_____________________________________________________________________________
+/**
+ * Stream the storages in the storage list to files in aDir.  Storages that
+ * are already streaming are left alone.
+ */
+void Analysis::
+streamResults(const string &aDir, int aMaxRowsInMemory)
+{
+	string dir = (aDir=="") ? "." : aDir;
+	ArrayPtrs<Storage>& storageList = getStorageList();
+	for(int i=0;i<storageList.getSize();i++) {
+		Storage *store = storageList.get(i);
+		if(store==NULL || store->isStreaming()) continue;
+		char index[32];
+		sprintf(index,"%d",i);
+		store->setMaxRowsInMemory(aMaxRowsInMemory);
+		store->setOutputFileName(dir+"/"+getName()+"_"+index+"_"+
+			store->getName()+".partial.sto");
+	}
+}
 
 // GET AND SET
 //=============================================================================
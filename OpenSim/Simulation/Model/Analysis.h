@@ -210,6 +210,15 @@ public:
 	int getStorageInterval() const;
 #endif
 	virtual ArrayPtrs<Storage>& getStorageList();
+	/**
+	 * Stream the storages of this analysis to files in a directory as rows
+	 * are recorded, keeping at most about aMaxRowsInMemory rows of each in
+	 * memory.  printResults() moves the streamed files into place.
+	 *
+	 * @param aDir Directory in which the partial result files are written.
+	 * @param aMaxRowsInMemory Rows retained in memory (<=0 retains all).
+	 */
+	void streamResults(const std::string &aDir, int aMaxRowsInMemory);
 	void setPrintResultFiles(bool aToWrite) { _printResultFiles = aToWrite; }
 	bool getPrintResultFiles() const { return _printResultFiles; }
 
@@ -106,6 +106,8 @@ void AnalysisSet::
 setNull()
 {
     _enable = true;
+	_streamDir = "";
+	_streamMaxRowsInMemory = -1;
 }
 void AnalysisSet::
 setupProperties() {
@@ -121,6 +123,8 @@ operator=(const  AnalysisSet &aSet)
      Set<Analysis>::operator=(aSet);
  
      _enable = aSet._enable;
+     _streamDir = aSet._streamDir;
+     _streamMaxRowsInMemory = aSet._streamMaxRowsInMemory;
      return(*this);
 }
 //=============================================================================
@@ -184,6 +188,23 @@ getOn() const
 	for(int i=0; i<getSize(); i++) on[i] = get(i).getOn();
 	return on;
 }
+//_____________________________________________________________________________
+/**
+ * Stream the results of the analyses to files in aDir while a simulation
+ * runs, rather than accumulating them all in memory.  Streaming starts in
+ * begin(); printResults() completes the files and gives them their usual
+ * names.  Pass an empty directory to keep results in memory.
+ *
+ * @param aDir Directory for the partial result files.
+ * @param aMaxRowsInMemory Rows of each storage retained in memory (<=0
+ * retains all rows, in which case results can still be resampled).
+ */
+void AnalysisSet::
+setStreamResults(const string &aDir, int aMaxRowsInMemory)
+{
+	_streamDir = aDir;
+	_streamMaxRowsInMemory = aMaxRowsInMemory;
+}
 
 
 //=============================================================================
@@ -203,7 +224,10 @@ begin(SimTK::State& s )
 	int i;
 	for(i=0;i<getSize();i++) {
 		Analysis& analysis = get(i);
-		if (analysis.getOn()) analysis.begin(s);
+		if (!analysis.getOn()) continue;
+		analysis.begin(s);
+		if(_streamDir!="")
+			analysis.streamResults(_streamDir,_streamMaxRowsInMemory);
 	}
 }
 //_____________________________________________________________________________
@@ -65,6 +65,11 @@ protected:
     // testing for memory free error
     OpenSim::PropertyBool _enableProp;
     bool &_enable;
+
+	/** Directory to which results are streamed during a simulation (empty
+	if results are kept in memory until printResults()). */
+	std::string _streamDir;
+	int _streamMaxRowsInMemory;
 //
 //=============================================================================
 // METHODS
@@ -92,6 +97,8 @@ public:
 	void setOn(bool aTrueFalse);
 	void setOn(const Array<bool> &aOn);
 	Array<bool> getOn() const;
+	void setStreamResults(const std::string &aDir, int aMaxRowsInMemory=1000);
+	const std::string& getStreamResultsDir() const { return _streamDir; }
 
 	//--------------------------------------------------------------------------
 	// CALLBACKS
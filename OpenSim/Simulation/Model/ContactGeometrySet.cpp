@@ -23,6 +23,7 @@
 
 #include "ContactGeometrySet.h"
 #include <OpenSim/Common/ScaleSet.h>
+#include <sstream>
 
 using namespace std;
 using namespace OpenSim;
@@ -121,3 +122,84 @@ void ContactGeometrySet::scale(const ScaleSet& aScaleSet)
 {
 	for(int i=0; i<getSize(); i++) get(i).scale(aScaleSet);
 }
+//_____________________________________________________________________________
+void ContactGeometrySet::createContactGroups(
+	const Array<ContactGeometry*>& aGeometries,
+	const Property<std::string>& aEnabledPairs,
+	SimTK::Array_<SimTK::Array_<int> >& rGroups)
+{
+	rGroups.clear();
+	int n = aGeometries.getSize();
+
+	// Without contact pairs everything is in one contact set, in which
+	// Simbody already skips geometries on the same body.
+	if(aEnabledPairs.size() == 0) {
+		rGroups.push_back(SimTK::Array_<int>());
+		for(int i=0; i<n; i++) rGroups.back().push_back(i);
+		return;
+	}
+
+	// Which pairs may touch, as a symmetric n x n table. Pairs on the same
+	// body never touch, so they may share a set whether enabled or not.
+	SimTK::Array_<bool> mayTouch(n*n, false), sameBody(n*n, false);
+	for(int i=0; i<n; i++)
+		for(int j=0; j<n; j++)
+			sameBody[i*n+j] =
+				aGeometries[i]->getBodyName() == aGeometries[j]->getBodyName();
+	for(int p=0; p<aEnabledPairs.size(); p++) {
+		std::istringstream names(aEnabledPairs[p]);
+		std::string name1, name2;
+		names >> name1 >> name2;
+		if(name2.empty())
+			throw Exception("Contact pair '"+aEnabledPairs[p]+
+				"' must name two ContactGeometry objects.");
+		bool found1 = false, found2 = false;
+		for(int i=0; i<n; i++) {
+			if(aGeometries[i]->getName() == name1) found1 = true;
+			if(aGeometries[i]->getName() == name2) found2 = true;
+			if(aGeometries[i]->getName() != name1) continue;
+			for(int j=0; j<n; j++)
+				if(aGeometries[j]->getName() == name2 && !sameBody[i*n+j])
+					mayTouch[i*n+j] = mayTouch[j*n+i] = true;
+		}
+		if(!found1 || !found2)
+			throw Exception("Contact pair '"+aEnabledPairs[p]+
+				"' names a ContactGeometry the force does not use.");
+	}
+
+	// The pairs do not exclude anything: keep the single contact set.
+	bool allPairs = true;
+	for(int i=0; i<n && allPairs; i++)
+		for(int j=i+1; j<n && allPairs; j++)
+			allPairs = mayTouch[i*n+j] || sameBody[i*n+j];
+	if(allPairs) {
+		rGroups.push_back(SimTK::Array_<int>());
+		for(int i=0; i<n; i++) rGroups.back().push_back(i);
+		return;
+	}
+
+	// Otherwise grow groups in which every pair either is on one body or may
+	// touch and has not been placed in a group yet, so that no pair is
+	// evaluated twice.
+	SimTK::Array_<bool> grouped(n*n, false);
+	for(int i=0; i<n; i++) {
+		for(int j=i+1; j<n; j++) {
+			if(!mayTouch[i*n+j] || grouped[i*n+j]) continue;
+			SimTK::Array_<int> group;
+			group.push_back(i);
+			group.push_back(j);
+			grouped[i*n+j] = grouped[j*n+i] = true;
+			for(int k=j+1; k<n; k++) {
+				bool fits = true;
+				for(unsigned m=0; m<group.size() && fits; m++)
+					fits = sameBody[group[m]*n+k] ||
+						(mayTouch[group[m]*n+k] && !grouped[group[m]*n+k]);
+				if(!fits) continue;
+				for(unsigned m=0; m<group.size(); m++)
+					grouped[group[m]*n+k] = grouped[k*n+group[m]] = true;
+				group.push_back(k);
+			}
+			rGroups.push_back(group);
+		}
+	}
+}
@@ -65,6 +65,23 @@ public:
 	// UTILITIES
 	//--------------------------------------------------------------------------
 	void scale(const ScaleSet& aScaleSet);
+
+	/**
+	 * Divide the geometries used by a contact force into groups, one per
+	 * contact set. If aEnabledPairs is empty, or enables every pair of
+	 * geometries on different bodies, a single group holds all geometries.
+	 * Otherwise only the pairs it lists, each given as two geometry names
+	 * separated by whitespace, may touch: each of them is in exactly one
+	 * group, and no other pair of geometries on different bodies shares a
+	 * group.
+	 *
+	 * @param aGeometries Geometries used by the force.
+	 * @param aEnabledPairs Pairs of geometries that may touch; empty for all.
+	 * @param rGroups Groups of indices into aGeometries.
+	 */
+	static void createContactGroups(const Array<ContactGeometry*>& aGeometries,
+		const Property<std::string>& aEnabledPairs,
+		SimTK::Array_<SimTK::Array_<int> >& rGroups);
 //=============================================================================
 };	// END of class ContactGeometrySet
 //=============================================================================
@@ -22,16 +22,236 @@
  * -------------------------------------------------------------------------- */
 
 #include <fstream>
+#include <sstream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <future>
+#include <cstdio>
 #include <OpenSim/Common/IO.h>
 #include "ContactMesh.h"
 #include "Model.h"
 
 namespace OpenSim {
 
+typedef SimTK::ContactGeometry::TriangleMesh TriangleMesh;
+
+//=============================================================================
+// MESH CACHE
+//=============================================================================
+// Meshes are held weakly so that a mesh is freed once no ContactMesh uses it.
+// While a mesh is being loaded its entry holds a future instead, so that the
+// mutex is only held to look up and update entries, never while parsing, and
+// other threads asking for the same mesh wait for that one load.
+typedef std::shared_ptr<const TriangleMesh> MeshPtr;
+struct CachedMesh {
+	std::weak_ptr<const TriangleMesh> mesh;
+	std::shared_future<MeshPtr> loading;
+};
+static std::mutex meshCacheMutex;
+static std::map<std::string, CachedMesh> meshCache;
+static bool useMeshCacheFiles = false;
+
+static const char MeshCacheTag[] = "OSIMMSH1";
+
+// 64-bit FNV-1a hash of the mesh file contents.
+static unsigned long long hashMeshContents(const std::string& contents)
+{
+	unsigned long long hash = 14695981039346656037ULL;
+	for (size_t i = 0; i < contents.size(); ++i) {
+		hash ^= (unsigned char)contents[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+static bool isAbsolutePath(const std::string& filename)
+{
+	return filename.empty() || filename[0]=='/' || filename[0]=='\\' ||
+		(filename.size()>1 && filename[1]==':');
+}
+
+static std::string getAbsolutePath(const std::string& filename)
+{
+	if (isAbsolutePath(filename)) return filename;
+	return IO::getCwd() + "/" + filename;
+}
+
+// Read the triangles of a mesh from a cache file. Fails if the file does not
+// exist or was written for different mesh file contents.
+static bool readMeshCacheFile(const std::string& cacheFile,
+	unsigned long long hash, SimTK::Array_<SimTK::Vec3>& vertices,
+	SimTK::Array_<int>& faceIndices)
+{
+	std::ifstream in(cacheFile.c_str(), std::ios::in | std::ios::binary);
+	if (!in.good()) return false;
+
+	char tag[sizeof(MeshCacheTag)-1];
+	unsigned long long fileHash = 0;
+	int nv = -1, nf = -1;
+	in.read(tag, sizeof(tag));
+	in.read((char*)&fileHash, sizeof(fileHash));
+	in.read((char*)&nv, sizeof(nv));
+	if (!in.good() || std::string(tag, sizeof(tag))!=MeshCacheTag ||
+		fileHash!=hash || nv<0)
+		return false;
+	vertices.resize(nv);
+	if (nv > 0) in.read((char*)&vertices[0], nv*sizeof(SimTK::Vec3));
+	in.read((char*)&nf, sizeof(nf));
+	if (!in.good() || nf<0) return false;
+	faceIndices.resize(3*nf);
+	if (nf > 0) in.read((char*)&faceIndices[0], 3*nf*sizeof(int));
+	if (in.fail()) return false;
+
+	for (int i = 0; i < 3*nf; ++i)
+		if (faceIndices[i]<0 || faceIndices[i]>=nv) return false;
+	return true;
+}
+
+// Save the triangles of a mesh to a cache file. The file is written under a
+// temporary name first so that a reader never sees a partial file. Failure
+// (e.g., a read-only directory) only means later runs parse the mesh again.
+static void writeMeshCacheFile(const std::string& cacheFile,
+	unsigned long long hash, const TriangleMesh& mesh)
+{
+	std::string tmpFile = cacheFile + ".tmp";
+	std::ofstream out(tmpFile.c_str(), std::ios::out | std::ios::binary);
+	if (!out.good()) return;
+
+	int nv = mesh.getNumVertices(), nf = mesh.getNumFaces();
+	out.write(MeshCacheTag, sizeof(MeshCacheTag)-1);
+	out.write((const char*)&hash, sizeof(hash));
+	out.write((const char*)&nv, sizeof(nv));
+	for (int i = 0; i < nv; ++i) {
+		SimTK::Vec3 v = mesh.getVertexPosition(i);
+		out.write((const char*)&v, sizeof(v));
+	}
+	out.write((const char*)&nf, sizeof(nf));
+	for (int i = 0; i < nf; ++i)
+		for (int j = 0; j < 3; ++j) {
+			int v = mesh.getFaceVertex(i, j);
+			out.write((const char*)&v, sizeof(v));
+		}
+	out.close();
+
+	if (out.fail() || IO::renameFile(tmpFile, cacheFile) != 0)
+		std::remove(tmpFile.c_str());
+}
+
+// Build the mesh from its cache file, or parse the mesh file contents.
+static MeshPtr loadTriangleMesh(const std::string& filename,
+	const std::string& contents, unsigned long long hash, bool useCacheFile)
+{
+	SimTK::Array_<SimTK::Vec3> vertices;
+	SimTK::Array_<int> faceIndices;
+	std::string cacheFile = filename + ".cache";
+	if (useCacheFile &&
+		readMeshCacheFile(cacheFile, hash, vertices, faceIndices))
+		return MeshPtr(new TriangleMesh(vertices, faceIndices, true));
+
+	SimTK::PolygonalMesh polygons;
+	std::istringstream in(contents);
+	polygons.loadObjFile(in);
+	MeshPtr mesh(new TriangleMesh(polygons));
+	if (useCacheFile)
+		writeMeshCacheFile(cacheFile, hash, *mesh);
+	return mesh;
+}
+
+std::shared_ptr<const TriangleMesh> ContactMesh::
+	acquireMesh(const std::string& filename)
+{
+	std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+	if (file.fail())
+		return std::shared_ptr<const TriangleMesh>();
+	std::string contents((std::istreambuf_iterator<char>(file)),
+		std::istreambuf_iterator<char>());
+	file.close();
+
+	unsigned long long hash = hashMeshContents(contents);
+	std::ostringstream key;
+	key << getAbsolutePath(filename) << "#" << std::hex << hash;
+
+	// Use the cached mesh, wait for another thread loading it, or claim the
+	// entry and load it here.
+	std::promise<MeshPtr> loaded;
+	std::shared_future<MeshPtr> loading;
+	bool useCacheFile = false;
+	{
+		std::lock_guard<std::mutex> lock(meshCacheMutex);
+		CachedMesh& entry = meshCache[key.str()];
+		MeshPtr mesh = entry.mesh.lock();
+		if (mesh) return mesh;
+		if (entry.loading.valid())
+			loading = entry.loading;
+		else {
+			entry.loading = loaded.get_future().share();
+			useCacheFile = useMeshCacheFiles;
+		}
+	}
+	if (loading.valid())
+		return loading.get();
+
+	MeshPtr mesh;
+	try {
+		mesh = loadTriangleMesh(filename, contents, hash, useCacheFile);
+	}
+	catch (...) {
+		{
+			std::lock_guard<std::mutex> lock(meshCacheMutex);
+			meshCache.erase(key.str());
+		}
+		loaded.set_exception(std::current_exception());
+		throw;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(meshCacheMutex);
+		CachedMesh& entry = meshCache[key.str()];
+		entry.mesh = mesh;
+		entry.loading = std::shared_future<MeshPtr>();
+
+		// Drop entries whose meshes have been released.
+		std::map<std::string, CachedMesh>::iterator it;
+		for (it = meshCache.begin(); it != meshCache.end(); ) {
+			if (it->second.mesh.expired() && !it->second.loading.valid())
+				meshCache.erase(it++);
+			else ++it;
+		}
+	}
+	loaded.set_value(mesh);
+	return mesh;
+}
+
+int ContactMesh::getNumCachedMeshes()
+{
+	std::lock_guard<std::mutex> lock(meshCacheMutex);
+	int n = 0;
+	std::map<std::string, CachedMesh>::const_iterator it;
+	for (it = meshCache.begin(); it != meshCache.end(); ++it)
+		if (!it->second.mesh.expired()) ++n;
+	return n;
+}
+
+void ContactMesh::setUseMeshCacheFiles(bool useCacheFiles)
+{
+	std::lock_guard<std::mutex> lock(meshCacheMutex);
+	useMeshCacheFiles = useCacheFiles;
+}
+
+bool ContactMesh::getUseMeshCacheFiles()
+{
+	std::lock_guard<std::mutex> lock(meshCacheMutex);
+	return useMeshCacheFiles;
+}
+
+//=============================================================================
+// CONSTRUCTION
+//=============================================================================
+
 ContactMesh::ContactMesh() :
     ContactGeometry(),
-    _filename(_filenameProp.getValueStr()),
-    _geometry(NULL)
+    _filename(_filenameProp.getValueStr())
 {
     setNull();
     setupProperties();
@@ -39,28 +259,21 @@ ContactMesh::ContactMesh() :
 
 ContactMesh::ContactMesh(const std::string& filename, const SimTK::Vec3& location, const SimTK::Vec3& orientation, Body& body) :
     ContactGeometry(location, orientation, body),
-    _filename(_filenameProp.getValueStr()),
-    _geometry(NULL)
+    _filename(_filenameProp.getValueStr())
 {
 	setNull();
 	setupProperties();
     setFilename(filename);
 	if (filename != ""){
-		std::ifstream file;
-		file.open(filename.c_str());
-		if (file.fail())
+		_geometry = acquireMesh(filename);
+		if (!_geometry)
 			throw Exception("Error loading mesh file: "+filename+". The file should exist in same folder with model.\n Model loading is aborted.");
-		SimTK::PolygonalMesh mesh;
-		mesh.loadObjFile(file);
-		file.close();
-		_geometry = new SimTK::ContactGeometry::TriangleMesh(mesh);
 	}
 }
 
 ContactMesh::ContactMesh(const std::string& filename, const SimTK::Vec3& location, const SimTK::Vec3& orientation, Body& body, const std::string& name) :
     ContactGeometry(location, orientation, body),
-    _filename(_filenameProp.getValueStr()),
-    _geometry(NULL)
+    _filename(_filenameProp.getValueStr())
 {
 	setNull();
 	setupProperties();
@@ -78,7 +291,7 @@ ContactMesh::ContactMesh(const std::string& filename, const SimTK::Vec3& locatio
 ContactMesh::ContactMesh(const ContactMesh& geom) :
     ContactGeometry(geom),
     _filename(_filenameProp.getValueStr()),
-    _geometry(NULL)
+    _geometry(geom._geometry)
 {
 	setNull();
 	setupProperties();
@@ -105,33 +318,21 @@ void ContactMesh::setFilename(const std::string& filename)
 {
     _filename = filename;
     _filenameProp.setValueIsDefault(false);
-    if (_geometry != NULL)
-        delete _geometry;
-    _geometry = NULL;
+    _geometry.reset();
 }
 
 void ContactMesh::loadMesh(const std::string& filename)
 {
-	if (_geometry==NULL){
-		SimTK::PolygonalMesh mesh;
-		std::ifstream file;
+	if (!_geometry){
 		assert (_model);
-		const std::string& savedCwd = IO::getCwd();
-		bool restoreDirectory = false;
-		if ((_model->getInputFileName()!="") && (_model->getInputFileName()!="Unassigned")) {
-			std::string parentDirectory = IO::getParentDirectory(_model->getInputFileName());
-			IO::chDir(parentDirectory);
-			restoreDirectory=true;
-		}
-		file.open(filename.c_str());
-		if (file.fail()){
-			if (restoreDirectory) IO::chDir(savedCwd);
+		// A relative mesh file name is relative to the model file.
+		std::string path = filename;
+		if (!isAbsolutePath(filename) && (_model->getInputFileName()!="") &&
+			(_model->getInputFileName()!="Unassigned"))
+			path = IO::getParentDirectory(_model->getInputFileName()) + filename;
+		_geometry = acquireMesh(path);
+		if (!_geometry)
 			throw Exception("Error loading mesh file: "+filename+". The file should exist in same folder with model.\n Loading is aborted.");
-		}
-		mesh.loadObjFile(file);
-		file.close();
-		if (restoreDirectory) IO::chDir(savedCwd);
-		_geometry = new SimTK::ContactGeometry::TriangleMesh(mesh);
 	}
 	_displayer.addGeometry(new PolyhedralGeometry(filename));
 
@@ -139,7 +340,7 @@ void ContactMesh::loadMesh(const std::string& filename)
 
 SimTK::ContactGeometry ContactMesh::createSimTKContactGeometry()
 {
-    if (_geometry == NULL)
+    if (!_geometry)
         loadMesh(_filename);
     return *_geometry;
 }
@@ -23,6 +23,7 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 // INCLUDE
+#include <memory>
 #include "ContactGeometry.h"
 
 namespace OpenSim {
@@ -30,6 +31,16 @@ namespace OpenSim {
 /**
  * This class represents a polygonal mesh for use in contact modeling.
  *
+ * Meshes are kept in a process-wide cache keyed by the path and contents of
+ * the mesh file, so all ContactMeshes (in any model or thread) that load the
+ * same file share one SimTK::ContactGeometry::TriangleMesh, and copies of a
+ * ContactMesh never reload it. A mesh is released when the last ContactMesh
+ * using it is destroyed. If mesh cache files are turned on with
+ * setUseMeshCacheFiles() (they are off by default), the triangles of a
+ * parsed mesh are also saved to a binary file next to the mesh file (the mesh
+ * file name followed by ".cache"), which later runs read instead of parsing
+ * the mesh file again.
+ *
  * @author Peter Eastman
  */
 class OSIMSIMULATION_API ContactMesh : public ContactGeometry {
@@ -39,7 +50,7 @@ OpenSim_DECLARE_CONCRETE_OBJECT(ContactMesh, ContactGeometry);
 // DATA
 //=============================================================================
 private:
-    SimTK::ContactGeometry::TriangleMesh* _geometry;
+    std::shared_ptr<const SimTK::ContactGeometry::TriangleMesh> _geometry;
 	PropertyStr _filenameProp;
     std::string& _filename;
 public:
@@ -97,6 +108,18 @@ public:
 	 * Set the name of the file to load the mesh from.
 	 */
     void setFilename(const std::string& filename);
+
+	// MESH CACHE
+	/**
+	 * Get the number of distinct meshes currently held in the mesh cache.
+	 */
+	static int getNumCachedMeshes();
+	/**
+	 * Set whether parsed meshes are saved to and read from binary cache files
+	 * next to the mesh files. The default is false.
+	 */
+	static void setUseMeshCacheFiles(bool useCacheFiles);
+	static bool getUseMeshCacheFiles();
 private:
     // INITIALIZATION
 	void setNull();
@@ -105,6 +128,12 @@ private:
      * Load the mesh from disk.
      */
     void loadMesh(const std::string& filename);
+	/**
+	 * Get the mesh for a file, parsing it only if it is not already in the
+	 * mesh cache. Returns an empty pointer if the file cannot be opened.
+	 */
+	static std::shared_ptr<const SimTK::ContactGeometry::TriangleMesh>
+		acquireMesh(const std::string& filename);
 
 //=============================================================================
 };	// END of class ContactMesh
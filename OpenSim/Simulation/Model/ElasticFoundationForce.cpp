@@ -55,11 +55,8 @@ void ElasticFoundationForce::addToSystem(SimTK::MultibodySystem& system) const
         get_contact_parameters();
 	const double& transitionVelocity = get_transition_velocity();
 
-    SimTK::GeneralContactSubsystem& contacts = system.updContactSubsystem();
-    SimTK::SimbodyMatterSubsystem& matter = system.updMatterSubsystem();
-    SimTK::ContactSetIndex set = contacts.createContactSet();
-    SimTK::ElasticFoundationForce force(_model->updForceSubsystem(), contacts, set);
-    force.setTransitionVelocity(transitionVelocity);
+    Array<ContactGeometry*> geometries;
+    Array<ContactParameters*> geometryParameters;
     for (int i = 0; i < contactParametersSet.getSize(); ++i)
     {
         ContactParameters& params = contactParametersSet.get(i);
@@ -70,24 +67,79 @@ void ElasticFoundationForce::addToSystem(SimTK::MultibodySystem& system) const
                 std::string errorMessage = "Invalid ContactGeometry (" + params.getGeometry()[j] + ") specified in ElasticFoundationForce" + getName();
 		        throw (Exception(errorMessage.c_str()));
 	        }
-	        ContactGeometry& geom = _model->updContactGeometrySet().get(params.getGeometry()[j]);
+            geometries.append(&_model->updContactGeometrySet().get(params.getGeometry()[j]));
+            geometryParameters.append(&params);
+        }
+    }
+
+    // Only geometries in the same contact set are tested against each other,
+    // so each group of geometries that may touch gets its own set and force.
+    SimTK::Array_<SimTK::Array_<int> > groups;
+    ContactGeometrySet::createContactGroups(geometries, getProperty_contact_pairs(), groups);
+    if (groups.empty())
+        groups.push_back(SimTK::Array_<int>());
+
+	// Beyond the const Component get the indices so we can access the SimTK::Forces later
+	ElasticFoundationForce* mutableThis = const_cast<ElasticFoundationForce *>(this);
+	mutableThis->_groupForceIndices.clear();
+
+    SimTK::GeneralContactSubsystem& contacts = system.updContactSubsystem();
+    SimTK::SimbodyMatterSubsystem& matter = system.updMatterSubsystem();
+    for (unsigned g = 0; g < groups.size(); ++g)
+    {
+        SimTK::ContactSetIndex set = contacts.createContactSet();
+        SimTK::ElasticFoundationForce force(_model->updForceSubsystem(), contacts, set);
+        force.setTransitionVelocity(transitionVelocity);
+        for (unsigned k = 0; k < groups[g].size(); ++k)
+        {
+            ContactGeometry& geom = *geometries[groups[g][k]];
+            const ContactParameters& params = *geometryParameters[groups[g][k]];
             contacts.addBody(set, matter.updMobilizedBody(SimTK::MobilizedBodyIndex(geom.getBody().getIndex())), geom.createSimTKContactGeometry(), geom.getTransform());
             if (dynamic_cast<ContactMesh*>(&geom) != NULL)
                 force.setBodyParameters(SimTK::ContactSurfaceIndex(contacts.getNumBodies(set)-1), 
                     params.getStiffness(), params.getDissipation(),
                     params.getStaticFriction(), params.getDynamicFriction(), params.getViscousFriction());
         }
+        if (g == 0)
+            mutableThis->_index = force.getForceIndex();
+        else
+            mutableThis->_groupForceIndices.push_back(force.getForceIndex());
     }
+}
 
-	// Beyond the const Component get the index so we can access the SimTK::Force later
-	ElasticFoundationForce* mutableThis = const_cast<ElasticFoundationForce *>(this);
-	mutableThis->_index = force.getForceIndex();
+void ElasticFoundationForce::initStateFromProperties(SimTK::State& state) const
+{
+    Super::initStateFromProperties(state);
+
+    for (unsigned g = 0; g < _groupForceIndices.size(); ++g)
+    {
+        SimTK::Force& force = _model->updForceSubsystem().updForce(_groupForceIndices[g]);
+        if (get_isDisabled())
+            force.disable(state);
+        else
+            force.enable(state);
+    }
+}
+
+void ElasticFoundationForce::setDisabled(SimTK::State& s, bool disabled) const
+{
+    Super::setDisabled(s, disabled);
+
+    for (unsigned g = 0; g < _groupForceIndices.size(); ++g)
+    {
+        SimTK::Force& force = _model->updForceSubsystem().updForce(_groupForceIndices[g]);
+        if (disabled)
+            force.disable(s);
+        else
+            force.enable(s);
+    }
 }
 
 void ElasticFoundationForce::constructProperties()
 {
 	constructProperty_contact_parameters(ContactParametersSet());
 	constructProperty_transition_velocity(0.01);
+	constructProperty_contact_pairs();
 }
 
 
@@ -177,6 +229,11 @@ void ElasticFoundationForce::addGeometry(const std::string& name)
     upd_contact_parameters()[0].addGeometry(name);
 }
 
+void ElasticFoundationForce::addContactPair(const std::string& geometry1, const std::string& geometry2)
+{
+    append_contact_pairs(geometry1 + " " + geometry2);
+}
+
 //==============================================================================
 //               ELASTIC FOUNDATION FORCE :: CONTACT PARAMETERS
 //==============================================================================
@@ -339,6 +396,15 @@ OpenSim::Array<double> ElasticFoundationForce::getRecordValues(const SimTK::Stat
 	//get the net force added to the system contributed by the Spring
 	simtkForce.calcForceContribution(state, bodyForces, particleForces, mobilityForces);
 
+	// plus the forces of the other contact sets
+	for (unsigned g = 0; g < _groupForceIndices.size(); ++g)
+	{
+		SimTK::Vector_<SimTK::SpatialVec> groupBodyForces(0);
+		_model->getForceSubsystem().getForce(_groupForceIndices[g]).
+			calcForceContribution(state, groupBodyForces, particleForces, mobilityForces);
+		bodyForces += groupBodyForces;
+	}
+
 	for (int i = 0; i < contactParametersSet.getSize(); ++i)
     {
         ContactParameters& params = contactParametersSet.get(i);
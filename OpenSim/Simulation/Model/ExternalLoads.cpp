@@ -330,6 +330,10 @@ ExternalForce* ExternalLoads::transformPointExpressedInGroundToAppliedBody(const
 		int idx = kinLabels.findIndex(coord.getName());
 		if (idx!= -1) coordinatesToColumns[qj] = idx-1;	// Since time is not accounted for
 	}*/
+
+	// Frames that already satisfy the constraints need not be reassembled
+	Model::IncrementalAssemblyGuard incremental(*_model);
+
 	for(int i=startIndex; i<=lastIndex; ++i) {
 		// transform data on an instant-by-instant basis
 		kinematics.getTime(i, time);
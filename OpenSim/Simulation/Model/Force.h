@@ -91,8 +91,9 @@ public:
 
 	/** Return if the Force is disabled or not. */
 	bool isDisabled(const SimTK::State& s) const;
-	/** Set the Force as disabled (true) or not (false). */
-	void setDisabled(SimTK::State& s, bool disabled) const;
+	/** Set the Force as disabled (true) or not (false). Forces implemented
+	by more than one SimTK::Force override this to update all of them. */
+	virtual void setDisabled(SimTK::State& s, bool disabled) const;
 
 	/**
 	 * Methods to query a Force for the value actually applied during 
@@ -46,6 +46,8 @@ void ForceAdapter::calcForce(const SimTK::State& state,
 	SimTK::Vector_<SimTK::SpatialVec>& bodyForces,SimTK::Vector_<SimTK::Vec3>& particleForces,
 	SimTK::Vector& mobilityForces) const
 {
+	ComponentProfiler::Scope profile(_force->getComponentProfiler(), *_force,
+		"computeForce");
 	_force->computeForce(state, bodyForces, mobilityForces);
 }
 
@@ -34,10 +34,15 @@
 #include <OpenSim/Simulation/Wrap/PathWrapPoint.h>
 #include <OpenSim/Simulation/Wrap/WrapResult.h>
 #include <OpenSim/Simulation/Wrap/PathWrap.h>
+#include <OpenSim/Simulation/Wrap/WrapObject.h>
 #include "CoordinateSet.h"
 #include "Model.h"
 
 #include "ModelVisualizer.h"
+#include <functional>
+#include <map>
+#include <mutex>
+#include <vector>
 //=============================================================================
 // STATICS
 //=============================================================================
@@ -48,6 +53,57 @@ using SimTK::Vec3;
 
 static const Vec3 DefaultDefaultColor(.5,.5,.5); // boring gray 
 
+//_____________________________________________________________________________
+/*
+ * Finds the ground location and velocity of the points along a path. Each
+ * point ends one segment and starts the next, but it is transformed only
+ * once, and consecutive points on the same body share the lookup of the
+ * body's transform and velocity.
+ */
+namespace {
+class PathPointKinematics {
+public:
+    PathPointKinematics(const SimTK::State& s, 
+                        const SimbodyMatterSubsystem& matter) :
+        _s(s), _matter(matter), _body(NULL), _hasVelocity(false) {}
+
+    Vec3 findLocationInGround(const PathPoint& point) {
+        updateBody(point.getBody(), false);
+        return _X_GB*point.getLocation();
+    }
+
+    // Velocity of the point in ground, including its motion on its body.
+    void findLocationAndVelocityInGround(PathPoint& point, 
+                                         Vec3& location, Vec3& velocity) {
+        updateBody(point.getBody(), true);
+        Vec3 local;
+        point.getVelocity(_s, local);
+        const Vec3 r = _X_GB.R()*point.getLocation();
+        location = _X_GB.p() + r;
+        velocity = _V_GB[1] + _V_GB[0] % r + _X_GB.R()*local;
+    }
+
+private:
+    void updateBody(const OpenSim::Body& body, bool velocity) {
+        if (&body == _body && (!velocity || _hasVelocity))
+            return;
+        const MobilizedBody& mobod = _matter.getMobilizedBody(body.getIndex());
+        _X_GB = mobod.getBodyTransform(_s);
+        if (velocity) 
+            _V_GB = mobod.getBodyVelocity(_s);
+        _hasVelocity = velocity;
+        _body = &body;
+    }
+
+    const SimTK::State& _s;
+    const SimbodyMatterSubsystem& _matter;
+    const OpenSim::Body* _body;
+    bool _hasVelocity;
+    Transform _X_GB;
+    SpatialVec _V_GB;
+};
+}
+
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
 //=============================================================================
@@ -88,6 +144,9 @@ void GeometryPath::setNull()
 {
     setAuthors("Peter Loan");
 	_maSolver = NULL;
+    _hasPathCoordinates = false;
+    _lastLength = 0.0;
+    _hasLastPath = false;
 }
 
 //_____________________________________________________________________________
@@ -108,6 +167,8 @@ void GeometryPath::connectToModel(Model& aModel) {
     // 1, 2, 3, ...).
     namePathPoints(0);
 
+    _hasPathCoordinates = _hasLastPath = false;
+
     for (int i = 0; i < get_PathWrapSet().getSize(); i++)
         upd_PathWrapSet().get(i).connectToModelAndPath(aModel, *this);
 
@@ -148,6 +209,9 @@ void GeometryPath::connectToModel(Model& aModel) {
     // and first marked valid, and we won't ever invalidate it.
     addCacheVariable<SimTK::Vec3>("color", get_default_color(), 
                                   SimTK::Stage::Topology);
+
+    // A new system has new states; do not reuse a path computed before.
+    _hasLastPath = false;
 }
 
 void GeometryPath::initStateFromProperties( SimTK::State& s) const
@@ -622,6 +686,7 @@ double GeometryPath::getPreScaleLength( const SimTK::State& s) const {
 PathPoint* GeometryPath::
 addPathPoint(const SimTK::State& s, int aIndex, OpenSim::Body& aBody)
 {
+    _hasPathCoordinates = _hasLastPath = false;
     PathPoint* newPoint = new PathPoint();
     newPoint->setBody(aBody);
     Vec3& location = newPoint->getLocation();
@@ -653,6 +718,7 @@ PathPoint* GeometryPath::
 appendNewPathPoint(const std::string& proposedName, 
                    OpenSim::Body& aBody, const SimTK::Vec3& aPositionOnBody)
 {
+    _hasPathCoordinates = _hasLastPath = false;
     PathPoint* newPoint = new PathPoint();
     newPoint->setBody(aBody);
     newPoint->setName(proposedName);
@@ -759,6 +825,7 @@ bool GeometryPath::canDeletePathPoint( int aIndex)
  */
 bool GeometryPath::deletePathPoint(const SimTK::State& s, int aIndex)
 {
+    _hasPathCoordinates = _hasLastPath = false;
     if (canDeletePathPoint(aIndex) == false)
         return false;
 
@@ -803,6 +870,7 @@ bool GeometryPath::
 replacePathPoint(const SimTK::State& s, PathPoint* aOldPathPoint, 
                  PathPoint* aNewPathPoint) 
 {
+    _hasPathCoordinates = _hasLastPath = false;
     if (aOldPathPoint != NULL && aNewPathPoint != NULL) {
         int count = 0;
         int index = get_PathPointSet().getIndex(aOldPathPoint);
@@ -840,6 +908,7 @@ replacePathPoint(const SimTK::State& s, PathPoint* aOldPathPoint,
  */
 void GeometryPath::addPathWrap(WrapObject& aWrapObject)
 {
+    _hasPathCoordinates = _hasLastPath = false;
     PathWrap* newWrap = new PathWrap();
     newWrap->setWrapObject(aWrapObject);
     newWrap->setMethod(PathWrap::hybrid);
@@ -856,6 +925,7 @@ void GeometryPath::addPathWrap(WrapObject& aWrapObject)
  */
 void GeometryPath::moveUpPathWrap(const SimTK::State& s, int aIndex)
 {
+    _hasPathCoordinates = _hasLastPath = false;
     if (aIndex > 0) {
         // Make sure wrap object is not deleted by remove().
         upd_PathWrapSet().setMemoryOwner(false); 
@@ -876,6 +946,7 @@ void GeometryPath::moveUpPathWrap(const SimTK::State& s, int aIndex)
  */
 void GeometryPath::moveDownPathWrap(const SimTK::State& s, int aIndex)
 {
+    _hasPathCoordinates = _hasLastPath = false;
     if (aIndex < get_PathWrapSet().getSize() - 1) {
         // Make sure wrap object is not deleted by remove().
         upd_PathWrapSet().setMemoryOwner(false);
@@ -895,6 +966,7 @@ void GeometryPath::moveDownPathWrap(const SimTK::State& s, int aIndex)
  */
 void GeometryPath::deletePathWrap(const SimTK::State& s, int aIndex)
 {
+    _hasPathCoordinates = _hasLastPath = false;
     upd_PathWrapSet().remove(aIndex);
 
 }
@@ -961,6 +1033,61 @@ void GeometryPath::postScale(const SimTK::State& s, const ScaleSet& aScaleSet)
 //=============================================================================
 // PATH, WRAPPING, AND MOMENT ARM
 //=============================================================================
+//_____________________________________________________________________________
+/*
+ * Copy an array into another one, reusing the memory of the destination.
+ */
+template <class T>
+static void copyArray(const Array<T>& aFrom, Array<T>& rTo)
+{
+    rTo.setSize(aFrom.getSize());
+    for (int i = 0; i < aFrom.getSize(); i++)
+        rTo[i] = aFrom[i];
+}
+
+//_____________________________________________________________________________
+/*
+ * Append the values of the numeric, boolean and string properties in a
+ * property set to an array, strings by their hash.
+ */
+static void appendPropertyValues(const PropertySet& aSet, Array<double>& rValues)
+{
+    for (int i = 0; i < aSet.getSize(); i++) {
+        const Property_Deprecated& prop = *aSet.get(i);
+        switch (prop.getType()) {
+        case Property_Deprecated::Bool:
+            rValues.append(prop.getValueBool() ? 1.0 : 0.0);
+            break;
+        case Property_Deprecated::Int:
+            rValues.append(prop.getValueInt());
+            break;
+        case Property_Deprecated::Dbl:
+            rValues.append(prop.getValueDbl());
+            break;
+        case Property_Deprecated::Str:
+            rValues.append((double)std::hash<std::string>()(prop.getValueStr()));
+            break;
+        case Property_Deprecated::IntArray: {
+            const Array<int>& values = prop.getValueIntArray();
+            for (int j = 0; j < values.getSize(); j++)
+                rValues.append(values[j]);
+            break;
+        }
+        case Property_Deprecated::DblArray:
+        case Property_Deprecated::DblVec:
+        case Property_Deprecated::DblVec3:
+        case Property_Deprecated::Transform: {
+            const Array<double>& values = prop.getValueDblArray();
+            for (int j = 0; j < values.getSize(); j++)
+                rValues.append(values[j]);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+}
+
 //_____________________________________________________________________________
 /*
  * Calculate the current path.
@@ -973,9 +1100,33 @@ void GeometryPath::computePath(const SimTK::State& s) const
         return;
     }
 
-    // Clear the current path.
     Array<PathPoint*>& currentPath = 
         updCacheVariable<Array<PathPoint*> >(s, "current_path");
+
+    // The last path is kept in this object rather than in the state, so
+    // only one thread at a time may read or replace it. The lock is only
+    // taken when the state's path is invalid, i.e. once per path and change
+    // of the state, not for every use of the path.
+    std::lock_guard<std::mutex> lock(_lastPathMutex);
+
+    // Reuse the last path if none of the coordinates, point locations and
+    // wrap properties it depends on have changed, e.g., when another joint
+    // is being moved.
+    findPathInputs(s, _pathInputs);
+    if (_hasLastPath && _pathInputs == _lastPathInputs) {
+        copyArray(_lastPath, currentPath);
+        setLength(s, _lastLength);
+        markCacheVariableValid(s, "current_path");
+        return;
+    }
+    // Forget the last path until the new one has been computed, so that a
+    // failed computation is never taken for it.
+    _hasLastPath = false;
+
+    ComponentProfiler::Scope profile(getComponentProfiler(), *this,
+        "computePath");
+
+    // Clear the current path.
     currentPath.setSize(0);
 
     // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
@@ -996,11 +1147,125 @@ void GeometryPath::computePath(const SimTK::State& s) const
     // Use the current path so far to check for intersection with wrap objects, 
     // which may add additional points to the path.
     applyWrapObjects(s, currentPath);
-    calcLengthAfterPathComputation(s, currentPath);
+    _lastLength = calcLengthAfterPathComputation(s, currentPath);
+    copyArray(currentPath, _lastPath);
+    copyArray(_pathInputs, _lastPathInputs);
+    _hasLastPath = true;
 
     markCacheVariableValid(s, "current_path");
 }
 
+//_____________________________________________________________________________
+/*
+ * Find the coordinates that can change the path. The path depends on the
+ * poses of the bodies of its points and wrap objects relative to each
+ * other, so on the joints between these bodies and their nearest common
+ * ancestor in the tree of joints, but not on the joints above it. Moving and
+ * conditional path points add the coordinates they depend on.
+ */
+void GeometryPath::findPathCoordinates() const
+{
+    _pathCoordinates.setSize(0);
+
+    // The joint connecting each body to its parent.
+    const JointSet& joints = _model->getJointSet();
+    std::map<const OpenSim::Body*, const Joint*> parentJoint;
+    for (int i = 0; i < joints.getSize(); i++)
+        parentJoint[&joints[i].getChildBody()] = &joints[i];
+
+    std::vector<const OpenSim::Body*> bodies;
+    for (int i = 0; i < get_PathPointSet().getSize(); i++) {
+        const PathPoint& point = get_PathPointSet()[i];
+        bodies.push_back(&point.getBody());
+
+        const Coordinate* coords[3] = { NULL, NULL, NULL };
+        if (const MovingPathPoint* mpp = 
+                dynamic_cast<const MovingPathPoint*>(&point)) {
+            coords[0] = mpp->getXCoordinate();
+            coords[1] = mpp->getYCoordinate();
+            coords[2] = mpp->getZCoordinate();
+        } else if (const ConditionalPathPoint* cpp = 
+                dynamic_cast<const ConditionalPathPoint*>(&point)) {
+            coords[0] = cpp->getCoordinate();
+        }
+        for (int j = 0; j < 3; j++)
+            if (coords[j] && _pathCoordinates.findIndex(coords[j]) < 0)
+                _pathCoordinates.append(coords[j]);
+    }
+    for (int i = 0; i < get_PathWrapSet().getSize(); i++) {
+        const WrapObject* wo = get_PathWrapSet()[i].getWrapObject();
+        if (wo)
+            bodies.push_back(&wo->getBody());
+    }
+
+    // The chain of joints from each body down to ground, ground first.
+    std::vector<std::vector<const Joint*> > chains(bodies.size());
+    for (size_t b = 0; b < bodies.size(); b++) {
+        const OpenSim::Body* body = bodies[b];
+        std::map<const OpenSim::Body*, const Joint*>::const_iterator it;
+        while ((it = parentJoint.find(body)) != parentJoint.end() &&
+               chains[b].size() <= parentJoint.size()) {
+            chains[b].insert(chains[b].begin(), it->second);
+            body = &it->second->getParentBody();
+        }
+    }
+
+    // Skip the joints all chains share, then take the coordinates of the
+    // remaining ones.
+    size_t common = 0;
+    bool shared = !chains.empty();
+    while (shared) {
+        for (size_t b = 0; b < chains.size() && shared; b++)
+            shared = common < chains[b].size() && 
+                     chains[b][common] == chains[0][common];
+        if (shared) common++;
+    }
+    for (size_t b = 0; b < chains.size(); b++) {
+        for (size_t j = common; j < chains[b].size(); j++) {
+            const CoordinateSet& coords = chains[b][j]->getCoordinateSet();
+            for (int c = 0; c < coords.getSize(); c++)
+                if (_pathCoordinates.findIndex(&coords[c]) < 0)
+                    _pathCoordinates.append(&coords[c]);
+        }
+    }
+
+    _hasPathCoordinates = true;
+}
+
+//_____________________________________________________________________________
+/*
+ * Get the values of the coordinates the path depends on, the locations of
+ * its fixed points, and the properties of its wrap objects, which together
+ * determine the path.
+ */
+void GeometryPath::findPathInputs(const SimTK::State& s,
+                                  Array<double>& rInputs) const
+{
+    if (!_hasPathCoordinates)
+        findPathCoordinates();
+
+    rInputs.setSize(0);
+    for (int i = 0; i < _pathCoordinates.getSize(); i++)
+        rInputs.append(_pathCoordinates[i]->getValue(s));
+    // The locations of moving points follow from the coordinates.
+    for (int i = 0; i < get_PathPointSet().getSize(); i++) {
+        const PathPoint& point = get_PathPointSet()[i];
+        if (dynamic_cast<const MovingPathPoint*>(&point))
+            continue;
+        const Vec3& location = point.getLocation();
+        for (int j = 0; j < 3; j++)
+            rInputs.append(location[j]);
+    }
+    // The geometry, placement and quadrant of the wrap objects, and the
+    // range and method of each wrap, can be edited between two states.
+    for (int i = 0; i < get_PathWrapSet().getSize(); i++) {
+        const PathWrap& pw = get_PathWrapSet()[i];
+        appendPropertyValues(pw.getPropertySet(), rInputs);
+        if (pw.getWrapObject())
+            appendPropertyValues(pw.getWrapObject()->getPropertySet(), rInputs);
+    }
+}
+
 //_____________________________________________________________________________
 /*
  * Compute lengthening speed of the path.
@@ -1013,42 +1278,29 @@ void GeometryPath::computeLengtheningSpeed(const SimTK::State& s) const
     SimTK::Vec3 posRelative, velRelative;
     SimTK::Vec3 posStartInertial, posEndInertial, 
                 velStartInertial, velEndInertial;
-    SimTK::Vec3 velStartLocal, velEndLocal, velStartMoving, velEndMoving;
-    PathPoint *start, *end;
     const Array<PathPoint*>& currentPath = getCurrentPath(s);
 
     double speed = 0.0;
 
-    const SimbodyEngine& engine = _model->getSimbodyEngine();
+    if (currentPath.getSize() < 2) {
+        setLengtheningSpeed(s, speed);
+        return;
+    }
+
+    // Find the positions and velocities in the inertial frame. The points
+    // might be moving in their local bodies' reference frames 
+    // (MovingPathPoints and possibly PathWrapPoints), which is included.
+    PathPointKinematics kinematics(s, _model->getMatterSubsystem());
+    kinematics.findLocationAndVelocityInGround(*currentPath[0], 
+        posStartInertial, velStartInertial);
 
     for (int i = 0; i < currentPath.getSize() - 1; i++) {
-        start = currentPath[i];
-        end   = currentPath[i+1];
-
-        // Find the positions and velocities in the inertial frame.
-        engine.getPosition(s, start->getBody(), start->getLocation(), 
-            posStartInertial);
-        engine.getPosition(s, end->getBody(), end->getLocation(), 
-            posEndInertial);
-        engine.getVelocity(s, start->getBody(), start->getLocation(), 
-            velStartInertial);
-        engine.getVelocity(s, end->getBody(), end->getLocation(), 
-            velEndInertial);
-
-        // The points might be moving in their local bodies' reference frames
-        // (MovingPathPoints and possibly PathWrapPoints) so find their
-        // local velocities and transform them to the inertial frame.
-        start->getVelocity(s, velStartLocal);
-        end->getVelocity(s, velEndLocal);
-        engine.transform(s, start->getBody(), velStartLocal, 
-                            engine.getGroundBody(), velStartMoving);
-        engine.transform(s, end->getBody(), velEndLocal, 
-                            engine.getGroundBody(), velEndMoving);
+        kinematics.findLocationAndVelocityInGround(*currentPath[i+1], 
+            posEndInertial, velEndInertial);
 
         // Calculate the relative positions and velocities.
         posRelative = posEndInertial - posStartInertial;
-        velRelative =   (velEndInertial + velEndMoving) 
-                      - (velStartInertial + velStartMoving);
+        velRelative = velEndInertial - velStartInertial;
 
         // Normalize the vector from start to end.
         posRelative = posRelative.normalize();
@@ -1058,6 +1310,10 @@ void GeometryPath::computeLengtheningSpeed(const SimTK::State& s) const
         speed += (velRelative[0] * posRelative[0] +
                   velRelative[1] * posRelative[1] +
                   velRelative[2] * posRelative[2]);
+
+        // The end of this segment is the start of the next.
+        posStartInertial = posEndInertial;
+        velStartInertial = velEndInertial;
     }
 
     setLengtheningSpeed(s, speed);
@@ -1182,8 +1438,17 @@ applyWrapObjects(const SimTK::State& s, Array<PathPoint*>& path) const
                         wr.startPoint = pt1;
                         wr.endPoint   = pt2;
 
+                        ComponentProfiler* profiler = getComponentProfiler();
+                        double wrapStartTime = 
+                            profiler ? ComponentProfiler::now() : 0;
                         result[i] = wo->wrapPathSegment(s, *path.get(pt1), 
                                                         *path.get(pt2), ws, wr);
+                        // Wrap objects are not Components, so their time is
+                        // recorded with the path under their own section.
+                        if (profiler)
+                            profiler->record(*this, 
+                                ("wrapPathSegment " + wo->getName()).c_str(),
+                                wrapStartTime, ComponentProfiler::now());
                         if (result[i] == WrapObject::mandatoryWrap) {
                             // "mandatoryWrap" means the path actually 
                             // intersected the wrap object. In this case, you 
@@ -1331,11 +1596,18 @@ calcLengthAfterPathComputation(const SimTK::State& s,
 {
     double length = 0.0;
 
-    const SimbodyEngine& engine = _model->getSimbodyEngine();
+    if (currentPath.getSize() < 2) {
+        setLength(s,length);
+        return( length );
+    }
+
+    PathPointKinematics kinematics(s, _model->getMatterSubsystem());
+    Vec3 p1InGround = kinematics.findLocationInGround(*currentPath[0]);
 
     for (int i = 0; i < currentPath.getSize() - 1; i++) {
         const PathPoint* p1 = currentPath[i];
         const PathPoint* p2 = currentPath[i+1];
+        const Vec3 p2InGround = kinematics.findLocationInGround(*p2);
 
         // If both points are wrap points on the same wrap object, then this
         // path segment wraps over the surface of a wrap object, so just add in 
@@ -1348,9 +1620,9 @@ calcLengthAfterPathComputation(const SimTK::State& s,
             if (smwp)
                 length += smwp->getWrapLength();
         } else {
-            length += engine.calcDistance(s, p1->getBody(), p1->getLocation(), 
-                                             p2->getBody(), p2->getLocation());
+            length += (p2InGround - p1InGround).norm();
         }
+        p1InGround = p2InGround;
     }
 
     setLength(s,length);
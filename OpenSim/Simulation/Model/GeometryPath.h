@@ -32,6 +32,7 @@
 #include "PathPointSet.h"
 #include <OpenSim/Simulation/Wrap/PathWrapSet.h>
 #include <OpenSim/Simulation/MomentArmSolver.h>
+#include <mutex>
 
 
 #ifdef SWIG
@@ -79,6 +80,32 @@ private:
 
 	// solver used to compute moment-arms
 	mutable SimTK::ReferencePtr<MomentArmSolver> _maSolver;
+
+	// Coordinates that can change the path, found on first use: those of
+	// the joints between the bodies of its points and wrap objects, and
+	// those that move or switch its points.
+	mutable Array<const Coordinate*> _pathCoordinates;
+	mutable bool _hasPathCoordinates;
+
+	// The path last computed, with the coordinate values and point locations
+	// it was computed for. It is reused while none of these have changed.
+	// It is kept here, not in the state, so computing the path of this
+	// object is serialized by _lastPathMutex; paths are computed in parallel
+	// only on separate copies of the model, which get their own mutex.
+	mutable Array<PathPoint*> _lastPath;
+	mutable double _lastLength;
+	mutable Array<double> _lastPathInputs;
+	mutable bool _hasLastPath;
+	// Buffer for the inputs of the path being computed.
+	mutable Array<double> _pathInputs;
+#ifndef SWIG
+	struct PathMutex : std::mutex {
+		PathMutex() {}
+		PathMutex(const PathMutex&) {}
+		PathMutex& operator=(const PathMutex&) { return *this; }
+	};
+	mutable PathMutex _lastPathMutex;
+#endif
 	
 //=============================================================================
 // METHODS
@@ -217,6 +244,8 @@ private:
                                 const Array<PathPoint*>& path) const; 
 	double calcLengthAfterPathComputation
        (const SimTK::State& s, const Array<PathPoint*>& currentPath) const;
+	void findPathCoordinates() const;
+	void findPathInputs(const SimTK::State& s, Array<double>& rInputs) const;
 
 
 	void setNull();
@@ -57,6 +57,10 @@ public:
 		"Material properties.");
 	OpenSim_DECLARE_PROPERTY(transition_velocity, double,
 		"Slip velocity (creep) at which peak static friction occurs.");
+	OpenSim_DECLARE_LIST_PROPERTY(contact_pairs, std::string,
+		"Pairs of geometry that may come into contact, each given as two "
+		"ContactGeometry names separated by a space. If empty, all geometry "
+		"on different bodies may come into contact.");
     /**@}**/
 
 //==============================================================================
@@ -94,6 +98,14 @@ public:
     double getViscousFriction() ;
     void setViscousFriction(double friction);
     void addGeometry(const std::string& name);
+    /**
+     * Allow the named geometries to come into contact. Once any pair is
+     * added, only the listed pairs are tested for contact.
+     */
+    void addContactPair(const std::string& geometry1, const std::string& geometry2);
+
+    /** Disable or enable the SimTK forces of all contact sets. */
+    void setDisabled(SimTK::State& s, bool disabled) const override;
 
 
 	//-----------------------------------------------------------------------------
@@ -116,10 +128,17 @@ protected:
 	void addToSystem(SimTK::MultibodySystem& system) const;
 
 
+protected:
+	void initStateFromProperties(SimTK::State& state) const override;
+
 private:
     // INITIALIZATION
 	void constructProperties();
 
+	// The SimTK forces for contact sets after the first, whose force is
+	// _index. Each contact set holds a group of geometries that may touch.
+	SimTK::Array_<SimTK::ForceIndex> _groupForceIndices;
+
 //==============================================================================
 };	// END of class HuntCrossleyForce
 //==============================================================================
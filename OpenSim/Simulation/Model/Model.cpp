@@ -90,6 +90,10 @@ Model::Model() :
     _coordinateSet(CoordinateSet()),
     _useVisualizer(false),
     _allControllersEnabled(true),
+    _useIncrementalAssembly(false),
+    _useMuscleGroupEvaluation(false),
+    _numScalingThreads(1),
+    _useProfiling(false),
     _system(NULL),
     _workingState()
 {
@@ -108,6 +112,10 @@ Model::Model(const string &aFileName, const bool finalize) :
     _coordinateSet(CoordinateSet()),
     _useVisualizer(false),
     _allControllersEnabled(true),
+    _useIncrementalAssembly(false),
+    _useMuscleGroupEvaluation(false),
+    _numScalingThreads(1),
+    _useProfiling(false),
     _system(NULL),
     _workingState()
 {	
@@ -220,6 +228,10 @@ void Model::setNull()
     _useVisualizer = false;
     _displayHints.clear();
     _allControllersEnabled = true;
+    _useIncrementalAssembly = false;
+    _useMuscleGroupEvaluation = false;
+    _numScalingThreads = 1;
+    _useProfiling = false;
     _groundBody = NULL;
 
     _system = NULL;
@@ -291,6 +303,10 @@ void Model::buildSystem() {
 	// Finish connecting up the Model.
 	setup();
 
+	// Components connected by setup() report to the profiler as well.
+	if (_useProfiling)
+		setComponentProfiler(&_profiler);
+
     // Create the computational System representing this Model.
 	createMultibodySystem();
 
@@ -401,6 +417,14 @@ void Model::assemble(SimTK::State& s, const Coordinate *coord, double weight)
 		return;
 	}
 
+	// When assembling incrementally along a trajectory, a state that already
+	// satisfies the constraints is its own assembly solution since all the
+	// coordinate goals are taken from the state itself.
+	if(_useIncrementalAssembly && isAssembled(s)){
+		getMultibodySystem().realize(s, Stage::Velocity);
+		return;
+	}
+
 	if (!_assemblySolver){
 		createAssemblySolver(s);
 	}
@@ -801,10 +825,50 @@ void Model::addToSystem(SimTK::MultibodySystem& system) const
 
 	mutableThis->_modelControlsIndex = modelControls.getSubsystemMeasureIndex();
 
+	// Group the muscles by their concrete type for group evaluation
+	mutableThis->_muscleGroups.clear();
+	const Set<Muscle>& muscles = getMuscles();
+	for(int i=0; i<muscles.getSize(); ++i){
+		const Muscle* muscle = &muscles[i];
+		unsigned int g = 0;
+		while(g < _muscleGroups.size() && 
+			_muscleGroups[g][0]->getConcreteClassName() != 
+				muscle->getConcreteClassName())
+			++g;
+		if(g == _muscleGroups.size())
+			mutableThis->_muscleGroups.push_back(
+				SimTK::Array_<const Muscle*>());
+		mutableThis->_muscleGroups[g].push_back(muscle);
+	}
+
     // Let all the ModelComponents add their parts to the System.
 	Super::addToSystem(system);
 }
 
+// The Model's realizeDynamics() is invoked before any of the forces are
+// computed, so it is the place to evaluate muscles in groups and leave the
+// results in their caches for when the muscle forces are applied.
+void Model::realizeDynamics(const SimTK::State& state) const
+{
+	Super::realizeDynamics(state);
+
+	if(!_useMuscleGroupEvaluation)
+		return;
+
+	SimTK::Array_<const Muscle*> active;
+	for(unsigned int g=0; g<_muscleGroups.size(); ++g){
+		const SimTK::Array_<const Muscle*>& group = _muscleGroups[g];
+		active.clear();
+		for(unsigned int i=0; i<group.size(); ++i){
+			if(!group[i]->isDisabled(state) && 
+			   !group[i]->isForceOverriden(state))
+				active.push_back(group[i]);
+		}
+		if(active.size() > 0)
+			active[0]->computeMuscleGroupInfo(state, active);
+	}
+}
+
 
 //_____________________________________________________________________________
 /**
@@ -1333,6 +1397,72 @@ void Model::removeController(Controller *aController)
 //--------------------------------------------------------------------------
 // SCALE
 //--------------------------------------------------------------------------
+//_____________________________________________________________________________
+/*
+ * Task that runs the pre-scale (preScale() and scale()) or post-scale pass on
+ * one contiguous chunk of the path actuators per index. An actuator only
+ * modifies its own path, but computing a path length fills cache entries of
+ * the state, so when there is more than one chunk each chunk works on its own
+ * copy of the realized state.
+ */
+class PathActuatorScaleTask : public SimTK::ParallelExecutor::Task {
+public:
+	PathActuatorScaleTask(const SimTK::Array_<PathActuator*>& actuators,
+		const SimTK::State& s, const ScaleSet& scaleSet, bool preScale,
+		int numChunks) :
+		_actuators(actuators), _s(s), _scaleSet(scaleSet), _preScale(preScale),
+		_numChunks(numChunks) {}
+
+	void execute(int chunk) {
+		int n = (int)_actuators.size();
+		int begin = (int)((long long)chunk*n/_numChunks);
+		int end = (int)((long long)(chunk+1)*n/_numChunks);
+		if (_numChunks == 1) {
+			scaleActuators(_s, begin, end);
+		}
+		else {
+			SimTK::State s = _s;
+			scaleActuators(s, begin, end);
+		}
+	}
+private:
+	void scaleActuators(const SimTK::State& s, int begin, int end) {
+		for (int i = begin; i < end; i++) {
+			PathActuator* act = _actuators[i];
+			if (_preScale) {
+				act->preScale(s, _scaleSet);
+				act->scale(s, _scaleSet);
+			}
+			else
+				act->postScale(s, _scaleSet);
+		}
+	}
+
+	const SimTK::Array_<PathActuator*>& _actuators;
+	const SimTK::State& _s;
+	const ScaleSet& _scaleSet;
+	bool _preScale;
+	int _numChunks;
+};
+
+static void scalePathActuators(const SimTK::Array_<PathActuator*>& actuators,
+	const SimTK::State& s, const ScaleSet& scaleSet, bool preScale,
+	int numThreads)
+{
+	int n = (int)actuators.size();
+	int numChunks = numThreads < n ? numThreads : n;
+	if (numChunks < 1) numChunks = 1;
+
+	PathActuatorScaleTask task(actuators, s, scaleSet, preScale, numChunks);
+	if (numChunks > 1) {
+		SimTK::ParallelExecutor executor(numChunks);
+		executor.execute(task, numChunks);
+	}
+	else {
+		task.execute(0);
+	}
+}
+
 //_____________________________________________________________________________
 /**
  * Scale the model
@@ -1347,24 +1477,25 @@ bool Model::scale(SimTK::State& s, const ScaleSet& aScaleSet, double aFinalMass,
 {
 	int i;
 
+	SimTK::Array_<PathActuator*> pathActuators;
+	for (i = 0; i < get_ForceSet().getSize(); i++) {
+        PathActuator* act = dynamic_cast<PathActuator*>(&upd_ForceSet().get(i));
+        if( act ) pathActuators.push_back(act);
+	}
+
 	// 1. Save the current pose of the model, then put it in a
 	//    default pose, so pre- and post-scale muscle lengths
 	//    can be found.
     SimTK::Vector savedConfiguration = s.getY();
 	applyDefaultConfiguration(s);
+	getMultibodySystem().realize(s, SimTK::Stage::Position);
 	// 2. For each Actuator, call its preScale method so it
 	//    can calculate and store its pre-scale length in the
 	//    current position, and then call its scale method to
 	//    scale all of the muscle properties except tendon and
 	//    fiber length.
-	for (i = 0; i < get_ForceSet().getSize(); i++)
-	{
-        PathActuator* act = dynamic_cast<PathActuator*>(&get_ForceSet().get(i));
-        if( act ) {
- 		    act->preScale(s, aScaleSet);
-		    act->scale(s, aScaleSet);
-        }
-	}
+	scalePathActuators(pathActuators, s, aScaleSet, true, _numScalingThreads);
+
 	// 3. Scale the rest of the model
 	bool returnVal = updSimbodyEngine().scale(s, aScaleSet, aFinalMass, aPreserveMassDist);
 
@@ -1383,12 +1514,8 @@ bool Model::scale(SimTK::State& s, const ScaleSet& aScaleSet, double aFinalMass,
         SimTK::State& newState = updWorkingState();
         getMultibodySystem().realize( newState, SimTK::Stage::Velocity);
 
-		for (i = 0; i < get_ForceSet().getSize(); i++) {
-            PathActuator* act = dynamic_cast<PathActuator*>(&get_ForceSet().get(i));
-            if( act ) {
-	 		    act->postScale(newState, aScaleSet);
-            }
-        }
+		scalePathActuators(pathActuators, newState, aScaleSet, false,
+			_numScalingThreads);
 
 		// 5. Put the model back in whatever pose it was in.
 
@@ -1556,6 +1683,32 @@ void Model::createAssemblySolver(const SimTK::State& s)
     _assemblySolver->setAccuracy(get_assembly_accuracy());
 }
 
+//_____________________________________________________________________________
+/**
+ * Determine if the configuration of the state satisfies the position level
+ * constraints (including coordinate locks) to within the assembly accuracy
+ * and that all clamped coordinates are within their ranges.
+ */
+bool Model::isAssembled(const SimTK::State& s) const
+{
+	getMultibodySystem().realize(s, Stage::Position);
+
+	const Vector& qerr = s.getQErr();
+	if(qerr.size() > 0 && max(abs(qerr)) > get_assembly_accuracy())
+		return false;
+
+	const CoordinateSet& coords = getCoordinateSet();
+	for(int i=0; i<coords.getSize(); ++i){
+		const Coordinate& coord = coords[i];
+		if(coord.getClamped(s)){
+			double q = coord.getValue(s);
+			if(q < coord.getRangeMin() || q > coord.getRangeMax())
+				return false;
+		}
+	}
+	return true;
+}
+
 void Model::updateAssemblyConditions(SimTK::State& s)
 {
 	createAssemblySolver(s);	
@@ -1847,6 +2000,10 @@ bool Model::getAllControllersEnabled() const{
 void Model::setAllControllersEnabled( bool enabled ) {
     _allControllersEnabled = enabled;
 }
+void Model::setUseProfiling(bool profile) {
+    _useProfiling = profile;
+    setComponentProfiler(profile ? &_profiler : NULL);
+}
 /**
  * Model::formStateStorage is intended to take any storage and populate stateStorage.
  * stateStorage is supposed to be a Storage with labels identical to those obtained by 
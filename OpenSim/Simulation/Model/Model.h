@@ -352,6 +352,73 @@ public:
      */
 	void assemble(SimTK::State& state, const Coordinate *coord = NULL, double weight = 10);
 
+	/** Request or suppress incremental assembly. When set, assemble() first
+	    checks whether the state already satisfies the constraints (to within
+	    the assembly_accuracy) and, if so, only realizes it to Velocity
+	    instead of invoking the AssemblySolver. A state that does not satisfy
+	    the constraints is assembled exactly as when the flag is off. This is
+	    intended for tools that assemble frame-by-frame along a trajectory
+	    whose frames mostly satisfy the constraints already. The default is
+	    off. */
+	void setUseIncrementalAssembly(bool incremental)
+	{	_useIncrementalAssembly = incremental; }
+	/** Return the current setting of the "use incremental assembly" flag. */
+	bool getUseIncrementalAssembly() const {return _useIncrementalAssembly;}
+
+	/** Sets the "use incremental assembly" flag of a Model for the lifetime
+	    of the guard and restores its previous value when the guard goes out
+	    of scope, also when an exception is thrown. */
+	class IncrementalAssemblyGuard {
+	public:
+		IncrementalAssemblyGuard(Model& model, bool incremental = true) :
+			_model(model), 
+			_wasIncremental(model.getUseIncrementalAssembly())
+		{	_model.setUseIncrementalAssembly(incremental); }
+		~IncrementalAssemblyGuard()
+		{	_model.setUseIncrementalAssembly(_wasIncremental); }
+	private:
+		IncrementalAssemblyGuard(const IncrementalAssemblyGuard&);
+		IncrementalAssemblyGuard& operator=(const IncrementalAssemblyGuard&);
+
+		Model& _model;
+		bool _wasIncremental;
+	};
+
+	/** Request or suppress evaluation of Muscles in groups of the same
+	    concrete type. When set, the Model computes the length, velocity and
+	    dynamics info of all enabled muscles group-by-group at the start of
+	    realizeDynamics, before any muscle forces are applied, using
+	    Muscle::computeMuscleGroupInfo(). Groups are formed during
+	    initSystem(). The default is off. */
+	void setUseMuscleGroupEvaluation(bool useGroups)
+	{	_useMuscleGroupEvaluation = useGroups; }
+	/** Return the current setting of the "use muscle group evaluation" flag. */
+	bool getUseMuscleGroupEvaluation() const 
+	{	return _useMuscleGroupEvaluation; }
+
+	/** Set the number of threads used by scale() for the per-actuator
+	    pre-scale and post-scale path length passes. The actuators are split
+	    into one chunk per thread, and each chunk computes its path lengths
+	    in its own copy of the realized state. The default is 1 (serial). */
+	void setNumScalingThreads(int numThreads)
+	{	_numScalingThreads = numThreads < 1 ? 1 : numThreads; }
+	/** Return the number of threads used by scale(). */
+	int getNumScalingThreads() const { return _numScalingThreads; }
+
+	/** Request or suppress profiling of the Model's components. When set,
+	    each component records its calls and wall time in
+	    computeStateVariableDerivatives(), computeForce(), computePath() and
+	    calcMuscleDynamicsInfo() with the Model's profiler, whose results can
+	    be printed as a table or a Chrome trace, for example after
+	    Manager::integrate(). Takes effect immediately and again at
+	    initSystem(). The default is off. */
+	void setUseProfiling(bool profile);
+	/** Return the current setting of the "use profiling" flag. */
+	bool getUseProfiling() const {return _useProfiling;}
+	/** Get the profiler holding the calls recorded while profiling. */
+	const ComponentProfiler& getProfiler() const {return _profiler;}
+	ComponentProfiler& updProfiler() {return _profiler;}
+
 
     /**
      * Update the state of all Muscles so they are in equilibrium.
@@ -875,6 +942,7 @@ public:
 	void connectToModel(Model& model)  override;
 	void addToSystem(SimTK::MultibodySystem& system) const override; 
     void initStateFromProperties(SimTK::State& state) const override;
+	void realizeDynamics(const SimTK::State& state) const override;
 
 	/**
      * Given a State, set all default values for this Model to match those 
@@ -911,6 +979,10 @@ private:
 
 	void createAssemblySolver(const SimTK::State& s);
 
+	// Test whether the configuration in s already satisfies the position
+	// constraints and coordinate ranges so that assembly can be skipped.
+	bool isAssembled(const SimTK::State& s) const;
+
     // To provide access to private _modelComponents member.
 	friend class Component; 
 
@@ -975,6 +1047,25 @@ private:
     // Global flag used to disable all Controllers.
 	bool _allControllersEnabled;
 
+    // If this flag is set, assemble() skips the AssemblySolver for states
+    // that already satisfy the constraints and otherwise tracks from the
+    // previous solution.
+    bool _useIncrementalAssembly;
+
+    // If this flag is set, muscles are evaluated in groups of the same
+    // concrete type during realizeDynamics().
+    bool _useMuscleGroupEvaluation;
+
+    // Number of threads used for the path actuator passes in scale().
+    int _numScalingThreads;
+
+    // If this flag is set, the components report to _profiler.
+    bool _useProfiling;
+    ComponentProfiler _profiler;
+
+    // Muscles grouped by concrete type, formed in addToSystem().
+    SimTK::Array_< SimTK::Array_<const Muscle*> > _muscleGroups;
+
 
     //                      SIMBODY MULTIBODY SYSTEM
 	// The model owns the MultibodySystem, but the
@@ -129,44 +129,47 @@ void Muscle::constructOutputs()
                             SimTK::Stage::Dynamics);
     constructOutput<double>("activation", &Muscle::getActivation,
                             SimTK::Stage::Dynamics);
+    // The fiber length and velocity of a muscle may be state variables,
+    // which Simbody only invalidates at Dynamics, so the outputs below that
+    // can be evaluated at Position or Velocity are not cached in the State.
     constructOutput<double>("fiber_length", &Muscle::getFiberLength,
-                            SimTK::Stage::Position);
+                            SimTK::Stage::Position, false);
     constructOutput<double>("pennation_angle", &Muscle::getPennationAngle,
-                            SimTK::Stage::Position);
+                            SimTK::Stage::Position, false);
     constructOutput<double>("cos_pennation_angle", &Muscle::getCosPennationAngle,
-                            SimTK::Stage::Position);
+                            SimTK::Stage::Position, false);
     constructOutput<double>("tendon_length", &Muscle::getTendonLength,
-                            SimTK::Stage::Position);
+                            SimTK::Stage::Position, false);
     constructOutput<double>("normalized_fiber_length",
                             &Muscle::getNormalizedFiberLength,
-                            SimTK::Stage::Position);
+                            SimTK::Stage::Position, false);
     constructOutput<double>("fiber_length_along_tendon",
                             &Muscle::getFiberLengthAlongTendon,
-                            SimTK::Stage::Position);
+                            SimTK::Stage::Position, false);
     constructOutput<double>("tendon_strain", &Muscle::getTendonStrain,
-                            SimTK::Stage::Position);
+                            SimTK::Stage::Position, false);
     constructOutput<double>("passive_force_multiplier",
                             &Muscle::getPassiveForceMultiplier,
-                            SimTK::Stage::Position);
+                            SimTK::Stage::Position, false);
     constructOutput<double>("active_force_length_multiplier",
                             &Muscle::getActiveForceLengthMultiplier,
-                            SimTK::Stage::Position);
+                            SimTK::Stage::Position, false);
     constructOutput<double>("fiber_velocity", &Muscle::getFiberVelocity,
-                            SimTK::Stage::Velocity);
+                            SimTK::Stage::Velocity, false);
     constructOutput<double>("normalized_fiber_velocity",
                             &Muscle::getNormalizedFiberVelocity,
-                            SimTK::Stage::Velocity);
+                            SimTK::Stage::Velocity, false);
     constructOutput<double>("fiber_velocity_along_tendon",
                             &Muscle::getFiberVelocityAlongTendon,
-                            SimTK::Stage::Velocity);
+                            SimTK::Stage::Velocity, false);
     constructOutput<double>("tendon_velocity", &Muscle::getTendonVelocity,
-                            SimTK::Stage::Velocity);
+                            SimTK::Stage::Velocity, false);
     constructOutput<double>("force_velocity_multiplier",
                             &Muscle::getForceVelocityMultiplier,
-                            SimTK::Stage::Velocity);
+                            SimTK::Stage::Velocity, false);
     constructOutput<double>("pennation_angular_velocity",
                             &Muscle::getPennationAngularVelocity,
-                            SimTK::Stage::Velocity);
+                            SimTK::Stage::Velocity, false);
     constructOutput<double>("fiber_force", &Muscle::getFiberForce,
                             SimTK::Stage::Dynamics);
     constructOutput<double>("fiber_force_along_tendon",
@@ -595,7 +598,11 @@ getMuscleDynamicsInfo(const SimTK::State& s) const
 {
 	if(!isCacheVariableValid(s,"dynamicsInfo")){
 		MuscleDynamicsInfo& umdi = updMuscleDynamicsInfo(s);
-		calcMuscleDynamicsInfo(s, umdi);
+		{
+			ComponentProfiler::Scope profile(getComponentProfiler(), *this,
+				"calcMuscleDynamicsInfo");
+			calcMuscleDynamicsInfo(s, umdi);
+		}
 		markCacheVariableValid(s,"dynamicsInfo");
 		// don't bother fishing it out of the cache since 
 		// we just calculated it and still have a handle on it
@@ -609,6 +616,31 @@ updMuscleDynamicsInfo(const SimTK::State& s) const
 	return updCacheVariable<MuscleDynamicsInfo>(s, "dynamicsInfo");
 }
 
+void Muscle::markMuscleLengthInfoValid(const SimTK::State& s) const
+{
+	markCacheVariableValid(s,"lengthInfo");
+}
+
+void Muscle::markFiberVelocityInfoValid(const SimTK::State& s) const
+{
+	markCacheVariableValid(s,"velInfo");
+}
+
+void Muscle::markMuscleDynamicsInfoValid(const SimTK::State& s) const
+{
+	markCacheVariableValid(s,"dynamicsInfo");
+}
+
+/* Evaluate a group of muscles of the same type. By default each muscle is
+   evaluated independently; the dynamics info pulls in the length and velocity
+   info it depends on. */
+void Muscle::computeMuscleGroupInfo(const SimTK::State& s,
+	const SimTK::Array_<const Muscle*>& group) const
+{
+	for(unsigned int i=0; i<group.size(); ++i)
+		group[i]->getMuscleDynamicsInfo(s);
+}
+
 const Muscle::MusclePotentialEnergyInfo& Muscle::
 getMusclePotentialEnergyInfo(const SimTK::State& s) const
 {
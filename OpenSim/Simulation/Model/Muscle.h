@@ -267,6 +267,18 @@ public:
     virtual double calcInextensibleTendonActiveFiberForce(SimTK::State& s, 
                                                   double aActivation) const;
     ///@endcond
+
+	/** Compute and cache the length, fiber velocity and dynamics info of a
+	    group of muscles that all share this muscle's concrete type. The Model
+	    invokes this on the first muscle of each group during realizeDynamics()
+	    when muscle group evaluation is enabled (see
+	    Model::setUseMuscleGroupEvaluation()). The default implementation
+	    evaluates each muscle of the group in turn. Muscle models with
+	    closed-form calculations may override it to compute the three infos
+	    of each muscle in one pass, handing the intermediate values on
+	    directly instead of reading them back from the cache. */
+	virtual void computeMuscleGroupInfo(const SimTK::State& s,
+		const SimTK::Array_<const Muscle*>& group) const;
 //=============================================================================
 // PROTECTED METHODS
 //=============================================================================
@@ -289,6 +301,12 @@ protected:
 	const MusclePotentialEnergyInfo& getMusclePotentialEnergyInfo(const SimTK::State& s) const;
 	MusclePotentialEnergyInfo& updMusclePotentialEnergyInfo(const SimTK::State& s) const;
 
+	/** Mark the intermediate values valid after they have been filled in
+	    directly through the upd methods, e.g. by computeMuscleGroupInfo() */
+	void markMuscleLengthInfoValid(const SimTK::State& s) const;
+	void markFiberVelocityInfoValid(const SimTK::State& s) const;
+	void markMuscleDynamicsInfoValid(const SimTK::State& s) const;
+
 	//--------------------------------------------------------------------------
 	// CALCULATIONS
 	//--------------------------------------------------------------------------
@@ -229,7 +229,6 @@ void PrescribedForce::computeForce(const SimTK::State& state,
 
 	double time = state.getTime();
 	const SimbodyEngine& engine = getModel().getSimbodyEngine();
-	SimTK::Vector  timeAsVector(1, time);
 
     const bool hasForceFunctions  = forceFunctions.getSize()==3;
     const bool hasPointFunctions  = pointFunctions.getSize()==3;
@@ -237,18 +236,18 @@ void PrescribedForce::computeForce(const SimTK::State& state,
 
 	assert(_body!=0);
 	if (hasForceFunctions) {
-		Vec3 force(forceFunctions[0].calcValue(timeAsVector), 
-			       forceFunctions[1].calcValue(timeAsVector), 
-			       forceFunctions[2].calcValue(timeAsVector));
+		Vec3 force(forceFunctions[0].calcValue(time), 
+			       forceFunctions[1].calcValue(time), 
+			       forceFunctions[2].calcValue(time));
 		if (!forceIsGlobal)
 			engine.transform(state, *_body,                 force, 
                                     engine.getGroundBody(), force);
         Vec3 point(0); // Default is body origin.
 		if (hasPointFunctions) {
             // Apply force to a specified point on the body.
-			point = Vec3(pointFunctions[0].calcValue(timeAsVector), 
-				         pointFunctions[1].calcValue(timeAsVector), 
-				         pointFunctions[2].calcValue(timeAsVector));
+			point = Vec3(pointFunctions[0].calcValue(time), 
+				         pointFunctions[1].calcValue(time), 
+				         pointFunctions[2].calcValue(time));
 			if (pointIsGlobal)
 				engine.transformPosition(state, engine.getGroundBody(), point,
                                                 *_body,                 point);
@@ -256,9 +255,9 @@ void PrescribedForce::computeForce(const SimTK::State& state,
 		applyForceToPoint(state, *_body, point, force, bodyForces);
 	}
 	if (hasTorqueFunctions){
-		Vec3 torque(torqueFunctions[0].calcValue(timeAsVector), 
-			        torqueFunctions[1].calcValue(timeAsVector), 
-			        torqueFunctions[2].calcValue(timeAsVector));
+		Vec3 torque(torqueFunctions[0].calcValue(time), 
+			        torqueFunctions[1].calcValue(time), 
+			        torqueFunctions[2].calcValue(time));
 		if (!forceIsGlobal)
 			engine.transform(state, *_body,                 torque, 
                                     engine.getGroundBody(), torque);
@@ -276,10 +275,9 @@ Vec3 PrescribedForce::getForceAtTime(double aTime) const
     if (forceFunctions.getSize() != 3)
         return Vec3(0);
 
-	const SimTK::Vector timeAsVector(1, aTime);
-	const Vec3 force(forceFunctions[0].calcValue(timeAsVector), 
-		             forceFunctions[1].calcValue(timeAsVector), 
-		             forceFunctions[2].calcValue(timeAsVector));
+	const Vec3 force(forceFunctions[0].calcValue(aTime), 
+		             forceFunctions[1].calcValue(aTime), 
+		             forceFunctions[2].calcValue(aTime));
 	return force;
 }
 
@@ -290,10 +288,9 @@ Vec3 PrescribedForce::getPointAtTime(double aTime) const
     if (pointFunctions.getSize() != 3)
         return Vec3(0);
 
-	const SimTK::Vector timeAsVector(1, aTime);
-	const Vec3 point(pointFunctions[0].calcValue(timeAsVector), 
-		             pointFunctions[1].calcValue(timeAsVector), 
-		             pointFunctions[2].calcValue(timeAsVector));
+	const Vec3 point(pointFunctions[0].calcValue(aTime), 
+		             pointFunctions[1].calcValue(aTime), 
+		             pointFunctions[2].calcValue(aTime));
 	return point;
 }
 
@@ -304,10 +301,9 @@ Vec3 PrescribedForce::getTorqueAtTime(double aTime) const
     if (torqueFunctions.getSize() != 3)
         return Vec3(0);
 
-	const SimTK::Vector timeAsVector(1, aTime);
-	const Vec3 torque(torqueFunctions[0].calcValue(timeAsVector), 
-		              torqueFunctions[1].calcValue(timeAsVector), 
-		              torqueFunctions[2].calcValue(timeAsVector));
+	const Vec3 torque(torqueFunctions[0].calcValue(aTime), 
+		              torqueFunctions[1].calcValue(aTime), 
+		              torqueFunctions[2].calcValue(aTime));
 	return torque;
 }
 
@@ -369,12 +365,11 @@ OpenSim::Array<double> PrescribedForce::getRecordValues(const SimTK::State& stat
 	// This is bad as it duplicates the code in computeForce we'll cleanup after it works!
 	const double time = state.getTime();
 	const SimbodyEngine& engine = getModel().getSimbodyEngine();
-	const SimTK::Vector timeAsVector(1, time);
 
 	if (appliesForce) {
-	    Vec3 force(forceFunctions[0].calcValue(timeAsVector), 
-		           forceFunctions[1].calcValue(timeAsVector), 
-		           forceFunctions[2].calcValue(timeAsVector));
+	    Vec3 force(forceFunctions[0].calcValue(time), 
+		           forceFunctions[1].calcValue(time), 
+		           forceFunctions[2].calcValue(time));
 		if (!forceIsGlobal)
 			engine.transform(state, *_body, force, 
                              engine.getGroundBody(), force);
@@ -382,9 +377,9 @@ OpenSim::Array<double> PrescribedForce::getRecordValues(const SimTK::State& stat
 			//applyForce(*_body, force);
 			for (int i=0; i<3; i++) values.append(force[i]);
 	    } else {
-	        Vec3 point(pointFunctions[0].calcValue(timeAsVector), 
-		               pointFunctions[1].calcValue(timeAsVector), 
-		               pointFunctions[2].calcValue(timeAsVector));
+	        Vec3 point(pointFunctions[0].calcValue(time), 
+		               pointFunctions[1].calcValue(time), 
+		               pointFunctions[2].calcValue(time));
 			if (pointIsGlobal)
 				engine.transformPosition(state, engine.getGroundBody(), point, 
                                          *_body, point);
@@ -394,9 +389,9 @@ OpenSim::Array<double> PrescribedForce::getRecordValues(const SimTK::State& stat
 		}
 	}
 	if (appliesTorque) {
-	    Vec3 torque(torqueFunctions[0].calcValue(timeAsVector), 
-		            torqueFunctions[1].calcValue(timeAsVector), 
-		            torqueFunctions[2].calcValue(timeAsVector));
+	    Vec3 torque(torqueFunctions[0].calcValue(time), 
+		            torqueFunctions[1].calcValue(time), 
+		            torqueFunctions[2].calcValue(time));
 		if (!forceIsGlobal)
 			engine.transform(state, *_body, torque, 
                              engine.getGroundBody(), torque);
@@ -28,6 +28,7 @@
 #include <OpenSim/Common/Function.h>
 #include <OpenSim/Simulation/SimbodyEngine/Joint.h>
 #include <OpenSim/Simulation/Model/Model.h>
+#include <memory>
 
 // Helper class to construct functions when user's specify a dependency as qd = f(qi)
 // this function casts as C(q) = 0 = f(qi) - qd;
@@ -36,19 +37,21 @@
     /// @cond
 class CompoundFunction : public SimTK::Function {
 // returns f1(x[0]) - x[1];
+// f1 is evaluated through its scalar methods, so no temporary Vector or
+// derivative component list is needed per call. It is a copy of the
+// constraint's function, so it stays valid if that property is replaced or
+// the constraint is copied.
 private:
-	const SimTK::Function *f1;
+	std::unique_ptr<const OpenSim::Function> f1;
     const double scale;
 
 public:
 	
-	CompoundFunction(const SimTK::Function *cf, double scale) : f1(cf), scale(scale) {
+	CompoundFunction(const OpenSim::Function& cf, double scale) : f1(cf.clone()), scale(scale) {
 	}
 
     double calcValue(const SimTK::Vector& x) const {
-		SimTK::Vector xf(1);
-		xf[0] = x[0];
-		return scale*f1->calcValue(xf)-x[1];
+		return scale*f1->calcValue(x[0])-x[1];
     }
 
 	double calcDerivative(const std::vector<int>& derivComponents, const SimTK::Vector& x) const {
@@ -57,20 +60,14 @@ public:
 
 	double calcDerivative(const SimTK::Array_<int>& derivComponents, const SimTK::Vector& x) const {
 		if (derivComponents.size() == 1){
-			if (derivComponents[0]==0){
-				SimTK::Vector x1(1);
-				x1[0] = x[0];
-				return scale*f1->calcDerivative(derivComponents, x1);
-			}
+			if (derivComponents[0]==0)
+				return scale*f1->calcDerivative(x[0], 1);
 			else if (derivComponents[0]==1)
 				return -1;
 		}
 		else if(derivComponents.size() == 2){
-			if (derivComponents[0]==0 && derivComponents[1] == 0){
-				SimTK::Vector x1(1);
-				x1[0] = x[0];
-				return scale*f1->calcDerivative(derivComponents, x1);
-			}
+			if (derivComponents[0]==0 && derivComponents[1] == 0)
+				return scale*f1->calcDerivative(x[0], 2);
 		}
         return 0;
     }
@@ -82,7 +79,7 @@ public:
         return 2;
     }
 
-	void setFunction(const SimTK::Function *cf) {
+	void setFunction(const OpenSim::Function *cf) {
 		f1 = cf;
 	}
 };
@@ -225,7 +222,7 @@ void CoordinateCouplerConstraint::addToSystem(SimTK::MultibodySystem& system) co
 
 	// Create and set the underlying coupler constraint function;
 	const Function& f = get_coupled_coordinates_function();
-	SimTK::Function *simtkCouplerFunction = new CompoundFunction(f.createSimTKFunction(), get_scale_factor());
+	SimTK::Function *simtkCouplerFunction = new CompoundFunction(f, get_scale_factor());
 
 
 	// Now create a Simbody Constraint::CoordinateCoupler
@@ -857,6 +857,7 @@ formCompleteStorages( const SimTK::State& s, const OpenSim::Storage &aQIn,
 	rUComplete = new Storage();
     State constrainedState = s;
      _model->getMultibodySystem().realize(constrainedState, s.getSystemStage());
+	Model::IncrementalAssemblyGuard incremental(*_model);
 	for(i=0;i<size;i++) {
 		qStore->getTime(i,time);
 		qStore->getData(i,nq,&qu[0]);
@@ -34,6 +34,7 @@ using namespace std;
 
 void testAssembleModelWithConstraints(string modelFile);
 void testAssemblySatisfiesConstraints(string modelFile);
+void testIncrementalAssembly(string modelFile);
 double calcLigamentLengthError(const SimTK::State &s, const Model &model);
 
 int main()
@@ -41,6 +42,7 @@ int main()
 	try {
 		LoadOpenSimLibrary("osimActuators");
 		testAssemblySatisfiesConstraints("knee_patella_ligament.osim");
+		testIncrementalAssembly("knee_patella_ligament.osim");
 		testAssembleModelWithConstraints("PushUpToesOnGroundExactConstraints.osim");
 		testAssembleModelWithConstraints("PushUpToesOnGroundLessPreciseConstraints.osim");
 		testAssembleModelWithConstraints("PushUpToesOnGroundWithMuscles.osim");
@@ -303,6 +305,40 @@ void testAssemblySatisfiesConstraints(string modelFile)
 	}
 }
 
+void testIncrementalAssembly(string modelFile)
+{
+	using namespace SimTK;
+
+	cout << "****************************************************************************" << endl;
+	cout << " testIncrementalAssembly :: "<< modelFile << endl;
+	cout << "****************************************************************************\n" << endl;
+
+	Model model(modelFile);
+	model.set_assembly_accuracy(1e-8);
+	model.setUseIncrementalAssembly(true);
+
+	State& state = model.initSystem();
+	const CoordinateSet &coords = model.getCoordinateSet();
+
+	// An assembled state should pass through untouched
+	Vector q0 = state.getQ();
+	model.assemble(state);
+	ASSERT_EQUAL(0.0, (state.getQ()-q0).norm(), SimTK::Eps,
+		__FILE__, __LINE__, "Incremental assembly changed an assembled state");
+
+	// Sweep the knee as a trajectory would, frame-by-frame
+	int N = 100;
+	double lower = -2*Pi/3, upper = Pi/18;
+	double delta = (upper-lower)/N;
+
+	for(int i=0; i<N; ++i){
+		coords[0].setValue(state, upper-i*delta, true);
+		double cerr = calcLigamentLengthError(state, model);
+		ASSERT_EQUAL(0.0, cerr, model.get_assembly_accuracy(),
+			__FILE__, __LINE__, "Incremental assembly did NOT satisfy constraints");
+	}
+}
+
 double calcLigamentLengthError(const SimTK::State &s, const Model &model)
 {
 	using namespace SimTK;
@@ -0,0 +1,130 @@
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  testComponentProfiler.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2014 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+#include <OpenSim/Simulation/Manager/Manager.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Common/LoadOpenSimLibrary.h>
+#include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+#include <fstream>
+
+using namespace OpenSim;
+using namespace std;
+
+//==============================================================================
+// testProfiling checks that a profiled Model records the forces, paths and
+// muscles of the model during a simulation, and that nothing is recorded
+// when profiling is off.
+//==============================================================================
+void testProfiling(const string& modelFile);
+
+int main()
+{
+	try {
+		LoadOpenSimLibrary("osimActuators");
+		testProfiling("arm26.osim");
+	}
+	catch (const std::exception& e) {
+        cout << "testComponentProfiler failed: " << e.what() << endl;
+        return 1;
+    }
+    cout << "Done" << endl;
+    return 0;
+}
+
+static void simulate(Model& model, double finalTime)
+{
+	SimTK::State& s = model.initSystem();
+	model.equilibrateMuscles(s);
+
+	SimTK::RungeKuttaMersonIntegrator integrator(model.getMultibodySystem());
+	integrator.setAccuracy(1.0e-4);
+	Manager manager(model, integrator);
+	manager.setInitialTime(0.0);
+	manager.setFinalTime(finalTime);
+	manager.integrate(s);
+}
+
+void testProfiling(const string& modelFile)
+{
+	// Not profiled: nothing is recorded.
+	Model plain(modelFile);
+	simulate(plain, 0.05);
+	ASSERT(plain.getProfiler().getNumEntries() == 0, __FILE__, __LINE__,
+		"testProfiling: calls were recorded with profiling off.");
+
+	// Profiled.
+	Model model(modelFile);
+	model.setUseProfiling(true);
+	simulate(model, 0.05);
+
+	const ComponentProfiler& profiler = model.getProfiler();
+	vector<ComponentProfiler::Entry> entries = profiler.getEntries();
+	profiler.printTable(cout);
+
+	bool force = false, path = false, muscle = false, derivs = false;
+	for (size_t i = 0; i < entries.size(); ++i) {
+		const ComponentProfiler::Entry& e = entries[i];
+		ASSERT(e.count > 0 && e.total >= 0 && e.max <= e.total,
+			__FILE__, __LINE__, "testProfiling: inconsistent totals.");
+		if (i > 0)
+			ASSERT(entries[i-1].total >= e.total, __FILE__, __LINE__,
+				"testProfiling: entries not ordered by total time.");
+		force  |= e.section == "computeForce";
+		path   |= e.section == "computePath";
+		muscle |= e.section == "calcMuscleDynamicsInfo";
+		derivs |= e.section == "computeStateVariableDerivatives";
+	}
+	ASSERT(force && path && muscle && derivs, __FILE__, __LINE__,
+		"testProfiling: an instrumented section was not recorded.");
+
+	// The muscles of the model each have an entry for computeForce.
+	for (int m = 0; m < model.getMuscles().getSize(); ++m) {
+		const string& name = model.getMuscles()[m].getName();
+		bool found = false;
+		for (size_t i = 0; i < entries.size() && !found; ++i)
+			found = entries[i].component == name &&
+				    entries[i].section == "computeForce";
+		ASSERT(found, __FILE__, __LINE__,
+			"testProfiling: no computeForce entry for muscle " + name);
+	}
+
+	// The trace holds one event per recorded call, up to the limit.
+	ASSERT(profiler.printChromeTrace("arm26_profile_trace.json"),
+		__FILE__, __LINE__, "testProfiling: failed to write the trace.");
+	ifstream trace("arm26_profile_trace.json");
+	string line;
+	int events = 0;
+	while (getline(trace, line))
+		if (line.find("\"ph\": \"X\"") != string::npos) ++events;
+	long long calls = 0;
+	for (size_t i = 0; i < entries.size(); ++i) calls += entries[i].count;
+	long long expected = calls < profiler.getMaxTraceEvents() ?
+		calls : profiler.getMaxTraceEvents();
+	ASSERT(events == expected, __FILE__, __LINE__,
+		"testProfiling: trace does not hold the recorded calls.");
+
+	// Turning profiling off stops recording; clear() discards the results.
+	model.setUseProfiling(false);
+	model.updProfiler().clear();
+	simulate(model, 0.01);
+	ASSERT(model.getProfiler().getNumEntries() == 0, __FILE__, __LINE__,
+		"testProfiling: calls were recorded after profiling was turned off.");
+}
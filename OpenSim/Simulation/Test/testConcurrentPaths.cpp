@@ -0,0 +1,165 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  testConcurrentPaths.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2012 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+//=============================================================================
+// testConcurrentPaths computes wrapped muscle paths on many threads at once,
+// each thread working on its own copy of a model, and checks that every
+// thread gets exactly the lengths computed serially.
+//
+//	Tests Include:
+//      1. arm26 muscles wrapping over cylinders and ellipsoids
+//      2. arm26 with the long head of the biceps also wrapping over a torus
+//
+//=============================================================================
+#include <OpenSim/Simulation/osimSimulation.h>
+#include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+
+using namespace OpenSim;
+using namespace std;
+
+// Number of model copies processed concurrently and poses per copy.
+const static int numThreads = 8;
+const static int numPoses = 50;
+const static int numRepeats = 20;
+
+//_____________________________________________________________________________
+// Set the model's coordinates to pose k and realize positions.
+static void setPose(const Model& model, SimTK::State& s,
+					const SimTK::Matrix& poses, int k)
+{
+	const CoordinateSet& coords = model.getCoordinateSet();
+	for (int j = 0; j < coords.getSize(); ++j)
+		coords[j].setValue(s, poses(k,j), false);
+	model.getMultibodySystem().realize(s, SimTK::Stage::Position);
+}
+
+//_____________________________________________________________________________
+// Compute all muscle lengths over all poses on one model copy per index and
+// count the lengths that differ from the serial ones.
+class PathLengthTask : public SimTK::ParallelExecutor::Task {
+public:
+	PathLengthTask(const Array<Model*>& models, const SimTK::Matrix& poses,
+		const SimTK::Matrix& expected, Array<int>& mismatches) :
+		_models(models), _poses(poses), _expected(expected),
+		_mismatches(mismatches) {}
+
+	void execute(int index) {
+		Model& model = *_models[index];
+		SimTK::State& s = model.updWorkingState();
+		const Set<Muscle>& muscles = model.getMuscles();
+		int count = 0;
+		for (int r = 0; r < numRepeats; ++r) {
+			for (int k = 0; k < _poses.nrow(); ++k) {
+				setPose(model, s, _poses, k);
+				for (int m = 0; m < muscles.getSize(); ++m)
+					if (muscles[m].getLength(s) != _expected(k,m)) ++count;
+			}
+		}
+		_mismatches[index] = count;
+	}
+private:
+	const Array<Model*>& _models;
+	const SimTK::Matrix& _poses;
+	const SimTK::Matrix& _expected;
+	Array<int>& _mismatches;
+};
+
+//_____________________________________________________________________________
+// Wrap the long head of the biceps over a torus on the humerus as well, so
+// that the torus closest point solve runs concurrently too.
+static void addTorusWrap(Model& model)
+{
+	model.initSystem();
+	Body& humerus = model.updBodySet().get("r_humerus");
+	WrapTorus* torus = new WrapTorus();
+	torus->setName("BIClongtorus");
+	torus->getPropertySet().get("inner_radius")->setValue(0.02);
+	torus->getPropertySet().get("outer_radius")->setValue(0.06);
+	humerus.addWrapObject(torus);
+	torus->connectToModelAndBody(model, humerus);
+	model.updMuscles().get("BIClong").updGeometryPath().addPathWrap(*torus);
+}
+
+void testConcurrentPathLengths(Model& model, const string& label)
+{
+	SimTK::State& s = model.initSystem();
+	const CoordinateSet& coords = model.getCoordinateSet();
+	const Set<Muscle>& muscles = model.getMuscles();
+
+	// Poses spread over the range of every coordinate
+	SimTK::Matrix poses(numPoses, coords.getSize());
+	for (int k = 0; k < numPoses; ++k) {
+		for (int j = 0; j < coords.getSize(); ++j) {
+			double w = (double)((k*(j+1)) % numPoses)/(numPoses-1);
+			poses(k,j) = coords[j].getRangeMin() +
+				w*(coords[j].getRangeMax() - coords[j].getRangeMin());
+		}
+	}
+
+	// Serial reference lengths
+	SimTK::Matrix expected(numPoses, muscles.getSize());
+	for (int k = 0; k < numPoses; ++k) {
+		setPose(model, s, poses, k);
+		for (int m = 0; m < muscles.getSize(); ++m)
+			expected(k,m) = muscles[m].getLength(s);
+	}
+
+	// Independent copies, one per thread
+	Array<Model*> copies;
+	for (int i = 0; i < numThreads; ++i) {
+		copies.append(new Model(model));
+		copies[i]->initSystem();
+	}
+
+	Array<int> mismatches(-1, numThreads);
+	PathLengthTask task(copies, poses, expected, mismatches);
+	SimTK::ParallelExecutor executor(numThreads);
+	executor.execute(task, numThreads);
+
+	for (int i = 0; i < numThreads; ++i) {
+		ASSERT(mismatches[i] == 0, __FILE__, __LINE__,
+			"Concurrent path lengths differ from serial ones for " + label);
+		delete copies[i];
+	}
+}
+
+int main()
+{
+	LoadOpenSimLibrary("osimActuators");
+
+	try {
+		Model arm("arm26.osim");
+		testConcurrentPathLengths(arm, "arm26");
+		cout << "Concurrent wrapped paths of arm26: PASSED\n" << endl;
+
+		Model torusArm("arm26.osim");
+		addTorusWrap(torusArm);
+		testConcurrentPathLengths(torusArm, "arm26 with a torus");
+		cout << "Concurrent torus wrapped paths of arm26: PASSED\n" << endl;
+	}
+	catch (const Exception& e) {
+		e.print(cerr);
+		return 1;
+	}
+	cout << "Done" << endl;
+	return 0;
+}
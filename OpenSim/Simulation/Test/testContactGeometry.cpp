@@ -34,6 +34,7 @@
 //
 //==========================================================================================================
 #include <iostream>
+#include <fstream>
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Common/Exception.h>
 
@@ -73,6 +74,8 @@ const static string mesh_file = "sphere_10cm_radius.obj"; //"10_5_cm_sphere_4770
 int testBouncingBall(bool useMesh);
 int testBallToBallContact(bool useElasticFoundation, bool useMesh1, bool useMesh2);
 void compareHertzAndMeshContactResults();
+void testMeshCache();
+void testContactGroups();
 
 int main()
 {
@@ -85,6 +88,8 @@ int main()
 		testBallToBallContact(true, false, true);
 		testBallToBallContact(true, true, true); 
 		compareHertzAndMeshContactResults();
+		testMeshCache();
+		testContactGroups();
     }
     catch (const OpenSim::Exception& e) {
         e.print(cerr);
@@ -341,3 +346,141 @@ void compareHertzAndMeshContactResults()
 	CHECK_STORAGE_AGAINST_STANDARD(noMeshToMesh, meshToNoMesh, rms_tols_3, __FILE__, __LINE__, "ElasticFoundation noMesh-Mesh FAILED to match Mesh-noMesh Case ");
 
 }
+
+void testMeshCache()
+{
+	OpenSim::Body body;
+	body.setName("body");
+	// Use a mesh the other tests do not load, as their models keep theirs.
+	string meshFile = "sphere.obj";
+	string cacheFile = meshFile + ".cache";
+	remove(cacheFile.c_str());
+	int numCached = ContactMesh::getNumCachedMeshes();
+
+	// Cache files are only written on request.
+	ASSERT(!ContactMesh::getUseMeshCacheFiles(), __FILE__, __LINE__, 
+		"Mesh cache files are used by default.");
+	{
+		ContactMesh mesh(meshFile, Vec3(0), Vec3(0), body);
+	}
+	ASSERT(!ifstream(cacheFile.c_str()).good(), __FILE__, __LINE__, 
+		"Mesh cache file was written without being requested.");
+	ContactMesh::setUseMeshCacheFiles(true);
+
+	// Meshes loaded from the same file share one geometry, as do copies.
+	SimTK::ContactGeometry parsed;
+	{
+		ContactMesh mesh1(meshFile, Vec3(0), Vec3(0), body);
+		ContactMesh mesh2(meshFile, Vec3(0), Vec3(0), body);
+		ContactMesh copy(mesh1);
+		ASSERT(ContactMesh::getNumCachedMeshes() == numCached+1, __FILE__, __LINE__, 
+			"Meshes from the same file were not shared.");
+		parsed = copy.createSimTKContactGeometry();
+	}
+	ASSERT(ContactMesh::getNumCachedMeshes() == numCached, __FILE__, __LINE__, 
+		"Mesh was not released with the last ContactMesh using it.");
+	ASSERT(ifstream(cacheFile.c_str()).good(), __FILE__, __LINE__, 
+		"Mesh cache file was not written.");
+
+	// Reloading reads the cache file and must give the same triangles.
+	ContactMesh cached(meshFile, Vec3(0), Vec3(0), body);
+	SimTK::ContactGeometry reloaded = cached.createSimTKContactGeometry();
+	const SimTK::ContactGeometry::TriangleMesh& a = SimTK::ContactGeometry::TriangleMesh::getAs(parsed);
+	const SimTK::ContactGeometry::TriangleMesh& b = SimTK::ContactGeometry::TriangleMesh::getAs(reloaded);
+	ASSERT(a.getNumVertices() == b.getNumVertices() && a.getNumFaces() == b.getNumFaces(),
+		__FILE__, __LINE__, "Cached mesh size does not match the mesh file.");
+	for (int i = 0; i < a.getNumVertices(); ++i)
+		ASSERT(a.getVertexPosition(i) == b.getVertexPosition(i), __FILE__, __LINE__, 
+			"Cached mesh vertex does not match the mesh file.");
+	for (int i = 0; i < a.getNumFaces(); ++i)
+		for (int j = 0; j < 3; ++j)
+			ASSERT(a.getFaceVertex(i, j) == b.getFaceVertex(i, j), __FILE__, __LINE__, 
+				"Cached mesh face does not match the mesh file.");
+
+	ContactMesh::setUseMeshCacheFiles(false);
+	remove(cacheFile.c_str());
+	cout << "Mesh cache test passed" << endl;
+}
+
+void testContactGroups()
+{
+	OpenSim::Body body1, body2, body3;
+	body1.setName("body1");
+	body2.setName("body2");
+	body3.setName("body3");
+	ContactSphere a(radius, Vec3(0), body1, "a");
+	ContactSphere b(radius, Vec3(0), body2, "b");
+	ContactSphere c(radius, Vec3(0), body3, "c");
+	ContactSphere d(radius, Vec3(0), body1, "d");
+
+	Array<ContactGeometry*> geometries;
+	geometries.append(&a);
+	geometries.append(&b);
+	geometries.append(&c);
+	SimTK::Array_<SimTK::Array_<int> > groups;
+
+	// Geometries on different bodies all share one contact set.
+	OpenSim::HuntCrossleyForce all;
+	ContactGeometrySet::createContactGroups(geometries, all.getProperty_contact_pairs(), groups);
+	ASSERT(groups.size() == 1 && groups[0].size() == 3, __FILE__, __LINE__, 
+		"Expected a single contact set for geometries on different bodies.");
+
+	// Without contact pairs geometries on the same body stay in the single
+	// set too, since Simbody does not test them against each other.
+	geometries.append(&d);
+	ContactGeometrySet::createContactGroups(geometries, all.getProperty_contact_pairs(), groups);
+	ASSERT(groups.size() == 1 && groups[0].size() == 4, __FILE__, __LINE__, 
+		"Expected a single contact set without contact pairs.");
+
+	// Pairs that enable everything that can touch keep the single set.
+	OpenSim::HuntCrossleyForce everything;
+	everything.addContactPair("a", "b");
+	everything.addContactPair("a", "c");
+	everything.addContactPair("b", "c");
+	everything.addContactPair("b", "d");
+	everything.addContactPair("c", "d");
+	ContactGeometrySet::createContactGroups(geometries, everything.getProperty_contact_pairs(), groups);
+	ASSERT(groups.size() == 1 && groups[0].size() == 4, __FILE__, __LINE__, 
+		"Expected a single contact set when no pair is excluded.");
+
+	// Excluding 'b'-'c' splits the sets so that each enabled pair appears in
+	// exactly one set and 'b' and 'c' never share one.
+	OpenSim::HuntCrossleyForce split;
+	split.addContactPair("a", "b");
+	split.addContactPair("a", "c");
+	split.addContactPair("b", "d");
+	split.addContactPair("c", "d");
+	ContactGeometrySet::createContactGroups(geometries, split.getProperty_contact_pairs(), groups);
+	SimTK::Array_<int> count(16, 0);
+	for (unsigned g = 0; g < groups.size(); ++g)
+		for (unsigned i = 0; i < groups[g].size(); ++i)
+			for (unsigned j = i+1; j < groups[g].size(); ++j) {
+				int m = groups[g][i], n = groups[g][j];
+				count[m*4+n]++; count[n*4+m]++;
+			}
+	ASSERT(count[1*4+2] == 0, __FILE__, __LINE__, 
+		"An excluded pair of geometries was placed in one contact set.");
+	const int enabled[4][2] = { {0,1}, {0,2}, {1,3}, {2,3} };
+	for (int p = 0; p < 4; ++p)
+		ASSERT(count[enabled[p][0]*4+enabled[p][1]] == 1, __FILE__, __LINE__, 
+			"An enabled pair of geometries was not placed in exactly one contact set.");
+
+	// Only the enabled pairs are tested.
+	OpenSim::HuntCrossleyForce masked;
+	masked.addContactPair("a", "c");
+	ContactGeometrySet::createContactGroups(geometries, masked.getProperty_contact_pairs(), groups);
+	ASSERT(groups.size() == 1 && groups[0].size() == 2 && groups[0][0] == 0 && groups[0][1] == 2,
+		__FILE__, __LINE__, "Enabled contact pair was not honored.");
+
+	// Pairs must name geometries the force uses.
+	masked.addContactPair("a", "nowhere");
+	bool rejected = false;
+	try {
+		ContactGeometrySet::createContactGroups(geometries, masked.getProperty_contact_pairs(), groups);
+	} catch (const OpenSim::Exception&) {
+		rejected = true;
+	}
+	ASSERT(rejected, __FILE__, __LINE__, "Invalid contact pair was accepted.");
+
+	cout << "Contact groups test passed" << endl;
+}
@@ -550,6 +550,62 @@ void testSpringMass()
 		manager.setInitialTime(dt*i);
 	}
 
+	// Report at a fixed interval rather than after every integrator step.
+	// The reported states are interpolated and must still follow the
+	// analytical solution.
+	slider_coords[0].setValue(osim_state, start_h);
+	slider_coords[0].setSpeedValue(osim_state, 0.0);
+	RungeKuttaMersonIntegrator integrator2(osimModel->getMultibodySystem() );
+	integrator2.setAccuracy(1e-7);
+	Manager reportManager(*osimModel, integrator2);
+	double reportInterval = 0.05;
+	reportManager.setReportingInterval(reportInterval);
+	reportManager.setInitialTime(0.0);
+	reportManager.setFinalTime(final_t);
+	reportManager.integrate(osim_state);
+
+	const Storage& states = reportManager.getStateStorage();
+	int nReports = (int)(final_t/reportInterval + 0.5) + 1;
+	ASSERT(states.getSize() == nReports);
+	for(int i = 0; i < states.getSize(); i++){
+		const StateVector& row = *states.getStateVector(i);
+		ASSERT_EQUAL(i*reportInterval, row.getTime(), 1e-10);
+		double height = (start_h-dh)*cos(omega*row.getTime())+dh;
+		ASSERT_EQUAL(height, row.getData()[0], 1e-5);
+	}
+
+	// Checkpoint the first half of the motion, then resume from the
+	// checkpoint in a state whose coordinates have been cleared.
+	slider_coords[0].setValue(osim_state, start_h);
+	slider_coords[0].setSpeedValue(osim_state, 0.0);
+	RungeKuttaMersonIntegrator integrator3(osimModel->getMultibodySystem() );
+	integrator3.setAccuracy(1e-7);
+	Manager checkpointManager(*osimModel, integrator3);
+	string checkpointFile = "testForces_SpringMass.ckpt";
+	checkpointManager.setCheckpointFile(checkpointFile, 0.1);
+	checkpointManager.setInitialTime(0.0);
+	checkpointManager.setFinalTime(final_t/2);
+	checkpointManager.integrate(osim_state);
+
+	SimTK::State resumed = osim_state;
+	resumed.updQ() = 0;
+	resumed.updU() = 0;
+	RungeKuttaMersonIntegrator integrator4(osimModel->getMultibodySystem() );
+	integrator4.setAccuracy(1e-7);
+	Manager resumeManager(*osimModel, integrator4);
+	resumeManager.setFinalTime(final_t);
+	int resumeStep = resumeManager.readCheckpoint(resumed, checkpointFile);
+	ASSERT(resumeStep > 0);
+	ASSERT(resumed.getTime() > 0 && resumed.getTime() <= final_t/2);
+	ASSERT_EQUAL(resumed.getTime(), resumeManager.getInitialTime(), 0.0);
+	double height = (start_h-dh)*cos(omega*resumed.getTime())+dh;
+	ASSERT_EQUAL(height, resumed.getQ()[0], 1e-5);
+
+	resumeManager.doIntegration(resumed, resumeStep, 1.0e-6);
+	height = (start_h-dh)*cos(omega*final_t)+dh;
+	ASSERT_EQUAL(final_t, resumed.getTime(), 1e-10);
+	ASSERT_EQUAL(height, resumed.getQ()[0], 1e-5);
+
 	// Save the forces
 	osimModel->disownAllComponents();
 
@@ -0,0 +1,174 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  testIncrementalPaths.cpp                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2014 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+//=============================================================================
+// testIncrementalPaths sweeps one coordinate at a time through its range and
+// checks that paths which do not depend on it are reused rather than
+// recomputed, and that every path length equals the one computed from
+// scratch.
+//
+//	Tests Include:
+//      1. arm26 shoulder and elbow sweeps
+//
+//=============================================================================
+#include <OpenSim/Simulation/osimSimulation.h>
+#include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+
+using namespace OpenSim;
+using namespace std;
+
+const static int numSteps = 20;
+
+// Number of times the path of a muscle has been computed. The paths are
+// named after their muscles by testSweep().
+static long long countComputePath(const Model& model, const string& muscle)
+{
+	vector<ComponentProfiler::Entry> entries = model.getProfiler().getEntries();
+	for (size_t i = 0; i < entries.size(); ++i)
+		if (entries[i].section == "computePath" &&
+			entries[i].component == muscle + "_path")
+			return entries[i].count;
+	return 0;
+}
+
+//_____________________________________________________________________________
+// Sweep one coordinate with the others fixed. The reference lengths come from
+// a second model on which every pose is preceded by a change of all
+// coordinates, so that each of its paths is computed from scratch.
+static void testSweep(const string& modelFile, const string& swept,
+					  const Array<string>& dependent,
+					  const Array<string>& independent)
+{
+	Model model(modelFile);
+	for (int m = 0; m < model.getMuscles().getSize(); ++m) {
+		Muscle& muscle = model.updMuscles()[m];
+		muscle.updGeometryPath().setName(muscle.getName() + "_path");
+	}
+	model.setUseProfiling(true);
+	SimTK::State& s = model.initSystem();
+	Model reference(modelFile);
+	SimTK::State& rs = reference.initSystem();
+
+	const Coordinate& coord = model.getCoordinateSet().get(swept);
+	const Set<Muscle>& muscles = model.getMuscles();
+	const Set<Muscle>& rmuscles = reference.getMuscles();
+	const CoordinateSet& rcoords = reference.getCoordinateSet();
+
+	for (int k = 0; k < numSteps; ++k) {
+		double value = coord.getRangeMin() + 
+			k*(coord.getRangeMax() - coord.getRangeMin())/(numSteps-1);
+
+		coord.setValue(s, value, false);
+		model.getMultibodySystem().realize(s, SimTK::Stage::Position);
+
+		for (int j = 0; j < rcoords.getSize(); ++j) {
+			const Coordinate& c = rcoords[j];
+			double mid = 0.5*(c.getRangeMin() + c.getRangeMax());
+			double q = c.getValue(rs);
+			c.setValue(rs, q < mid ? q + 0.1 : q - 0.1, false);
+		}
+		reference.getMultibodySystem().realize(rs, SimTK::Stage::Position);
+		for (int m = 0; m < rmuscles.getSize(); ++m)
+			rmuscles[m].getLength(rs);
+		for (int j = 0; j < rcoords.getSize(); ++j)
+			rcoords[j].setValue(rs, model.getCoordinateSet()[j].getValue(s),
+								false);
+		reference.getMultibodySystem().realize(rs, SimTK::Stage::Position);
+
+		for (int m = 0; m < muscles.getSize(); ++m)
+			ASSERT_EQUAL(rmuscles[m].getLength(rs), muscles[m].getLength(s),
+				1.0e-12, __FILE__, __LINE__, "testSweep: " + muscles[m].getName() +
+				" length differs from the one computed from scratch.");
+	}
+
+	// The first pose computes every path; after that only the paths that
+	// depend on the swept coordinate are computed.
+	for (int i = 0; i < dependent.getSize(); ++i)
+		ASSERT(countComputePath(model, dependent[i]) >= numSteps, 
+			__FILE__, __LINE__, "testSweep: path of " + dependent[i] +
+			" was not recomputed while sweeping " + swept);
+	for (int i = 0; i < independent.getSize(); ++i)
+		ASSERT(countComputePath(model, independent[i]) == 1, 
+			__FILE__, __LINE__, "testSweep: path of " + independent[i] +
+			" was recomputed while sweeping " + swept);
+}
+
+//_____________________________________________________________________________
+// Edit the radius of a wrap object between two evaluations of the same pose.
+// The path must not be reused, and must match that of a model in which the
+// radius was edited before its system was created.
+static void testWrapEdit(const string& modelFile)
+{
+	const double radius = 0.03, elbow = 1.5;
+
+	Model model(modelFile);
+	SimTK::State& s = model.initSystem();
+	model.getCoordinateSet().get("r_elbow_flex").setValue(s, elbow, false);
+	model.getMultibodySystem().realize(s, SimTK::Stage::Position);
+	const Muscle& muscle = model.getMuscles().get("TRIlat");
+	double before = muscle.getLength(s);
+
+	model.updBodySet().get("r_humerus").upd_WrapObjectSet().get("TRI")
+		.getPropertySet().get("radius")->setValue(radius);
+	s.invalidateAll(SimTK::Stage::Position);
+	model.getMultibodySystem().realize(s, SimTK::Stage::Position);
+	double after = muscle.getLength(s);
+
+	Model reference(modelFile);
+	reference.updBodySet().get("r_humerus").upd_WrapObjectSet().get("TRI")
+		.getPropertySet().get("radius")->setValue(radius);
+	SimTK::State& rs = reference.initSystem();
+	reference.getCoordinateSet().get("r_elbow_flex").setValue(rs, elbow, false);
+	reference.getMultibodySystem().realize(rs, SimTK::Stage::Position);
+
+	ASSERT(after != before, __FILE__, __LINE__,
+		"testWrapEdit: TRIlat length did not change with the TRI radius.");
+	ASSERT_EQUAL(reference.getMuscles().get("TRIlat").getLength(rs), after,
+		1.0e-12, __FILE__, __LINE__,
+		"testWrapEdit: TRIlat length differs from the one computed from scratch.");
+}
+
+int main()
+{
+	LoadOpenSimLibrary("osimActuators");
+
+	try {
+		// TRIlat, TRImed and BRA run from the humerus to the forearm, so
+		// they do not depend on the shoulder.
+		Array<string> elbowOnly, twoJoint, all;
+		elbowOnly.append("TRIlat"); elbowOnly.append("TRImed");
+		elbowOnly.append("BRA");
+		twoJoint.append("TRIlong"); twoJoint.append("BIClong");
+		twoJoint.append("BICshort");
+		all = twoJoint; all.append(elbowOnly);
+
+		testSweep("arm26.osim", "r_shoulder_elev", twoJoint, elbowOnly);
+		testSweep("arm26.osim", "r_elbow_flex", all, Array<string>());
+		testWrapEdit("arm26.osim");
+		cout << "Incremental paths of arm26: PASSED\n" << endl;
+	}
+	catch (const Exception& e) {
+		e.print(cerr);
+		return 1;
+	}
+	cout << "Done" << endl;
+	return 0;
+}
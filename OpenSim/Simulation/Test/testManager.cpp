@@ -0,0 +1,86 @@
+/* -------------------------------------------------------------------------- *
+ *                         OpenSim:  testManager.cpp                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2014 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+#include <OpenSim/Simulation/Manager/Manager.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Common/LoadOpenSimLibrary.h>
+#include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+#include <memory>
+
+using namespace OpenSim;
+using namespace std;
+
+//==============================================================================
+// testCreateIntegrator checks that Manager::createIntegrator() builds the
+// integrator named by a ForwardTool setup and rejects unknown names.
+//==============================================================================
+void testCreateIntegrator();
+
+int main()
+{
+	try {
+		LoadOpenSimLibrary("osimActuators");
+		testCreateIntegrator();
+	}
+	catch (const std::exception& e) {
+		cout << "testManager failed: " << e.what() << endl;
+		return 1;
+	}
+	cout << "Done" << endl;
+	return 0;
+}
+
+void testCreateIntegrator()
+{
+	Model model("arm26.osim");
+	SimTK::State& s = model.initSystem();
+	model.equilibrateMuscles(s);
+
+	// A non-default integrator integrates the model.
+	std::unique_ptr<SimTK::Integrator> integ(
+		Manager::createIntegrator("CPodes", model.getMultibodySystem()));
+	ASSERT(dynamic_cast<SimTK::CPodesIntegrator*>(integ.get()) != NULL,
+		__FILE__, __LINE__,
+		"testCreateIntegrator: CPodes did not create a CPodesIntegrator.");
+	integ->setAccuracy(1.0e-4);
+
+	Manager manager(model, *integ);
+	manager.setInitialTime(0.0);
+	manager.setFinalTime(0.05);
+	manager.integrate(s);
+	ASSERT_EQUAL(0.05, s.getTime(), 1.0e-12, __FILE__, __LINE__,
+		"testCreateIntegrator: CPodes integration did not reach the final time.");
+
+	// An unknown name is an error.
+	bool threw = false;
+	try {
+		std::unique_ptr<SimTK::Integrator> unknown(
+			Manager::createIntegrator("NoSuchIntegrator",
+				model.getMultibodySystem()));
+	}
+	catch (const OpenSim::Exception&) {
+		threw = true;
+	}
+	ASSERT(threw, __FILE__, __LINE__,
+		"testCreateIntegrator: an unknown integrator name was accepted.");
+
+	cout << "Manager::createIntegrator: PASSED" << endl;
+}
@@ -0,0 +1,89 @@
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  testParallelLoading.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2014 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+#include <OpenSim/Simulation/osimSimulation.h>
+#include <OpenSim/Common/LoadOpenSimLibrary.h>
+#include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+#include <fstream>
+#include <sstream>
+
+using namespace OpenSim;
+using namespace std;
+
+//==============================================================================
+// testParallelLoading checks that a model read with parallel deserialization
+// is identical to the model read serially, both as written back to XML and
+// in the muscle lengths of its default state.
+//==============================================================================
+void testParallelLoading(const string& modelFile);
+
+int main()
+{
+	try {
+		LoadOpenSimLibrary("osimActuators");
+		testParallelLoading("gait2354_simbody.osim");
+		testParallelLoading("arm26.osim");
+	}
+	catch (const std::exception& e) {
+		cout << "testParallelLoading failed: " << e.what() << endl;
+		return 1;
+	}
+	cout << "Done" << endl;
+	return 0;
+}
+
+static string readFile(const string& fileName)
+{
+	ifstream in(fileName.c_str());
+	stringstream contents;
+	contents << in.rdbuf();
+	return contents.str();
+}
+
+void testParallelLoading(const string& modelFile)
+{
+	Object::setUseParallelDeserialization(false);
+	Model serial(modelFile);
+	serial.print("serial_" + modelFile);
+
+	Object::setUseParallelDeserialization(true);
+	Model parallel(modelFile);
+	Object::setUseParallelDeserialization(false);
+	parallel.print("parallel_" + modelFile);
+
+	ASSERT(readFile("serial_" + modelFile) == readFile("parallel_" + modelFile),
+		__FILE__, __LINE__,
+		"testParallelLoading: " + modelFile + " was read differently.");
+
+	const SimTK::State& s1 = serial.initSystem();
+	const SimTK::State& s2 = parallel.initSystem();
+	ASSERT(serial.getMuscles().getSize() == parallel.getMuscles().getSize(),
+		__FILE__, __LINE__, "testParallelLoading: muscles differ.");
+	for (int m = 0; m < serial.getMuscles().getSize(); ++m) {
+		ASSERT(serial.getMuscles()[m].getName() ==
+			   parallel.getMuscles()[m].getName(), __FILE__, __LINE__,
+			   "testParallelLoading: muscles are in a different order.");
+		ASSERT_EQUAL(serial.getMuscles()[m].getLength(s1),
+			parallel.getMuscles()[m].getLength(s2), 0.0, __FILE__, __LINE__,
+			"testParallelLoading: muscle lengths differ.");
+	}
+	cout << "Parallel loading of " << modelFile << ": PASSED" << endl;
+}
@@ -36,6 +36,7 @@
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Analyses/MuscleAnalysis.h>
 #include <OpenSim/Analyses/ProbeReporter.h>
+#include <OpenSim/Analyses/OutputReporter.h>
 #include <OpenSim/Analyses/ForceReporter.h>
 
 #include <OpenSim/Simulation/Model/ActuatorPowerProbe.h>
@@ -491,6 +492,11 @@ void simulateMuscle(
     model.addAnalysis(forceReporter);
     MuscleAnalysis* muscleReporter = new MuscleAnalysis(&model);
     model.addAnalysis(muscleReporter);
+    OutputReporter* outputReporter = new OutputReporter(&model);
+    outputReporter->addOutputPath("ActuatorForce/probe_outputs");
+    outputReporter->addOutputPath("muscle/fiber_force");
+    outputReporter->addOutputPath("com_position");
+    model.addAnalysis(outputReporter);
     model.print("testProbesModel.osim");
     model.printBasicInfo(cout);
    
@@ -589,6 +595,24 @@ void simulateMuscle(
         cout << "\nDone with printing results..." << endl;
     }
 
+    // The OutputReporter must have recorded the same rows as the
+    // ProbeReporter, ending with the values at the final state.
+    const Storage& probeStore = probeReporter->getProbeStorage();
+    int nProbeOutputs = forceProbe->getProbeOutputLabels().getSize();
+    ASSERT(outputReporter->getColumnLabels().getSize() == 1+nProbeOutputs+1+3,
+        __FILE__, __LINE__, "OutputReporter has the wrong number of columns.");
+    int nRows = outputReporter->getNumRows();
+    ASSERT(nRows == probeStore.getSize(), __FILE__, __LINE__,
+        "OutputReporter recorded the wrong number of rows.");
+    const SimTK::Matrix& outputTable = outputReporter->getTable();
+    for (int i=0; i<nRows; ++i)
+        ASSERT_EQUAL(probeStore.getStateVector(i)->getTime(), outputTable(i,0),
+            1e-12, __FILE__, __LINE__, "OutputReporter recorded the wrong time.");
+    ASSERT_EQUAL(forceProbe->getProbeOutputs(si)(0), outputTable(nRows-1,1),
+        1e-8, __FILE__, __LINE__, "OutputReporter recorded the wrong probe value.");
+    if(printResults == true)
+        outputReporter->printResults("testProbes");
+
     double muscleWork = muscWorkProbe->getProbeOutputs(si)(0);
     cout << "Muscle work = " << muscleWork << endl;
 
@@ -0,0 +1,113 @@
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  testStreamResults.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2014 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+#include <OpenSim/Simulation/Manager/Manager.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Analyses/BodyKinematics.h>
+#include <OpenSim/Common/LoadOpenSimLibrary.h>
+#include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+
+using namespace OpenSim;
+using namespace std;
+
+//==============================================================================
+// testStreamResults checks that the results of analyses streamed to disk
+// with AnalysisSet::setStreamResults() read back the same as the results of
+// the same simulation printed from memory.
+//==============================================================================
+void testStreamResults(const string& modelFile);
+
+int main()
+{
+	try {
+		LoadOpenSimLibrary("osimActuators");
+		testStreamResults("arm26.osim");
+	}
+	catch (const std::exception& e) {
+		cout << "testStreamResults failed: " << e.what() << endl;
+		return 1;
+	}
+	cout << "Done" << endl;
+	return 0;
+}
+
+// Simulate the model with BodyKinematics and print its results under
+// aBaseName. If aMaxRowsInMemory is positive, the results are streamed.
+static void simulate(const string& modelFile, const string& aBaseName,
+					 int aMaxRowsInMemory)
+{
+	Model model(modelFile);
+	BodyKinematics* kinematics = new BodyKinematics(&model);
+	model.addAnalysis(kinematics);
+	if (aMaxRowsInMemory > 0)
+		model.updAnalysisSet().setStreamResults(".", aMaxRowsInMemory);
+
+	SimTK::State& s = model.initSystem();
+	model.equilibrateMuscles(s);
+
+	SimTK::RungeKuttaMersonIntegrator integrator(model.getMultibodySystem());
+	integrator.setAccuracy(1.0e-5);
+	Manager manager(model, integrator);
+	manager.setInitialTime(0.0);
+	manager.setFinalTime(0.2);
+	manager.integrate(s);
+
+	if (aMaxRowsInMemory > 0)
+		ASSERT(kinematics->getPositionStorage()->getSize() <= 2*aMaxRowsInMemory,
+			__FILE__, __LINE__,
+			"testStreamResults: streamed rows were not released from memory.");
+
+	model.updAnalysisSet().printResults(aBaseName, ".");
+}
+
+void testStreamResults(const string& modelFile)
+{
+	simulate(modelFile, "inMemory", 0);
+	simulate(modelFile, "streamed", 5);
+
+	const char* results[] = { "_BodyKinematics_pos_global.sto",
+		"_BodyKinematics_vel_global.sto", "_BodyKinematics_acc_global.sto" };
+	for (int r = 0; r < 3; ++r) {
+		Storage inMemory(string("inMemory") + results[r]);
+		Storage streamed(string("streamed") + results[r]);
+
+		ASSERT(inMemory.getSize() > 20, __FILE__, __LINE__,
+			"testStreamResults: the simulation recorded too few rows.");
+		ASSERT(inMemory.getSize() == streamed.getSize(), __FILE__, __LINE__,
+			"testStreamResults: streamed results have a different number of rows.");
+		ASSERT(inMemory.getColumnLabels() == streamed.getColumnLabels(),
+			__FILE__, __LINE__,
+			"testStreamResults: streamed results have different columns.");
+
+		for (int i = 0; i < inMemory.getSize(); ++i) {
+			StateVector* a = inMemory.getStateVector(i);
+			StateVector* b = streamed.getStateVector(i);
+			ASSERT(a->getTime() == b->getTime(), __FILE__, __LINE__,
+				"testStreamResults: streamed results have different times.");
+			ASSERT(a->getSize() == b->getSize(), __FILE__, __LINE__,
+				"testStreamResults: streamed rows have a different size.");
+			for (int j = 0; j < a->getSize(); ++j)
+				ASSERT(a->getData()[j] == b->getData()[j], __FILE__, __LINE__,
+					"testStreamResults: streamed results differ from memory.");
+		}
+	}
+	cout << "Streaming results of " << modelFile << ": PASSED" << endl;
+}
@@ -41,8 +41,8 @@ using namespace OpenSim;
 using SimTK::Vec3;
 
 static const char* wrapTypeName = "cylinder";
-static Vec3 p0(0.0, 0.0, -1.0);
-static Vec3 dn(0.0, 0.0, 1.0);
+static const Vec3 p0(0.0, 0.0, -1.0);
+static const Vec3 dn(0.0, 0.0, 1.0);
 #define MAX_ITERATIONS    100
 #define TANGENCY_THRESHOLD (0.1 * SimTK_DEGREE_TO_RADIAN) // find tangency to within 1 degree
 
@@ -832,7 +832,7 @@ void WrapCylinder::_calc_spiral_wrap_point(const SimTK::Vec3& r1a,
  * @return Whether or not the point was adjusted
  */
 bool WrapCylinder::_adjust_tangent_point(SimTK::Vec3& pt1,
-													  SimTK::Vec3& dn,
+													  const SimTK::Vec3& dn,
 													  SimTK::Vec3& r1,
 													  SimTK::Vec3& w1) const
 {
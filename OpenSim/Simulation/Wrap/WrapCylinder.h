@@ -111,7 +111,7 @@ private:
 
 
 	bool _adjust_tangent_point(SimTK::Vec3& pt1,
-													  SimTK::Vec3& dn,
+													  const SimTK::Vec3& dn,
 													  SimTK::Vec3& r1,
 													  SimTK::Vec3& w1) const;
 
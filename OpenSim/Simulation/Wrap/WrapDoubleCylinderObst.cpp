@@ -405,22 +405,11 @@ static int load_Rxyz(double q[3],double Rxyz[9]) {
 /*===========================================================================*/
 /*====== SOLVE THE SYSTEM OF LINEAR EQUATIONS:  A(NxN)*X(Nx1)=B(Nx1) ========*/
 /*===========================================================================*/
-static int quick_solve_linear(int N,double A[],double X[],double B[]) {
-	static double *MTX=NULL,**Mtx=NULL;
-	static int mtxsize=0;
+static int quick_solve_linear(int N,double A[],double X[],double B[],
+	double MTX[],double *Mtx[]) {
 	double **Mr,*Mrj,*Mij,*Xr,*Br,d;
 	int r,i,j,n;
 
-	/*====================================================================*/
-	/*======= ALLOCATE STORAGE FOR DUPLICATE OF A AND ROW POINTERS =======*/
-	/*====================================================================*/
-	if(mtxsize<N*(N+1)) {	mtxsize=N*(N+1);
-		MTX=(double *)  malloc(mtxsize*sizeof(double));
-		Mtx=(double **) malloc(N*sizeof(double *));
-		if(Mtx==NULL) { fprintf(stderr,"\nOut of memory.\n\n"); exit(0); }
-	}
-	/*====================================================================*/
-
 	/*====================================================================*/
 	/*== COPY A INTO MTX(NxN), B INTO MTX(N+1), AND LOAD POINTER VECTOR ==*/
 	/*====================================================================*/
@@ -469,6 +458,21 @@ static int quick_solve_linear(int N,double A[],double X[],double B[]) {
 
 	return(0);
 }
+/*===========================================================================*/
+/*==== SAME AS ABOVE, WITH STORAGE FOR DUPLICATE OF A AND ROW POINTERS ======*/
+/*==== OWNED BY THE CALL SO THAT CONCURRENT PATH COMPUTATIONS ARE SAFE ======*/
+/*===========================================================================*/
+static int quick_solve_linear(int N,double A[],double X[],double B[]) {
+	double MTX[12],*Mtx[3];
+	if(N<=3) return(quick_solve_linear(N,A,X,B,MTX,Mtx));
+
+	double *heapMTX=(double *)  malloc(N*(N+1)*sizeof(double));
+	double **heapMtx=(double **) malloc(N*sizeof(double *));
+	if(heapMTX==NULL || heapMtx==NULL) { fprintf(stderr,"\nOut of memory.\n\n"); exit(0); }
+	int status = quick_solve_linear(N,A,X,B,heapMTX,heapMtx);
+	free(heapMTX);	free(heapMtx);
+	return(status);
+}
 /*============================================================================*/
 
 
@@ -258,7 +258,7 @@ int WrapEllipsoid::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::
 		p1e, p2e, vs4, dist, fanWeight = -SimTK::Infinity;
 	double t_sv[3][3], t_c1[3][3];
 	bool far_side_wrap = false;
-   static SimTK::Vec3 origin(0,0,0);
+   const SimTK::Vec3 origin(0,0,0);
 
 	// In case you need any variables from the previous wrap, copy them from
 	// the PathWrap into the WrapResult, re-normalizing the ones that were
@@ -193,8 +193,8 @@ ConvertAxisAngleToQuaternion(const SimTK::Vec3& axis, double angle, double quat[
  * @param t parameterized distance from linePt along line to closestPt
  */
 void WrapMath::
-GetClosestPointOnLineToPoint(SimTK::Vec3& pt, SimTK::Vec3& linePt, SimTK::Vec3& line,
-									  SimTK::Vec3& closestPt, double& t)
+GetClosestPointOnLineToPoint(const SimTK::Vec3& pt, const SimTK::Vec3& linePt,
+									  const SimTK::Vec3& line, SimTK::Vec3& closestPt, double& t)
 {
 	SimTK::Vec3 v1, v2;
 
@@ -267,7 +267,7 @@ ConvertAxisAngleTo4x4DirCosMatrix(const SimTK::Vec3& axis, double angle, double
  * @return the square of the distance
  */
 double WrapMath::
-CalcDistanceSquaredBetweenPoints(SimTK::Vec3& point1, SimTK::Vec3& point2)
+CalcDistanceSquaredBetweenPoints(const SimTK::Vec3& point1, const SimTK::Vec3& point2)
 {
 	SimTK::Vec3 vec = point2 - point1;
 
@@ -282,7 +282,8 @@ CalcDistanceSquaredBetweenPoints(SimTK::Vec3& point1, SimTK::Vec3& point2)
  * @return the square of the distance
  */
 double WrapMath::
-CalcDistanceSquaredPointToLine(SimTK::Vec3& point, SimTK::Vec3& linePt, SimTK::Vec3& line)
+CalcDistanceSquaredPointToLine(const SimTK::Vec3& point, const SimTK::Vec3& linePt,
+							   const SimTK::Vec3& line)
 {
 	double t;
 	Vec3 ptemp;
@@ -59,16 +59,17 @@ public:
 		ConvertAxisAngleToQuaternion(const SimTK::Vec3& axis,
 		double angle, double quat[4]);
 	static void
-		GetClosestPointOnLineToPoint(SimTK::Vec3& pt, SimTK::Vec3& linePt, SimTK::Vec3& line,
-									  SimTK::Vec3& closestPt, double& t);
+		GetClosestPointOnLineToPoint(const SimTK::Vec3& pt, const SimTK::Vec3& linePt,
+									  const SimTK::Vec3& line, SimTK::Vec3& closestPt, double& t);
 	static void
 		Make3x3DirCosMatrix(double angle, double mat[][3]);
 	static void
 		ConvertAxisAngleTo4x4DirCosMatrix(const SimTK::Vec3& axis, double angle, double mat[][4]);
 	static double
-		CalcDistanceSquaredBetweenPoints(SimTK::Vec3& point1, SimTK::Vec3& point2);
+		CalcDistanceSquaredBetweenPoints(const SimTK::Vec3& point1, const SimTK::Vec3& point2);
 	static double
-		CalcDistanceSquaredPointToLine(SimTK::Vec3& point, SimTK::Vec3& linePt, SimTK::Vec3& line);
+		CalcDistanceSquaredPointToLine(const SimTK::Vec3& point, const SimTK::Vec3& linePt,
+									   const SimTK::Vec3& line);
 	static void
 		RotateMatrixAxisAngle(double matrix[][4], const SimTK::Vec3& axis, double angle);
 	static void
@@ -238,7 +238,7 @@ int WrapSphere::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::Vec
 			
    int i, j, maxit, return_code = wrapped;
    bool far_side_wrap = false;
-   static SimTK::Vec3 origin(0,0,0);
+   const SimTK::Vec3 origin(0,0,0);
 
 	// In case you need any variables from the previous wrap, copy them from
 	// the PathWrap into the WrapResult, re-normalizing the ones that were
@@ -0,0 +1,487 @@
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  benchmarkOpenSim.cpp                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2014 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/*
+ * Benchmarks of the simulation and tool hot paths.
+ *
+ * Usage: benchmarkOpenSim [-o <results file>] [-s <scale>] [<filter> ...]
+ *
+ * Each benchmark is reported as one line of JSON, appended to the results
+ * file (benchmarkResults.json by default), with its wall and cpu time, the
+ * number of iterations and iterations per second, and the resident memory of
+ * the process. Only benchmarks whose name contains one of the filters are run.
+ * The iteration counts of the microbenchmarks are multiplied by the scale.
+ *
+ * The end-to-end runs execute each tool from the setup files of the
+ * corresponding application test, copied into a subdirectory of the same
+ * name (IK, ID, SO, CMC, Forward) of the run directory.
+ */
+
+#include <stdint.h>
+#include <OpenSim/OpenSim.h>
+#include <OpenSim/Tools/InverseDynamicsTool.h>
+#include <OpenSim/Auxiliary/getRSS.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace OpenSim;
+using namespace std;
+
+//=============================================================================
+// REPORTING
+//=============================================================================
+/** Measurements of one benchmark. */
+struct BenchmarkResult {
+    string name;
+    string kind;            // "micro" or "end_to_end"
+    string unit;            // what one iteration stands for
+    int iterations;
+    double wallTime;        // seconds
+    double cpuTime;         // seconds
+    size_t peakRSS;         // bytes, high-water mark of the process so far
+    int64_t deltaRSS;       // bytes, change of the resident set during the run
+    bool ok;
+    string error;
+
+    BenchmarkResult() : iterations(0), wallTime(0), cpuTime(0), peakRSS(0),
+        deltaRSS(0), ok(true) {}
+};
+
+static ofstream resultsFile;
+static Array<string> filters;
+static double scale = 1.0;
+static int numFailures = 0;
+
+static string escapeJSON(const string& aStr)
+{
+    string out;
+    for(size_t i=0; i<aStr.size(); ++i) {
+        char c = aStr[i];
+        if(c=='"' || c=='\\') { out += '\\'; out += c; }
+        else if(c=='\n') out += "\\n";
+        else if(c=='\t') out += "\\t";
+        else if((unsigned char)c<0x20) out += ' ';
+        else out += c;
+    }
+    return out;
+}
+
+static void report(const BenchmarkResult& r)
+{
+    double throughput = r.wallTime>0 ? r.iterations/r.wallTime : 0;
+
+    char line[1024];
+    sprintf(line, "{\"name\": \"%s\", \"kind\": \"%s\", \"unit\": \"%s\", "
+        "\"iterations\": %d, \"wall_seconds\": %.6g, \"cpu_seconds\": %.6g, "
+        "\"throughput_per_second\": %.6g, \"peak_rss_bytes\": %lu, "
+        "\"rss_delta_bytes\": %lld, \"status\": \"%s\"",
+        escapeJSON(r.name).c_str(), r.kind.c_str(),
+        escapeJSON(r.unit).c_str(), r.iterations, r.wallTime, r.cpuTime,
+        throughput, (unsigned long)r.peakRSS, (long long)r.deltaRSS,
+        r.ok ? "ok" : "failed");
+    resultsFile << line;
+    if(!r.ok) resultsFile << ", \"error\": \"" << escapeJSON(r.error) << "\"";
+    resultsFile << "}" << endl;
+
+    cout << "BENCHMARK " << r.name << ": ";
+    if(r.ok) {
+        cout << r.wallTime << " s, " << r.iterations << " " << r.unit
+             << " (" << throughput << "/s), peak RSS "
+             << r.peakRSS/(1024*1024) << " MB" << endl;
+    } else {
+        cout << "FAILED- " << r.error << endl;
+        ++numFailures;
+    }
+}
+
+static bool selected(const string& aName)
+{
+    if(filters.getSize()==0) return true;
+    for(int i=0; i<filters.getSize(); ++i)
+        if(aName.find(filters[i])!=string::npos) return true;
+    return false;
+}
+
+static int scaled(int aIterations)
+{
+    int n = (int)(aIterations*scale);
+    return n>0 ? n : 1;
+}
+
+/**
+ * Base class of a benchmark. run() performs the work being measured and
+ * returns the number of iterations it did. By default all of run() is timed;
+ * a run() that brackets its measured sections with startSection() and
+ * endSection() excludes everything else, such as loading the model.
+ */
+class Benchmark {
+public:
+    Benchmark(const string& aName, const string& aKind, const string& aUnit,
+        const string& aDir="") :
+        _name(aName), _kind(aKind), _unit(aUnit), _dir(aDir) {}
+    virtual ~Benchmark() {}
+
+    const string& getName() const { return _name; }
+
+    void execute()
+    {
+        BenchmarkResult r;
+        r.name = _name;
+        r.kind = _kind;
+        r.unit = _unit;
+
+        string cwd = IO::getCwd();
+        if(!_dir.empty()) IO::chDir(_dir);
+
+        _timed = false;
+        _wall = _cpu = 0;
+        size_t startRSS = getCurrentRSS();
+        double startWall = SimTK::realTime();
+        double startCpu = SimTK::cpuTime();
+        try {
+            r.iterations = run();
+        } catch(const std::exception& x) {
+            r.ok = false;
+            r.error = x.what();
+        }
+        r.wallTime = _timed ? _wall : SimTK::realTime()-startWall;
+        r.cpuTime = _timed ? _cpu : SimTK::cpuTime()-startCpu;
+        r.deltaRSS = (int64_t)getCurrentRSS()-(int64_t)startRSS;
+        r.peakRSS = getPeakRSS();
+
+        if(!_dir.empty()) IO::chDir(cwd);
+        report(r);
+    }
+
+protected:
+    virtual int run() = 0;
+
+    // Accumulate the time of a measured section when run() excludes setup.
+    void startSection() { _wall0 = SimTK::realTime(); _cpu0 = SimTK::cpuTime(); }
+    void endSection()
+    {
+        _wall += SimTK::realTime()-_wall0;
+        _cpu += SimTK::cpuTime()-_cpu0;
+        _timed = true;
+    }
+
+private:
+    string _name, _kind, _unit, _dir;
+    bool _timed;
+    double _wall, _cpu, _wall0, _cpu0;
+};
+
+//=============================================================================
+// MICROBENCHMARKS
+//=============================================================================
+/** Evaluate a muscle curve and its first derivative across its domain. */
+template <class C>
+class CurveBenchmark : public Benchmark {
+public:
+    CurveBenchmark(const string& aName, double aMin, double aMax) :
+        Benchmark("curve/"+aName, "micro", "evaluations"),
+        _min(aMin), _max(aMax) {}
+protected:
+    int run() override
+    {
+        C curve;
+        // Build the curve outside of the measurement.
+        volatile double sum = curve.calcValue(0.5*(_min+_max));
+
+        int n = scaled(1000000);
+        startSection();
+        for(int i=0; i<n; ++i) {
+            double x = _min + (_max-_min)*(i%1000)/999.0;
+            sum += curve.calcValue(x) + curve.calcDerivative(x, 1);
+        }
+        endSection();
+        return n;
+    }
+private:
+    double _min, _max;
+};
+
+/**
+ * Compute the lengths of the muscle paths of a model that wrap over a given
+ * type of wrap object ("none" for paths without wrapping). Each iteration
+ * moves all coordinates, which invalidates the paths, and computes the
+ * length of every selected path; only the path computations are timed.
+ */
+class PathBenchmark : public Benchmark {
+public:
+    PathBenchmark(const string& aModelFile, const string& aWrapType) :
+        Benchmark("path/"+aModelFile+"/"+aWrapType, "micro", "paths"),
+        _modelFile(aModelFile), _wrapType(aWrapType) {}
+protected:
+    int run() override
+    {
+        Model model(_modelFile);
+        SimTK::State& s = model.initSystem();
+
+        Array<const GeometryPath*> paths;
+        const ForceSet& forces = model.getForceSet();
+        for(int i=0; i<forces.getSize(); ++i) {
+            const PathActuator* act = dynamic_cast<const PathActuator*>(&forces[i]);
+            if(act==NULL) continue;
+            const GeometryPath& path = act->getGeometryPath();
+            const PathWrapSet& wraps = path.getWrapSet();
+            bool use = (_wrapType=="none" && wraps.getSize()==0);
+            for(int j=0; j<wraps.getSize() && !use; ++j) {
+                const WrapObject* wo = wraps[j].getWrapObject();
+                use = wo!=NULL && wo->getConcreteClassName()==_wrapType;
+            }
+            if(use) paths.append(&path);
+        }
+        if(paths.getSize()==0)
+            throw Exception("No paths with wrap type "+_wrapType+" in "+_modelFile);
+
+        const CoordinateSet& coords = model.getCoordinateSet();
+        SimTK::Vector q0 = s.getQ();
+        volatile double sum = 0;
+        int n = scaled(200);
+        for(int i=0; i<n; ++i) {
+            for(int c=0; c<coords.getSize(); ++c) {
+                const Coordinate& coord = coords[c];
+                if(coord.getLocked(s)) continue;
+                double lo = coord.getRangeMin(), hi = coord.getRangeMax();
+                double f = 0.5 + 0.4*sin(0.37*i + c);
+                coord.setValue(s, lo + f*(hi-lo), false);
+            }
+            model.getMultibodySystem().realize(s, SimTK::Stage::Position);
+            startSection();
+            for(int p=0; p<paths.getSize(); ++p) sum += paths[p]->getLength(s);
+            endSection();
+        }
+        s.updQ() = q0;
+        return n*paths.getSize();
+    }
+private:
+    string _modelFile, _wrapType;
+};
+
+/** Read a Storage file. */
+class StorageReadBenchmark : public Benchmark {
+public:
+    StorageReadBenchmark(const string& aFile) :
+        Benchmark("storage/read/"+aFile, "micro", "rows"), _file(aFile) {}
+protected:
+    int run() override
+    {
+        int rows = 0;
+        int n = scaled(5);
+        for(int i=0; i<n; ++i) {
+            Storage store(_file);
+            rows += store.getSize();
+        }
+        return rows;
+    }
+private:
+    string _file;
+};
+
+/** Write a Storage file. */
+class StorageWriteBenchmark : public Benchmark {
+public:
+    StorageWriteBenchmark(const string& aFile) :
+        Benchmark("storage/write/"+aFile, "micro", "rows"), _file(aFile) {}
+protected:
+    int run() override
+    {
+        Storage store(_file);
+        int rows = 0;
+        int n = scaled(5);
+        for(int i=0; i<n; ++i) {
+            startSection();
+            store.print("benchmark_"+_file);
+            endSection();
+            rows += store.getSize();
+        }
+        return rows;
+    }
+private:
+    string _file;
+};
+
+/** Load a model from file. */
+class ModelLoadBenchmark : public Benchmark {
+public:
+    ModelLoadBenchmark(const string& aModelFile) :
+        Benchmark("model/load/"+aModelFile, "micro", "models"),
+        _modelFile(aModelFile) {}
+protected:
+    int run() override
+    {
+        int n = scaled(3);
+        for(int i=0; i<n; ++i) Model model(_modelFile);
+        return n;
+    }
+private:
+    string _modelFile;
+};
+
+/** Build the system and default state of a loaded model. */
+class InitSystemBenchmark : public Benchmark {
+public:
+    InitSystemBenchmark(const string& aModelFile) :
+        Benchmark("model/initSystem/"+aModelFile, "micro", "models"),
+        _modelFile(aModelFile) {}
+protected:
+    int run() override
+    {
+        int n = scaled(3);
+        for(int i=0; i<n; ++i) {
+            Model model(_modelFile);
+            startSection();
+            model.initSystem();
+            endSection();
+        }
+        return n;
+    }
+private:
+    string _modelFile;
+};
+
+//=============================================================================
+// END-TO-END RUNS
+//=============================================================================
+/** Run a tool from its setup file. Tool is constructed from the setup file
+    and must have a run() method returning bool. */
+template <class T>
+class ToolBenchmark : public Benchmark {
+public:
+    ToolBenchmark(const string& aName, const string& aDir,
+        const string& aSetupFile) :
+        Benchmark("tool/"+aName+"/"+aSetupFile, "end_to_end", "runs", aDir),
+        _setupFile(aSetupFile) {}
+protected:
+    int run() override
+    {
+        T tool(_setupFile);
+        if(!tool.run()) throw Exception(_setupFile+" did not run to completion.");
+        return 1;
+    }
+private:
+    string _setupFile;
+};
+
+/** Forward simulation of a model with its default controls. */
+class SimulationBenchmark : public Benchmark {
+public:
+    SimulationBenchmark(const string& aModelFile, double aFinalTime) :
+        Benchmark("forward/"+aModelFile, "end_to_end", "integration steps"),
+        _modelFile(aModelFile), _finalTime(aFinalTime) {}
+protected:
+    int run() override
+    {
+        Model model(_modelFile);
+        SimTK::State& s = model.initSystem();
+        model.equilibrateMuscles(s);
+
+        SimTK::RungeKuttaMersonIntegrator integrator(model.getMultibodySystem());
+        integrator.setAccuracy(1.0e-4);
+        Manager manager(model, integrator);
+        manager.setInitialTime(0.0);
+        manager.setFinalTime(_finalTime);
+        manager.integrate(s);
+        return integrator.getNumStepsTaken();
+    }
+private:
+    string _modelFile;
+    double _finalTime;
+};
+
+//=============================================================================
+// MAIN
+//=============================================================================
+int main(int argc, char **argv)
+{
+    string resultsName = "benchmarkResults.json";
+    for(int i=1; i<argc; ++i) {
+        string arg = argv[i];
+        if(arg=="-o" && i+1<argc) resultsName = argv[++i];
+        else if(arg=="-s" && i+1<argc) scale = atof(argv[++i]);
+        else filters.append(arg);
+    }
+    resultsFile.open(resultsName.c_str(), ios::app);
+    if(!resultsFile.good()) {
+        cout << "benchmarkOpenSim: ERROR- unable to open " << resultsName << endl;
+        return 1;
+    }
+
+    // The benchmarks in the order they run. Models and data files are those
+    // copied into the run directory by the build.
+    Array<Benchmark*> benchmarks;
+    benchmarks.append(new CurveBenchmark<ActiveForceLengthCurve>(
+        "ActiveForceLengthCurve", 0.3, 1.9));
+    benchmarks.append(new CurveBenchmark<FiberForceLengthCurve>(
+        "FiberForceLengthCurve", 0.8, 1.8));
+    benchmarks.append(new CurveBenchmark<ForceVelocityCurve>(
+        "ForceVelocityCurve", -1.0, 1.0));
+    benchmarks.append(new CurveBenchmark<TendonForceLengthCurve>(
+        "TendonForceLengthCurve", 0.99, 1.05));
+
+    const char* wrapTypes[] = { "none", "WrapSphere", "WrapCylinder",
+                                "WrapEllipsoid", "WrapTorus" };
+    for(int i=0; i<5; ++i)
+        benchmarks.append(new PathBenchmark("upper_limb.osim", wrapTypes[i]));
+    // The paths of gait2392_pelvisFixed have no wrap objects.
+    benchmarks.append(new PathBenchmark("gait2392_pelvisFixed.osim", "none"));
+
+    benchmarks.append(new StorageReadBenchmark("subject01_walk1_grf.mot"));
+    benchmarks.append(new StorageWriteBenchmark("subject01_walk1_grf.mot"));
+
+    const char* models[] = { "arm26.osim", "upper_limb.osim",
+                             "gait2392_pelvisFixed.osim" };
+    for(int i=0; i<3; ++i) {
+        benchmarks.append(new ModelLoadBenchmark(models[i]));
+        benchmarks.append(new InitSystemBenchmark(models[i]));
+    }
+
+    benchmarks.append(new ToolBenchmark<InverseKinematicsTool>(
+        "IK", "IK", "subject01_Setup_InverseKinematics.xml"));
+    benchmarks.append(new ToolBenchmark<InverseDynamicsTool>(
+        "ID", "ID", "arm26_Setup_InverseDynamics.xml"));
+    benchmarks.append(new ToolBenchmark<AnalyzeTool>(
+        "SO", "SO", "arm26_Setup_StaticOptimization.xml"));
+    benchmarks.append(new ToolBenchmark<CMCTool>(
+        "CMC", "CMC", "arm26_Setup_CMC.xml"));
+    benchmarks.append(new ToolBenchmark<ForwardTool>(
+        "Forward", "Forward", "arm26_Setup_Forward.xml"));
+    benchmarks.append(new SimulationBenchmark("arm26.osim", 0.5));
+    benchmarks.append(new SimulationBenchmark("upper_limb.osim", 0.05));
+    benchmarks.append(new SimulationBenchmark("gait2392_pelvisFixed.osim", 0.05));
+
+    for(int i=0; i<benchmarks.getSize(); ++i) {
+        if(selected(benchmarks[i]->getName())) benchmarks[i]->execute();
+        delete benchmarks[i];
+    }
+
+    if(numFailures>0) {
+        cout << "Done, with " << numFailures << " failed benchmark(s)." << endl;
+        return 1;
+    }
+    cout << "Done" << endl;
+    return 0;
+}
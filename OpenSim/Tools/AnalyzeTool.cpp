@@ -613,6 +613,9 @@ void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal,
     SimTK::Vector stateData;
     stateData.resize(numOpenSimStates);
 
+	// States are visited in time order, so assemble each frame incrementally
+	Model::IncrementalAssemblyGuard incremental(aModel);
+
 	for(int i=iInitial;i<=iFinal;i++) {
 		tPrev = t;
 		aStatesStore.getTime(i,s.updTime()); // time
@@ -566,10 +566,6 @@ bool CMCTool::run()
 		cout<<"\nConstructing function set for tracking desired points...\n\n";
 		posSet = new GCVSplineSet(5,desiredPointsStore);
 
-		Storage *velStore=posSet->constructStorage(1);
-		GCVSplineSet velSet(5,velStore);
-		delete velStore; velStore=NULL;
-
 		// Print acc for debugging
 		Storage *accStore=posSet->constructStorage(2);
 		accStore->print("desiredPoints_splinefit_accelerations.sto");
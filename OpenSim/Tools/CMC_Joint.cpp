@@ -256,13 +256,11 @@ computeErrors(const SimTK::State& s, double aT)
 	//std::cout<<_coordinateName<<std::endl;
 	//std::cout<<"_pTrk[0]->evaluate(0,aT) = "<<_pTrk[0]->evaluate(0,aT)<<std::endl;
 	//std::cout<<"_q->getValue() = "<<_q->getValue()<<std::endl;
-	_pErr[0] = _pTrk[0]->calcValue(SimTK::Vector(1,aT)) - _q->getValue(s);
+	_pErr[0] = _pTrk[0]->calcValue(aT) - _q->getValue(s);
 	if(_vTrk[0]==NULL) {
-		std::vector<int> derivComponents(1);
-		derivComponents[0]=0;
-		_vErr[0] = _pTrk[0]->calcDerivative(derivComponents,SimTK::Vector(1,aT)) - _q->getSpeedValue(s);
+		_vErr[0] = _pTrk[0]->calcDerivative(aT,1) - _q->getSpeedValue(s);
 	} else {
-		_vErr[0] = _vTrk[0]->calcValue(SimTK::Vector(1,aT)) - _q->getSpeedValue(s);
+		_vErr[0] = _vTrk[0]->calcValue(aT) - _q->getSpeedValue(s);
 	}
 }
 //_____________________________________________________________________________
@@ -292,12 +290,9 @@ computeDesiredAccelerations(const SimTK::State& s, double aT)
 	double v = (_kv)[0]*_vErr[0];
 	double a;
 	if(_aTrk[0]==NULL) {
-		std::vector<int> derivComponents(2);
-		derivComponents[0]=0;
-		derivComponents[1]=0;
-		a = (_ka)[0]*_pTrk[0]->calcDerivative(derivComponents,SimTK::Vector(1,aT));
+		a = (_ka)[0]*_pTrk[0]->calcDerivative(aT,2);
 	} else {
-		a = (_ka)[0]*_aTrk[0]->calcValue(SimTK::Vector(1,aT));
+		a = (_ka)[0]*_aTrk[0]->calcValue(aT);
 	}
 	_aDes[0] = a + v + p;
 
@@ -334,12 +329,9 @@ computeDesiredAccelerations(const SimTK::State& s, double aTI,double aTF)
 	double v = (_kv)[0]*_vErr[0];
 	
 	if(_aTrk[0]==NULL) {
-		std::vector<int> derivComponents(2);
-		derivComponents[0]=0;
-		derivComponents[1]=0;
-		a = (_ka)[0]*_pTrk[0]->calcDerivative(derivComponents,SimTK::Vector(1,aTF));
+		a = (_ka)[0]*_pTrk[0]->calcDerivative(aTF,2);
 	} else {
-		a = (_ka)[0]*_aTrk[0]->calcValue(SimTK::Vector(1,aTF));
+		a = (_ka)[0]*_aTrk[0]->calcValue(aTF);
 	}
 	_aDes[0] = a + v + p;
 
@@ -687,7 +687,7 @@ getTaskPosition(int aWhich,double aT) const
 		string msg = "CMC_Task: ERR- Invalid task.";
 		throw( Exception(msg,__FILE__,__LINE__) );
 	}
-	double position = _pTrk[aWhich]->calcValue(SimTK::Vector(1,aT));
+	double position = _pTrk[aWhich]->calcValue(aT);
 	return(position);
 }
 //_____________________________________________________________________________
@@ -709,11 +709,9 @@ getTaskVelocity(int aWhich,double aT) const
 
 	double velocity;
 	if(_vTrk[aWhich]!=NULL) {
-		velocity = _vTrk[aWhich]->calcValue(SimTK::Vector(1,aT));
+		velocity = _vTrk[aWhich]->calcValue(aT);
 	} else {
-		std::vector<int> derivComponents(1);
-		derivComponents[0]=0;
-		velocity = _pTrk[aWhich]->calcDerivative(derivComponents,SimTK::Vector(1,aT));
+		velocity = _pTrk[aWhich]->calcDerivative(aT,1);
 	}
 
 	return( velocity );
@@ -736,12 +734,9 @@ getTaskAcceleration(int aWhich,double aT) const
 
 	double acceleration;
 	if(_aTrk[aWhich]!=NULL) {
-		acceleration = _aTrk[aWhich]->calcValue(SimTK::Vector(1,aT));
+		acceleration = _aTrk[aWhich]->calcValue(aT);
 	} else {
-		std::vector<int> derivComponents(2);
-		derivComponents[0]=0;
-		derivComponents[1]=0;
-		acceleration = _pTrk[aWhich]->calcDerivative(derivComponents,SimTK::Vector(1,aT));
+		acceleration = _pTrk[aWhich]->calcDerivative(aT,2);
 	}
 
 	return( acceleration );
@@ -26,6 +26,10 @@
 #include <OpenSim/Common/XMLDocument.h>
 #include "ForwardTool.h"
 #include <OpenSim/Common/IO.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <memory>
 
 #include <OpenSim/Simulation/Control/Controller.h>
 #include <OpenSim/Simulation/Control/ControlSet.h>
@@ -62,7 +66,11 @@ ForwardTool::~ForwardTool()
 ForwardTool::ForwardTool() :
 	AbstractTool(),
 	_statesFileName(_statesFileNameProp.getValueStr()),
-	_useSpecifiedDt(_useSpecifiedDtProp.getValueBool())
+	_useSpecifiedDt(_useSpecifiedDtProp.getValueBool()),
+	_integrator(_integratorProp.getValueStr()),
+	_reportingInterval(_reportingIntervalProp.getValueDbl()),
+	_checkpointFile(_checkpointFileProp.getValueStr()),
+	_checkpointInterval(_checkpointIntervalProp.getValueDbl())
 {
 	setNull();
 }
@@ -78,7 +86,11 @@ ForwardTool::ForwardTool() :
 ForwardTool::ForwardTool(const string &aFileName,bool aUpdateFromXMLNode,bool aLoadModel) :
 	AbstractTool(aFileName, false),
 	_statesFileName(_statesFileNameProp.getValueStr()),
-	_useSpecifiedDt(_useSpecifiedDtProp.getValueBool())
+	_useSpecifiedDt(_useSpecifiedDtProp.getValueBool()),
+	_integrator(_integratorProp.getValueStr()),
+	_reportingInterval(_reportingIntervalProp.getValueDbl()),
+	_checkpointFile(_checkpointFileProp.getValueStr()),
+	_checkpointInterval(_checkpointIntervalProp.getValueDbl())
 {
 	setNull();
 
@@ -131,7 +143,11 @@ ForwardTool::
 ForwardTool(const ForwardTool &aTool) :
 	AbstractTool(aTool),
 	_statesFileName(_statesFileNameProp.getValueStr()),
-	_useSpecifiedDt(_useSpecifiedDtProp.getValueBool())
+	_useSpecifiedDt(_useSpecifiedDtProp.getValueBool()),
+	_integrator(_integratorProp.getValueStr()),
+	_reportingInterval(_reportingIntervalProp.getValueDbl()),
+	_checkpointFile(_checkpointFileProp.getValueStr()),
+	_checkpointInterval(_checkpointIntervalProp.getValueDbl())
 {
 	setNull();
 	*this = aTool;
@@ -148,6 +164,10 @@ void ForwardTool::setNull()
 	// BASIC
 	_statesFileName = "";
 	_useSpecifiedDt = false;
+	_integrator = "RungeKuttaMerson";
+	_reportingInterval = 0.0;
+	_checkpointFile = "";
+	_checkpointInterval = 0.0;
 	_printResultFiles = true;
 
 	_replaceForceSet = false;	// default should be false for Forward.
@@ -193,6 +213,39 @@ void ForwardTool::setupProperties()
 	_useSpecifiedDtProp.setName("use_specified_dt");
 	_propertySet.append( &_useSpecifiedDtProp );
 
+	comment = "Integration method: RungeKuttaMerson (default), RungeKuttaFeldberg, "
+				 "RungeKutta3 or CPodes. CPodes is an implicit (BDF) method that can take "
+				 "much larger steps for stiff models, such as equilibrium muscle models with "
+				 "compliant tendons, which otherwise force the explicit methods to take "
+				 "very small steps.";
+	_integratorProp.setComment(comment);
+	_integratorProp.setName("integrator");
+	_propertySet.append( &_integratorProp );
+
+	comment = "Interval (in seconds of simulated time) at which analyses are run and "
+				 "states are stored during variable step integration. The reported values "
+				 "are interpolated, so the integrator is free to take large steps. If zero "
+				 "or negative (default), results are reported after every integration step.";
+	_reportingIntervalProp.setComment(comment);
+	_reportingIntervalProp.setName("reporting_interval");
+	_propertySet.append( &_reportingIntervalProp );
+
+	comment = "Binary file to which the state of the simulation is saved periodically. "
+				 "If the file exists when the tool is run, the simulation resumes from the "
+				 "saved state instead of the initial states, so a long simulation that was "
+				 "interrupted does not have to start over. Only the state is saved, so the "
+				 "results of a resumed simulation start at the time of the checkpoint. The "
+				 "file is removed when the simulation reaches the final time. No checkpoints "
+				 "are saved if empty.";
+	_checkpointFileProp.setComment(comment);
+	_checkpointFileProp.setName("checkpoint_file");
+	_propertySet.append( &_checkpointFileProp );
+
+	comment = "Interval (in seconds of simulated time) between saved checkpoints.";
+	_checkpointIntervalProp.setComment(comment);
+	_checkpointIntervalProp.setName("checkpoint_interval");
+	_propertySet.append( &_checkpointIntervalProp );
+
 
 }
 
@@ -216,6 +269,10 @@ operator=(const ForwardTool &aTool)
 	// BASIC INPUT
 	_statesFileName = aTool._statesFileName;
 	_useSpecifiedDt = aTool._useSpecifiedDt;
+	_integrator = aTool._integrator;
+	_reportingInterval = aTool._reportingInterval;
+	_checkpointFile = aTool._checkpointFile;
+	_checkpointInterval = aTool._checkpointInterval;
 
 	return(*this);
 }
@@ -268,7 +325,9 @@ bool ForwardTool::run()
 
 	// SETUP SIMULATION
 	// Manager (now allocated on the heap so that getManager doesn't return stale pointer on stack
-    RungeKuttaMersonIntegrator integrator(_model->getMultibodySystem());
+    std::unique_ptr<SimTK::Integrator> integ(
+        Manager::createIntegrator(_integrator, _model->getMultibodySystem()));
+    SimTK::Integrator& integrator = *integ;
     Manager manager(*_model, integrator);
     setManager( manager );
 	manager.setSessionName(getName());
@@ -283,6 +342,8 @@ bool ForwardTool::run()
 	integrator.setAccuracy(_errorTolerance);
 
 
+	manager.setReportingInterval(_reportingInterval);
+
 	// integ->setFineTolerance(_fineTolerance); No equivalent in SimTK
 	if(_useSpecifiedDt) InitializeSpecifiedTimeStepping(_yStore, manager);
 
@@ -303,8 +364,22 @@ bool ForwardTool::run()
         for (int i=0; i<numStateVariables; i++)
             _model->setStateVariable(s, stateNames[i], rawData[i]);
     }
+	// RESUME FROM A CHECKPOINT OF AN INTERRUPTED RUN
+	int resumeStep = -1;
+	if(!_checkpointFile.empty()) {
+		manager.setCheckpointFile(_checkpointFile, _checkpointInterval);
+		std::ifstream checkpoint(_checkpointFile.c_str());
+		if(checkpoint.good()) {
+			checkpoint.close();
+			resumeStep = manager.readCheckpoint(s, _checkpointFile);
+			cout<<"\nResuming from checkpoint "<<_checkpointFile<<" at time "
+				<<s.getTime()<<". The results of this run start at that time;"
+				<<" those of the interrupted run are not included."<<endl;
+		}
+	}
+
 	// SOLVE FOR EQUILIBRIUM FOR AUXILIARY STATES (E.G., MUSCLE FIBER LENGTHS)
-	if(_solveForEquilibriumForAuxiliaryStates) {
+	if(_solveForEquilibriumForAuxiliaryStates && resumeStep<0) {
 		_model->equilibrateMuscles(s);  
 	}
 
@@ -315,8 +390,21 @@ bool ForwardTool::run()
 		// INTEGRATE
         _model->printDetailedInfo(s, std::cout );
 
-		cout<<"\n\nIntegrating from "<<_ti<<" to "<<_tf<<endl;
-        manager.integrate(s);
+		cout<<"\n\nIntegrating from "<<manager.getInitialTime()<<" to "<<_tf<<endl;
+		if(resumeStep>=0)
+			manager.doIntegration(s, resumeStep, 1.0e-6);
+		else
+			manager.integrate(s);
+
+		// A run that reached the final time is complete, so a later run must
+		// not resume from it. A halted run keeps its checkpoint.
+		if(!_checkpointFile.empty()) {
+			if(s.getTime() >= _tf - SimTK::SignificantReal*std::max(1.0, std::fabs(_tf)))
+				remove(_checkpointFile.c_str());
+			else
+				cout<<"Integration stopped at time "<<s.getTime()<<" before the final time "
+					<<_tf<<"; keeping checkpoint "<<_checkpointFile<<"."<<endl;
+		}
 	} catch(const std::exception& x) {
         cout << "ForwardTool::run() caught exception \n";
         cout << x.what() << endl;
@@ -79,6 +79,28 @@ protected:
 	OpenSim::PropertyBool _useSpecifiedDtProp;
 	bool &_useSpecifiedDt;
 
+	/** Name of the integration method. The default, RungeKuttaMerson, is an
+	explicit method. CPodes is an implicit (BDF) method suited to stiff
+	models. */
+	PropertyStr _integratorProp;
+	std::string &_integrator;
+
+	/** Interval at which analyses are run and states are stored during
+	variable step integration. Zero or less reports every integration step. */
+	PropertyDbl _reportingIntervalProp;
+	double &_reportingInterval;
+
+	/** File to which checkpoints of the simulation are saved, and from which
+	an interrupted simulation is resumed if it exists. The checkpoint holds
+	only the state, so the states and analysis results printed by a resumed
+	run start at the time of the checkpoint. The file is removed once a run
+	reaches the final time. */
+	PropertyStr _checkpointFileProp;
+	std::string &_checkpointFile;
+	/** Simulated time between checkpoints. */
+	PropertyDbl _checkpointIntervalProp;
+	double &_checkpointInterval;
+
 	/** Storage for the input states. */
 	Storage *_yStore;
 	/** Flag indicating whether or not to write to the results (GUI will set this to false). */
@@ -128,6 +150,17 @@ public:
 	bool getUseSpecifiedDt() const { return _useSpecifiedDt; }
 	void setUseSpecifiedDt(bool aUseSpecifiedDt) { _useSpecifiedDt = aUseSpecifiedDt; }
 
+	const std::string &getIntegrator() const { return _integrator; }
+	void setIntegrator(const std::string &aIntegrator) { _integrator = aIntegrator; }
+
+	double getReportingInterval() const { return _reportingInterval; }
+	void setReportingInterval(double aInterval) { _reportingInterval = aInterval; }
+
+	const std::string &getCheckpointFile() const { return _checkpointFile; }
+	void setCheckpointFile(const std::string &aFileName) { _checkpointFile = aFileName; }
+	double getCheckpointInterval() const { return _checkpointInterval; }
+	void setCheckpointInterval(double aInterval) { _checkpointInterval = aInterval; }
+
 	void setPrintResultFiles(bool aToWrite) { _printResultFiles = aToWrite; }
 
 	//--------------------------------------------------------------------------
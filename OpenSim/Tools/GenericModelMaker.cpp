@@ -27,6 +27,7 @@
 #include "GenericModelMaker.h"
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Model/Marker.h>
+#include <memory>
 
 //=============================================================================
 // STATICS
@@ -167,7 +168,8 @@ Model* GenericModelMaker::processModel(const string& aPathToSubject)
 
 		if (!_markerSetFileNameProp.getValueIsDefault() && _markerSetFileName !="Unassigned") {
 			cout << "Loading marker set from '" << aPathToSubject+_markerSetFileName+"'" << endl;
-			MarkerSet *markerSet = new MarkerSet(aPathToSubject + _markerSetFileName);
+			std::unique_ptr<MarkerSet> markerSet(
+				new MarkerSet(aPathToSubject + _markerSetFileName));
 			model->updateMarkerSet(*markerSet);
 		}
 	}
@@ -179,3 +181,38 @@ Model* GenericModelMaker::processModel(const string& aPathToSubject)
 
 	return model;
 }
+//_____________________________________________________________________________
+/**
+ * Execute the model making process on a generic model that has already been
+ * read, which involves copying it and possibly updating its marker set.
+ * This lets many subjects share one parsed generic model.
+ *
+ * @return Pointer to the Model that is constructed.
+ */
+Model* GenericModelMaker::processModel(const Model& aGenericModel, const string& aPathToSubject)
+{
+	Model* model = NULL;
+
+	cout << endl << "Step 1: Copying generic model " << aGenericModel.getName() << endl;
+
+	try
+	{
+		model = aGenericModel.clone();
+		model->initSystem();
+
+		if (!_markerSetFileNameProp.getValueIsDefault() && _markerSetFileName !="Unassigned") {
+			cout << "Loading marker set from '" << aPathToSubject+_markerSetFileName+"'" << endl;
+			std::unique_ptr<MarkerSet> markerSet(
+				new MarkerSet(aPathToSubject + _markerSetFileName));
+			model->updateMarkerSet(*markerSet);
+		}
+	}
+	catch (const Exception& x)
+	{
+		x.print(cout);
+		delete model;
+		return NULL;
+	}
+
+	return model;
+}
@@ -85,6 +85,7 @@ public:
 	void copyData(const GenericModelMaker &aGenericModelMaker);
 
 	Model* processModel(const std::string& aPathToSubject="");
+	Model* processModel(const Model& aGenericModel, const std::string& aPathToSubject="");
 
 	/* Register types to be used when reading a GenericModelMaker object from xml file. */
 	static void registerTypes();
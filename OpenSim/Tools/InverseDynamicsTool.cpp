@@ -124,6 +124,7 @@ void InverseDynamicsTool::setNull()
 	_model = NULL;
 	_lowpassCutoffFrequency = -1.0;
 	_coordinateValues = NULL;
+	_numThreads = 0;
 }
 //_____________________________________________________________________________
 /**
@@ -187,6 +188,7 @@ operator=(const InverseDynamicsTool &aTool)
 	_outputGenForceFileName = aTool._outputGenForceFileName;
 	_outputBodyForcesAtJointsFileName = aTool._outputBodyForcesAtJointsFileName;
 	_coordinateValues = NULL;
+	_numThreads = aTool._numThreads;
 
 	return(*this);
 }
@@ -230,6 +232,81 @@ void InverseDynamicsTool::getJointsByName(Model &model, const Array<std::string>
 }
 
 
+//=============================================================================
+// SOLVING THE TIME FRAMES
+//=============================================================================
+// Fewest time frames worth giving a thread its own copy of the model when
+// the number of threads is left to the tool.
+static const int MinFramesPerThread = 500;
+//_____________________________________________________________________________
+/*
+ * Task that solves one contiguous chunk of time frames per index, on the
+ * model and state of that chunk, from the coordinate values, speeds and
+ * accelerations evaluated for all frames beforehand. The equivalent body
+ * forces at the reported joints are computed from the same state.
+ */
+class InverseDynamicsFramesTask : public SimTK::ParallelExecutor::Task {
+public:
+	InverseDynamicsFramesTask(const Array<Model*>& models, 
+		const Array<SimTK::State*>& states, const Array_<double>& times,
+		const Array_<Vector>& qTraj, const Array_<Vector>& uTraj,
+		const Array_<Vector>& udotTraj, const Array<int>& jointIndices,
+		Array_<Vector>& genForceTraj, Array_<Vector>& bodyForceTraj,
+		Array<string>& errors) :
+		_models(models), _states(states), _times(times), _qTraj(qTraj),
+		_uTraj(uTraj), _udotTraj(udotTraj), _jointIndices(jointIndices),
+		_genForceTraj(genForceTraj), _bodyForceTraj(bodyForceTraj),
+		_errors(errors) {}
+
+	void execute(int index) {
+		Model& model = *_models[index];
+		SimTK::State& s = *_states[index];
+		int nChunks = _models.getSize();
+		int nt = (int)_times.size();
+		int first = (int)(((long long)index*nt)/nChunks);
+		int last = (int)(((long long)(index+1)*nt)/nChunks);
+		try {
+			InverseDynamicsSolver ivdSolver(model);
+			AnalysisSet& analysisSet = model.updAnalysisSet();
+			const JointSet& joints = model.getJointSet();
+			for(int i=first; i<last; i++){
+				s.updTime() = _times[i];
+				s.updQ() = _qTraj[i];
+				s.updU() = _uTraj[i];
+				s.updUDot() = _udotTraj[i];
+				_genForceTraj[i] = ivdSolver.solve(s, _udotTraj[i]);
+				analysisSet.step(s, i);
+
+				Vector& bodyForces = _bodyForceTraj[i];
+				for(int j=0; j<_jointIndices.getSize(); ++j){
+					SpatialVec equivalentBodyForceAtJoint = 
+						joints[_jointIndices[j]].calcEquivalentSpatialForce(s, _genForceTraj[i]);
+					for(int k=0; k<3; ++k){
+						// body force components
+						bodyForces[6*j+k] = equivalentBodyForceAtJoint[1][k];
+						// body torque components
+						bodyForces[6*j+k+3] = equivalentBodyForceAtJoint[0][k];
+					}
+				}
+			}
+		}
+		catch (const std::exception& x) {
+			_errors[index] = x.what();
+		}
+	}
+private:
+	const Array<Model*>& _models;
+	const Array<SimTK::State*>& _states;
+	const Array_<double>& _times;
+	const Array_<Vector>& _qTraj;
+	const Array_<Vector>& _uTraj;
+	const Array_<Vector>& _udotTraj;
+	const Array<int>& _jointIndices;
+	Array_<Vector>& _genForceTraj;
+	Array_<Vector>& _bodyForceTraj;
+	Array<string>& _errors;
+};
+
 //=============================================================================
 // RUN
 //=============================================================================
@@ -317,9 +394,6 @@ bool InverseDynamicsTool::run()
 		int start_index = _coordinateValues->findIndex(start_time);
 		int final_index = _coordinateValues->findIndex(final_time);
 
-		// create the solver given the input data
-		InverseDynamicsSolver ivdSolver(*_model);
-
 		const clock_t start = clock();
 
 		int nt = final_index-start_index+1;
@@ -329,21 +403,69 @@ bool InverseDynamicsTool::run()
 			times[i]=_coordinateValues->getStateVector(start_index+i)->getTime();
 		}
 
+		JointSet jointsForEquivalentBodyForces;
+		getJointsByName(*_model, _jointsForReportingBodyForces, jointsForEquivalentBodyForces);
+		int nj = jointsForEquivalentBodyForces.getSize();
+		Array<int> jointIndices(-1, nj);
+		for(int i=0; i<nj; i++){
+			jointIndices[i] = _model->getJointSet().getIndex(jointsForEquivalentBodyForces[i].getName());
+		}
+
+		// Evaluate the coordinates, speeds and accelerations of all frames up front
+		Array_<Vector> qTraj, uTraj, udotTraj;
+		InverseDynamicsSolver::evaluateTrajectory(*coordFunctions, times, qTraj, uTraj, udotTraj);
+
 		// Preallocate results
 		Array_<Vector> genForceTraj(nt, Vector(nq, 0.0));
+		Array_<Vector> bodyForceTraj(nt, Vector(6*nj, 0.0));
+
+		// Split the frames into chunks, one per thread, with a copy of the model
+		// for each chunk after the first. Analyses of the model are stepped 
+		// through the frames in order, so they keep the solve serial.
+		// Unless the number of threads is given, short trials are not split
+		// since each copy of the model must be initialized.
+		int numChunks = _numThreads;
+		if(numChunks == 0){
+			numChunks = nt/MinFramesPerThread;
+			if(numChunks > SimTK::ParallelExecutor::getNumProcessors())
+				numChunks = SimTK::ParallelExecutor::getNumProcessors();
+		}
+		if(numChunks > nt) numChunks = nt;
+		if(numChunks < 1 || _model->getAnalysisSet().getSize() > 0) numChunks = 1;
+
+		Array<Model*> models;
+		Array<SimTK::State*> states;
+		models.append(_model);
+		states.append(&s);
+		for(int c=1; c<numChunks; c++){
+			Model* copy = new Model(*_model);
+			SimTK::State& cs = copy->initSystem();
+			disableModelForces(*copy, cs, _excludedForces);
+			models.append(copy);
+			states.append(&cs);
+		}
 
 		// solve for the trajectory of generalized forces that correspond to the 
 		// coordinate trajectories provided
-		ivdSolver.solve(s, *coordFunctions, times, genForceTraj);
+		Array<string> errors("", numChunks);
+		InverseDynamicsFramesTask task(models, states, times, qTraj, uTraj, udotTraj,
+			jointIndices, genForceTraj, bodyForceTraj, errors);
+		if(numChunks > 1){
+			SimTK::ParallelExecutor executor(numChunks);
+			executor.execute(task, numChunks);
+		}
+		else{
+			task.execute(0);
+		}
 
+		for(int c=1; c<numChunks; c++) delete models[c];
+		for(int c=0; c<numChunks; c++){
+			if(errors[c] != "") throw Exception(errors[c]);
+		}
 
 		success = true;
 
 		cout << "InverseDynamicsTool: " << nt << " time frames in " <<(double)(clock()-start)/CLOCKS_PER_SEC << "s\n" <<endl;
-	
-		JointSet jointsForEquivalentBodyForces;
-		getJointsByName(*_model, _jointsForReportingBodyForces, jointsForEquivalentBodyForces);
-		int nj = jointsForEquivalentBodyForces.getSize();
 
 		Array<string> labels("time", nq+1);
 		for(int i=0; i<nq; i++){
@@ -364,37 +486,13 @@ bool InverseDynamicsTool::run()
 
 		Storage genForceResults(nt);
 		Storage bodyForcesResults(nt);
-		SpatialVec equivalentBodyForceAtJoint;
 
 		for(int i=0; i<nt; i++){
-			StateVector genForceVec(times[i], nq, &((genForceTraj[i])[0]));
-			genForceResults.append(genForceVec);
+			genForceResults.append(times[i], nq, &genForceTraj[i][0]);
 
-			// if there are joints requested for equivalent body forces then calculate them
+			// if there are joints requested for equivalent body forces then report them
 			if(nj>0){
-				Vector forces(6*nj, 0.0);
-				StateVector bodyForcesVec(times[i], 6*nj, &forces[0]);
-
-				s.updTime() = times[i];
-				Vector &q = s.updQ();
-				Vector &u = s.updU();
-
-				for(int j=0; j<nq; ++j){
-					q[j] = coordFunctions->evaluate(j, 0, times[i]);
-					u[j] = coordFunctions->evaluate(j, 1, times[i]);
-				}
-			
-				for(int j=0; j<nj; ++j){
-					equivalentBodyForceAtJoint = jointsForEquivalentBodyForces[j].calcEquivalentSpatialForce(s, genForceTraj[i]);
-					for(int k=0; k<3; ++k){
-						// body force components
-						bodyForcesVec.setDataValue(6*j+k, equivalentBodyForceAtJoint[1][k]); 
-						// body torque components
-						bodyForcesVec.setDataValue(6*j+k+3, equivalentBodyForceAtJoint[0][k]);
-					}
-				}
-				bodyForcesResults.append(bodyForcesVec);
-
+				bodyForcesResults.append(times[i], 6*nj, &bodyForceTraj[i][0]);
 			}
 		}
 
@@ -70,6 +70,9 @@ OpenSim_DECLARE_CONCRETE_OBJECT(InverseDynamicsTool, DynamicsTool);
 // MEMBER VARIABLES
 //=============================================================================
 	Storage* _coordinateValues;
+
+	/** Number of threads solving the time frames, 0 for all processors. */
+	int _numThreads;
 protected:
 	
 	/** name of storage file that contains coordinate values for inverse dynamics solving */
@@ -151,6 +154,17 @@ public:
 	void setLowpassCutoffFrequency(double aFrequency) {
 		_lowpassCutoffFrequency = aFrequency;
 	}
+    /**
+     * get/set the number of threads that solve the time frames concurrently,
+     * each on its own copy of the model. 0 (the default) uses up to all
+     * processors, as long as each thread has enough frames to make copying
+     * the model worthwhile. The frames are always solved serially if the
+     * model has analyses to step through them in order.
+     */
+	int getNumThreads() const { return _numThreads; }
+	void setNumThreads(int aNumThreads) {
+		_numThreads = (aNumThreads < 0) ? 0 : aNumThreads;
+	}
 	//--------------------------------------------------------------------------
 	// INTERFACE
 	//--------------------------------------------------------------------------
@@ -319,22 +319,21 @@ bool ModelScaler::processModel(SimTK::State& s, Model* aModel, const string& aPa
 		aModel->scale(s, theScaleSet, aSubjectMass, _preserveMassDist);
 
 
+		// Output files are named relative to the subject, as in MarkerPlacer,
+		// rather than by changing the process-wide working directory, so that
+		// several subjects can be scaled at once.
 		if(_printResultFiles) {
-			std::string savedCwd = IO::getCwd();
-			IO::chDir(aPathToSubject);
-
 			if (!_outputModelFileNameProp.getValueIsDefault())
 			{
-				if (aModel->print(_outputModelFileName))
+				if (aModel->print(aPathToSubject + _outputModelFileName))
 					cout << "Wrote model file " << _outputModelFileName << " from model " << aModel->getName() << endl;
 			}
 
 			if (!_outputScaleFileNameProp.getValueIsDefault())
 			{
-				if (theScaleSet.print(_outputScaleFileName))
+				if (theScaleSet.print(aPathToSubject + _outputScaleFileName))
 					cout << "Wrote scale file " << _outputScaleFileName << " for model " << aModel->getName() << endl;
 			}
-			IO::chDir(savedCwd);
 		}
 
 
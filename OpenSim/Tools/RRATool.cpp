@@ -553,10 +553,6 @@ bool RRATool::run()
 		cout<<"\nConstructing function set for tracking desired points...\n\n";
 		posSet = new GCVSplineSet(5,desiredPointsStore);
 
-		Storage *velStore=posSet->constructStorage(1);
-		GCVSplineSet velSet(5,velStore);
-		delete velStore; velStore=NULL;
-
 		// Print acc for debugging
 		if (_verbose) {
 			Storage *accStore=posSet->constructStorage(2);
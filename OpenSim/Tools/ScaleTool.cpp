@@ -27,6 +27,7 @@
 #include "ScaleTool.h"
 #include <OpenSim/Common/SimmIO.h>
 #include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/ArrayPtrs.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include "SimTKsimbody.h"
 
@@ -245,3 +246,157 @@ Model* ScaleTool::createModel()
 	}
 	return 0;
 }
+//_____________________________________________________________________________
+/**
+ * Create a model for this subject from a generic model that has already been
+ * read, using GenericModelMaker::processModel().
+ *
+ * @return Pointer to the Model that is created.
+ */
+Model* ScaleTool::createModel(const Model& aGenericModel)
+{
+	cout << "Processing subject " << getName() << endl;
+
+	Model *model = _genericModelMaker.processModel(aGenericModel, _pathToSubject);
+	if (!model)
+	{
+		cout << "===ERROR===: Unable to copy generic model." << endl;
+		return 0;
+	}
+	model->setName(getName());
+	return model;
+}
+//_____________________________________________________________________________
+/**
+ * Scale a model created for this subject and place its markers, using
+ * ModelScaler::processModel() and MarkerPlacer::processModel().
+ *
+ * @return Whether or not the model was processed successfully.
+ */
+bool ScaleTool::processModel(Model* aModel)
+{
+	SimTK::State& s = aModel->initSystem();
+
+	if (!isDefaultModelScaler() && _modelScaler.getApply())
+	{
+		if(!_modelScaler.processModel(s, aModel, _pathToSubject, _mass)) return false;
+	}
+	else
+	{
+		cout << "Scaling parameters disabled (apply is false) or not set. Model is not scaled." << endl;
+	}
+
+	SimTK::State& news = aModel->initSystem();	// old state is messed up by scaling. can't use it
+	if (!isDefaultMarkerPlacer())
+	{
+		if(!_markerPlacer.processModel(news, aModel, _pathToSubject)) return false;
+	}
+	else
+	{
+		cout << "Marker placement parameters disabled (apply is false) or not set. No markers have been moved." << endl;
+	}
+	return true;
+}
+
+//=============================================================================
+// BATCH PROCESSING
+//=============================================================================
+//_____________________________________________________________________________
+/*
+ * Task that creates, scales and places markers on the model of one subject
+ * per index. Each subject works on its own copy of a shared generic model.
+ */
+class ScaleSubjectTask : public SimTK::ParallelExecutor::Task {
+public:
+	ScaleSubjectTask(const Array<ScaleTool*>& subjects,
+		const ArrayPtrs<Model>& genericModels, const Array<int>& genericModelIndex,
+		Array<bool>& succeeded) :
+		_subjects(subjects), _genericModels(genericModels),
+		_genericModelIndex(genericModelIndex), _succeeded(succeeded) {}
+
+	void execute(int index) {
+		_succeeded[index] = false;
+		if (_genericModelIndex[index] < 0) return;
+		ScaleTool& subject = *_subjects[index];
+		Model* model = NULL;
+		try {
+			model = subject.createModel(*_genericModels[_genericModelIndex[index]]);
+			if (model) _succeeded[index] = subject.processModel(model);
+		}
+		catch (const Exception& x) {
+			x.print(cout);
+		}
+		catch (const std::exception& x) {
+			cout << "ScaleTool.runBatch: ERROR- " << x.what() << endl;
+		}
+		delete model;
+	}
+private:
+	const Array<ScaleTool*>& _subjects;
+	const ArrayPtrs<Model>& _genericModels;
+	const Array<int>& _genericModelIndex;
+	Array<bool>& _succeeded;
+};
+//_____________________________________________________________________________
+/**
+ * Scale several subjects. Each distinct generic model is read once, serially,
+ * and then copied for every subject that uses it; the subjects themselves are
+ * processed concurrently.
+ */
+int ScaleTool::runBatch(const Array<ScaleTool*>& aSubjects, int aNumThreads)
+{
+	int n = aSubjects.getSize();
+
+	// READ EACH DISTINCT GENERIC MODEL ONCE
+	Array<std::string> modelFiles;
+	ArrayPtrs<Model> genericModels;
+	genericModels.setMemoryOwner(true);
+	Array<int> genericModelIndex(-1, n);
+	for (int i = 0; i < n; i++) {
+		ScaleTool& subject = *aSubjects[i];
+		if (subject.isDefaultGenericModelMaker()) {
+			cout << "ScaleTool.runBatch: WARNING- Unscaled model not specified for subject "
+				 << subject.getName() << "." << endl;
+			continue;
+		}
+		std::string modelFile = subject.getPathToSubject() +
+			subject.getGenericModelMaker().getModelFileName();
+		int index = modelFiles.findIndex(modelFile);
+		if (index < 0) {
+			cout << "Loading generic model " << modelFile << endl;
+			try {
+				genericModels.append(new Model(modelFile));
+			}
+			catch (const Exception& x) {
+				x.print(cout);
+				continue;
+			}
+			modelFiles.append(modelFile);
+			index = modelFiles.getSize()-1;
+		}
+		genericModelIndex[i] = index;
+	}
+
+	// PROCESS THE SUBJECTS
+	Array<bool> succeeded(false, n);
+	ScaleSubjectTask task(aSubjects, genericModels, genericModelIndex, succeeded);
+	int numThreads = (aNumThreads > 0) ? aNumThreads :
+		SimTK::ParallelExecutor::getNumProcessors();
+	if (numThreads > 1 && n > 1) {
+		SimTK::ParallelExecutor executor(numThreads);
+		executor.execute(task, n);
+	}
+	else {
+		for (int i = 0; i < n; i++) task.execute(i);
+	}
+
+	int numFailed = 0;
+	for (int i = 0; i < n; i++) {
+		if (!succeeded[i]) {
+			cout << "ScaleTool.runBatch: ERROR- Subject " << aSubjects[i]->getName()
+				 << " was not scaled." << endl;
+			numFailed++;
+		}
+	}
+	return numFailed;
+}
@@ -102,6 +102,19 @@ public:
 	void copyData(const ScaleTool &aSubject);
 
 	Model* createModel();
+	Model* createModel(const Model& aGenericModel);
+	bool processModel(Model* aModel);
+
+	/**
+	 * Scale several subjects, reading each distinct generic model only once
+	 * and processing the subjects concurrently.
+	 *
+	 * @param aSubjects Setup of each subject.
+	 * @param aNumThreads Number of subjects processed at once (<=0 uses one
+	 * per processor).
+	 * @return Number of subjects that could not be scaled.
+	 */
+	static int runBatch(const Array<ScaleTool*>& aSubjects, int aNumThreads=0);
 	/* Query the subject for different parameters */
 	GenericModelMaker& getGenericModelMaker()
 	{